@@ -0,0 +1,49 @@
+#!/bin/bash
+#
+# bench_lib.sh
+#
+# Helper functions shared by every benchmark, sourced rather than run
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Iteration counts are multiplied by BENCH_SCALE, e.g. BENCH_SCALE=0.1 for a quick run
+BENCH_SCALE=${BENCH_SCALE:-1}
+
+# Scratch directory for generated scripts and data, removed by the caller
+BENCH_TMP=${BENCH_TMP:-$(mktemp -d)}
+
+# Scales an iteration count by BENCH_SCALE, never going below 1
+scaled() {
+    awk -v n="$1" -v s="$BENCH_SCALE" 'BEGIN { v = int(n * s); print (v < 1 ? 1 : v) }'
+}
+
+# Runs a script with the shell under test and stores the elapsed wall time in ELAPSED_US.
+# $EPOCHREALTIME is read without forking, so the timing only covers the shell itself
+time_script() {
+    local start=${EPOCHREALTIME/./}
+    "$SHELL_BIN" "$1" > /dev/null 2>&1
+    local end=${EPOCHREALTIME/./}
+    ELAPSED_US=$((end - start))
+}
+
+# Prints a single benchmark result as a JSON object. $3 is an awk expression for the value
+emit() {
+    local value
+    value=$(awk "BEGIN { printf \"%.3f\", $3 }")
+    printf '{"name": "%s", "unit": "%s", "value": %s}\n' "$1" "$2" "$value"
+}
@@ -0,0 +1,44 @@
+#!/bin/bash
+#
+# commands.sh
+#
+# Measures how many trivial commands per second the shell runs, both built-in and external
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHELL_BIN=$1
+source "$(dirname "$0")/bench_lib.sh"
+
+# Built-in commands, which SHrimp runs without forking
+COUNT=$(scaled 20000)
+SCRIPT="$BENCH_TMP/builtin.sh"
+for ((i = 0; i < COUNT; i++)); do
+    echo "true"
+done > "$SCRIPT"
+time_script "$SCRIPT"
+emit "builtin_commands" "commands/s" "$COUNT / ($ELAPSED_US / 1e6)"
+
+# External commands, which pay for a full spawn and wait each
+COUNT=$(scaled 1000)
+SCRIPT="$BENCH_TMP/external.sh"
+for ((i = 0; i < COUNT; i++)); do
+    echo "/bin/true"
+done > "$SCRIPT"
+time_script "$SCRIPT"
+emit "external_commands" "commands/s" "$COUNT / ($ELAPSED_US / 1e6)"
@@ -0,0 +1,49 @@
+#!/bin/bash
+#
+# parse.sh
+#
+# Measures the cost of parsing very long lines
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHELL_BIN=$1
+source "$(dirname "$0")/bench_lib.sh"
+
+# Lines of a single built-in with many arguments, so parsing dominates running the line
+WORDS=50000
+COUNT=$(scaled 20)
+LINE="true"
+for ((i = 0; i < WORDS; i++)); do
+    LINE="$LINE arg$((i % 10))"
+done
+
+SCRIPT="$BENCH_TMP/long_lines.sh"
+for ((i = 0; i < COUNT; i++)); do
+    echo "$LINE"
+done > "$SCRIPT"
+time_script "$SCRIPT"
+emit "long_line" "ms/line" "$ELAPSED_US / 1000 / $COUNT"
+emit "long_line_word" "ns/word" "$ELAPSED_US * 1000 / ($COUNT * $WORDS)"
+
+# The same lines run from the compiled script cache, once it holds the script
+export SHRIMP_SCRIPT_CACHE="$BENCH_TMP/script_cache"
+time_script "$SCRIPT"
+time_script "$SCRIPT"
+unset SHRIMP_SCRIPT_CACHE
+emit "long_line_cached" "ms/line" "$ELAPSED_US / 1000 / $COUNT"
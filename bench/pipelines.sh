@@ -0,0 +1,41 @@
+#!/bin/bash
+#
+# pipelines.sh
+#
+# Measures the latency of launching and waiting for a pipeline against its stage count
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHELL_BIN=$1
+source "$(dirname "$0")/bench_lib.sh"
+
+COUNT=$(scaled 100)
+for STAGES in 1 2 4 8 16 32; do
+    PIPELINE="/bin/true"
+    for ((i = 1; i < STAGES; i++)); do
+        PIPELINE="$PIPELINE | /bin/true"
+    done
+
+    SCRIPT="$BENCH_TMP/pipeline_$STAGES.sh"
+    for ((i = 0; i < COUNT; i++)); do
+        echo "$PIPELINE"
+    done > "$SCRIPT"
+    time_script "$SCRIPT"
+    emit "pipeline_latency_${STAGES}_stages" "us" "$ELAPSED_US / $COUNT"
+done
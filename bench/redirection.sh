@@ -0,0 +1,53 @@
+#!/bin/bash
+#
+# redirection.sh
+#
+# Measures the cost of opening redirections and the throughput of a redirected copy
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHELL_BIN=$1
+source "$(dirname "$0")/bench_lib.sh"
+
+# Redirecting a built-in, which only costs the shell the open() and dup2() calls
+COUNT=$(scaled 20000)
+SCRIPT="$BENCH_TMP/redirect_open.sh"
+for ((i = 0; i < COUNT; i++)); do
+    echo "echo shrimp > $BENCH_TMP/redirect_out.txt"
+done > "$SCRIPT"
+time_script "$SCRIPT"
+emit "redirections" "redirections/s" "$COUNT / ($ELAPSED_US / 1e6)"
+
+# Feeding a here-doc to a built-in, which SHrimp writes into a pipe instead of a temp file
+COUNT=$(scaled 20000)
+SCRIPT="$BENCH_TMP/redirect_heredoc.sh"
+for ((i = 0; i < COUNT; i++)); do
+    printf 'cat > %s <<EOF\nshrimp\nEOF\n' "$BENCH_TMP/redirect_out.txt"
+done > "$SCRIPT"
+time_script "$SCRIPT"
+emit "heredocs" "heredocs/s" "$COUNT / ($ELAPSED_US / 1e6)"
+
+# Copying a file through an external command with both stdin and stdout redirected
+MB=$(scaled 64)
+head -c "$((MB * 1024 * 1024))" /dev/zero > "$BENCH_TMP/redirect_in.bin"
+SCRIPT="$BENCH_TMP/redirect_copy.sh"
+echo "cat < $BENCH_TMP/redirect_in.bin > $BENCH_TMP/redirect_copy.bin" > "$SCRIPT"
+time_script "$SCRIPT"
+emit "redirected_copy" "MB/s" "$MB / ($ELAPSED_US / 1e6)"
+rm -f "$BENCH_TMP/redirect_in.bin" "$BENCH_TMP/redirect_copy.bin"
@@ -0,0 +1,71 @@
+#!/bin/bash
+#
+# run_all_benches.sh
+#
+# Runs every benchmark against SHrimp and optionally other shells, printing the results as JSON
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument, every further argument is a shell to compare
+# against, e.g. ./bench/run_all_benches.sh build/shrimp dash bash
+SHRIMP_BIN=$1
+shift
+
+# Ensure the first argument exists
+if [ -z "$SHRIMP_BIN" ] || [ ! -x "$SHRIMP_BIN" ]; then
+    echo "Usage: $0 build/shrimp [shell...]" >&2
+    exit 1
+fi
+
+BENCH_DIR=$(cd "$(dirname "$0")" && pwd)
+export BENCH_TMP=$(mktemp -d)
+trap 'rm -rf "$BENCH_TMP"' EXIT
+
+# Runs every benchmark script against a single shell, printing a JSON object for the shell
+bench_shell() {
+    local name=$1 path=$2 first=1
+    printf '    {\n      "shell": "%s",\n      "path": "%s",\n      "benchmarks": [\n' "$name" "$path"
+    for bench in "$BENCH_DIR"/*.sh; do
+        # Skip the helpers and this script to prevent recursion
+        case "$(basename "$bench")" in
+            bench_lib.sh|run_all_benches.sh) continue ;;
+        esac
+        while read -r result; do
+            [ $first -eq 1 ] || printf ',\n'
+            printf '        %s' "$result"
+            first=0
+        done < <(bash "$bench" "$path")
+    done
+    printf '\n      ]\n    }'
+}
+
+printf '{\n  "date": "%s",\n  "host": "%s",\n  "scale": %s,\n  "results": [\n' "$(date -u +%Y-%m-%dT%H:%M:%SZ)" "$(uname -srm)" "${BENCH_SCALE:-1}"
+bench_shell "shrimp" "$SHRIMP_BIN"
+
+# Compare against the other shells on the exact same workloads, skipping missing ones
+for shell in "$@"; do
+    path=$(command -v "$shell")
+    if [ -z "$path" ]; then
+        echo "run_all_benches.sh: $shell not found, skipping it" >&2
+        continue
+    fi
+    printf ',\n'
+    bench_shell "$shell" "$path"
+done
+
+printf '\n  ]\n}\n'
@@ -0,0 +1,69 @@
+#!/bin/bash
+#
+# startup.sh
+#
+# Measures the cold start of the shell running a single -c command, and fails if it goes
+# over the budget set by STARTUP_BUDGET_US
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHELL_BIN=$1
+source "$(dirname "$0")/bench_lib.sh"
+
+# Starts a program COUNT times and stores the mean wall time of a start in START_US
+time_starts() {
+    local start=${EPOCHREALTIME/./}
+    for ((i = 0; i < COUNT; i++)); do
+        "$@" > /dev/null 2>&1
+    done
+    local end=${EPOCHREALTIME/./}
+    START_US=$(((end - start) / COUNT))
+}
+
+# The cold start as cron and CI see it, from fork to exit, along with the overhead over
+# starting a program that does nothing, which leaves out the cost of fork and exec alone
+# Both are timed in alternating rounds and the fastest round of each is kept, which
+# leaves out most of the noise of a busy machine
+COUNT=$(scaled 200)
+BASELINE_US=
+SHELL_US=
+for round in 1 2 3; do
+    time_starts /bin/true
+    [ -z "$BASELINE_US" ] || [ "$START_US" -lt "$BASELINE_US" ] && BASELINE_US=$START_US
+    time_starts "$SHELL_BIN" -c true
+    [ -z "$SHELL_US" ] || [ "$START_US" -lt "$SHELL_US" ] && SHELL_US=$START_US
+done
+START_US=$SHELL_US
+emit "cold_start" "us/start" "$START_US"
+emit "cold_start_overhead" "us/start" "$START_US - $BASELINE_US"
+
+# The initialization of SHrimp itself, as timed by --startup-profile. Other shells have no
+# such flag and are skipped
+if INIT=$("$SHELL_BIN" --startup-profile -c true 2>&1 > /dev/null) && [[ "$INIT" == *total* ]]; then
+    TOTAL_US=$(echo "$INIT" | awk '$1 == "total" { sub(/us$/, "", $2); print $2 }')
+    emit "startup_init" "us" "$TOTAL_US"
+fi
+
+# Fail once the overhead of a cold start goes over budget, e.g. STARTUP_BUDGET_US=1000
+if [ -n "$STARTUP_BUDGET_US" ] && [ $((START_US - BASELINE_US)) -gt "$STARTUP_BUDGET_US" ]; then
+    echo "startup.sh: cold start overhead of $((START_US - BASELINE_US))us is over the budget of ${STARTUP_BUDGET_US}us" >&2
+    exit 1
+fi
+
+exit 0
@@ -19,15 +19,81 @@
  *
  * Author: Ryan McHenry
  * Created: January 23, 2026
- * Last Modified: February 1, 2026
+ * Last Modified: October 14, 2026
  */
 
 #ifndef MACROS_H
 #define MACROS_H
 
-#define MAX_ARGS 64
-#define MAX_COMMANDS 32
+#define INITIAL_ARGS 8
+#define INITIAL_COMMANDS 4
+#define INITIAL_HEREDOC 256
+#define INITIAL_JOBS 8
+#define INITIAL_PID_SLOTS 64
+#define EVENT_INPUT 0x01
+#define EVENT_CHILD 0x02
+#define EVENT_TIMER 0x04
+#define JOB_RECORD_MAX 4096
+#define TRACE_BUCKETS 32
+#define TRACE_BAR_WIDTH 40
+#define STARTUP_PHASES_MAX 16
+#define ARG_MAX_FLOOR 131072
+#define SAVED_FD_MIN 10
+#define BUILTIN_SPECIAL 1
 #define MAX_DELAYED_COMMANDS 32
+#define HASH_BUCKETS 64
+#define ARENA_BLOCK_SIZE 4096
+#define ARENA_ALIGN 8
+#define COPY_CHUNK_SIZE (16 * 1024 * 1024)
+#define COPY_BUFFER_SIZE (128 * 1024)
+#define COPY_BUFFER_ALIGN 4096
+#define SPAWN_REQUEST_MAX 65536
+#define SERVER_IN_FD 0x001
+#define SERVER_OUT_FD 0x002
+#define SERVER_CWD_FD 0x004
+#define SERVER_SETPGID 0x008
+#define SERVER_FOREGROUND 0x010
+#define SERVER_JOB_CONTROL 0x020
+#define SERVER_INPUT_REDIRECT 0x040
+#define SERVER_OUTPUT_REDIRECT 0x080
+#define SERVER_APPEND_REDIRECT 0x100
+#define HISTORY_FILE ".shrimp_history"
+#define HISTORY_BLOCK_ENTRIES 32
+#define HISTORY_BLOOM_BYTES 256
+#define TRIE_INITIAL_NODES 1024
+#define COMPLETE_MAX_DIRS 62
+#define COMPLETE_BUILTIN_SOURCE (1ULL << 63)
+#define COMPLETE_LIST_MAX 200
+#define SCRIPT_CACHE_MAGIC "SHRIMPC"
+#define SCRIPT_CACHE_VERSION 7
+#define SCRIPT_CACHE_STATS "stats"
+#define CACHE_NONE 0xffffffffu
+#define CACHE_BACKGROUND 0x01
+#define CACHE_PIPE 0x02
+#define CACHE_REDIRECT 0x04
+#define CACHE_BUILTIN 0x08
+#define CACHE_TIMED 0x10
+#define CACHE_PARALLEL 0x20
+#define CACHE_PRIO 0x40
+#define CACHE_PIN 0x80
+#define CACHE_STATUS 0x100
+#define CACHE_BENCH 0x200
+#define CACHE_BENCH_JSON 0x400
+#define CACHE_INPUT_REDIRECT 0x01
+#define CACHE_OUTPUT_REDIRECT 0x02
+#define CACHE_APPEND_REDIRECT 0x04
+#define CACHE_STATUS_ARGS 0x08
+#define PMAP_MAX_JOBS 4096
+#define PIPE_MAX_SIZE_FILE "/proc/sys/fs/pipe-max-size"
+#define PIPESTAT_FULL_PERCENT 90
+#define PIPESTAT_DEFAULT_MS 1000
+#define PRIO_DEFAULT_NICE 10
+#define CGROUP_MOUNTS_FILE "/proc/self/mounts"
+#define CGROUP_CPU_PERIOD 100000
+#define PIN_NODE_AUTO -1
+#define NUMA_NODE_DIR "/sys/devices/system/node"
+#define BENCH_DEFAULT_RUNS 10
+#define BENCH_MAX_RUNS 100000
 #define RESET_COLOR  "\033[0m"
 #define RED_TEXT     "\033[31m"   
 #define BLUE_TEXT    "\033[34m"
@@ -0,0 +1,275 @@
+/* accounting.c
+ *
+ * Contains the resource accounting of SHrimp, which reports the time prefix and writes the
+ * job log from the rusage collected for every reaped process.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/resource.h>  // struct rusage
+#include <sys/time.h>      // timeradd()
+#include <time.h>          // struct timespec, clock_gettime()
+#include <stdio.h>         // printf(), fprintf(), snprintf(), putchar(), stderr
+#include <stdlib.h>        // qsort()
+#include <unistd.h>        // write()
+#include <string.h>        // memset()
+#include "config/macros.h" // JOB_RECORD_MAX, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // Job, BenchSample
+#include "exec/accounting.h"
+
+//======================================================================================
+
+/**
+ * @brief Computes the seconds elapsed between two points in time.
+ *
+ * @param from the earlier point in time.
+ * @param to the later point in time.
+ *
+ * @return The seconds between from and to.
+ */
+double timespec_elapsed(const struct timespec *from, const struct timespec *to) {
+    return (double)(to->tv_sec - from->tv_sec) + (double)(to->tv_nsec - from->tv_nsec) / 1e9;
+}
+
+//======================================================================================
+
+/**
+ * @brief Converts a timeval of an rusage into seconds.
+ *
+ * @param tv the timeval to convert.
+ *
+ * @return tv in seconds.
+ */
+static double timeval_seconds(const struct timeval *tv) {
+    return (double)tv->tv_sec + (double)tv->tv_usec / 1e6;
+}
+
+//======================================================================================
+
+/**
+ * @brief Combines the resource use of every process of a job.
+ *
+ * @param job the Job to sum up.
+ * @param total where the combined rusage is stored. CPU times and context switches are
+ * summed, while ru_maxrss is the largest of any process.
+ *
+ * @return The wall time of the job, from its launch until its last process was reaped.
+ */
+double job_total(const Job *job, struct rusage *total) {
+    struct timespec last = job->started;
+
+    memset(total, 0, sizeof(*total));
+    for(int i = 0; i < job->proc_amt; i++) {
+        const struct rusage *usage = &job->usage[i];
+        timeradd(&total->ru_utime, &usage->ru_utime, &total->ru_utime);
+        timeradd(&total->ru_stime, &usage->ru_stime, &total->ru_stime);
+        if(usage->ru_maxrss > total->ru_maxrss)
+            total->ru_maxrss = usage->ru_maxrss;
+        total->ru_nvcsw += usage->ru_nvcsw;
+        total->ru_nivcsw += usage->ru_nivcsw;
+        if(timespec_elapsed(&last, &job->ended[i]) > 0)
+            last = job->ended[i];
+    }
+
+    return timespec_elapsed(&job->started, &last);
+}
+
+//======================================================================================
+
+/**
+ * @brief Prints the header of the table printed by the time prefix.
+ */
+void usage_print_header(void) {
+    fprintf(stderr, "%10s %10s %10s %10s %6s %6s  %s\n", "real", "user", "sys", "maxrss", "vcsw", "ivcsw", "command");
+}
+
+//======================================================================================
+
+/**
+ * @brief Prints a single row of the table printed by the time prefix.
+ *
+ * @param real the wall time in seconds.
+ * @param usage the CPU time, max RSS and context switches to print.
+ * @param label what the row describes, e.g. the text of a pipeline stage.
+ */
+void usage_print_row(double real, const struct rusage *usage, const char *label) {
+    fprintf(stderr, "%9.3fs %9.3fs %9.3fs %8ldkB %6ld %6ld  %s\n", real,
+            timeval_seconds(&usage->ru_utime), timeval_seconds(&usage->ru_stime),
+            usage->ru_maxrss, usage->ru_nvcsw, usage->ru_nivcsw, label);
+}
+
+//======================================================================================
+
+/**
+ * @brief Reports the resource use of a finished job to stderr, as requested by the time
+ * prefix.
+ *
+ * @param job the finished Job to report.
+ *
+ * @details A pipeline gets one row per stage followed by a total row, so slow or expensive
+ * stages stand out. The wall time of a stage runs from the launch of the job until the
+ * stage was reaped. A stage that could not be launched reports no resource use.
+ */
+void job_report_usage(const Job *job) {
+    usage_print_header();
+
+    for(int i = 0; i < job->proc_amt; i++)
+        usage_print_row(timespec_elapsed(&job->started, &job->ended[i]), &job->usage[i], job->stages[i]);
+
+    if(job->proc_amt > 1) {
+        struct rusage total;
+        double real = job_total(job, &total);
+        usage_print_row(real, &total, "total");
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Writes a one line record of a finished job to the job log.
+ *
+ * @param job the finished Job to record.
+ * @param fd the fd of the job log.
+ *
+ * @details Each record is a list of name=value fields ending with the text of the job, so
+ * the log can be filtered with the usual line based tools. statuses lists the exit status
+ * of every stage in order. The record is written with a single write() so records of
+ * concurrent shells sharing a log do not interleave. Overly long command text is cut short.
+ */
+void job_log_record(const Job *job, int fd) {
+    struct rusage total;
+    double real = job_total(job, &total);
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    char statuses[256];
+    size_t len = 0;
+    for(int i = 0; i < job->proc_amt && len < sizeof(statuses) - 12; i++)
+        len += snprintf(statuses + len, sizeof(statuses) - len, i > 0 ? ",%d" : "%d", job->statuses[i]);
+    statuses[len] = '\0';
+
+    char record[JOB_RECORD_MAX];
+    int record_len = snprintf(record, sizeof(record), "end=%lld.%03ld job=%d pgid=%d status=%d statuses=%s real=%.6f user=%.6f sys=%.6f maxrss=%ld vcsw=%ld ivcsw=%ld cmd=%s\n",
+            (long long)now.tv_sec, now.tv_nsec / 1000000, job->id, job->pgid,
+            job->statuses[job->proc_amt - 1], statuses, real,
+            timeval_seconds(&total.ru_utime), timeval_seconds(&total.ru_stime),
+            total.ru_maxrss, total.ru_nvcsw, total.ru_nivcsw, job->cmdline);
+    if(record_len < 0)
+        return;
+    if((size_t)record_len >= sizeof(record)) {
+        record_len = sizeof(record) - 1;
+        record[record_len - 1] = '\n';
+    }
+
+    // A full or closed log must never stop the job from being collected
+    if(write(fd, record, record_len) < 0)
+        return;
+}
+
+//======================================================================================
+
+/**
+ * @brief Orders two BenchSample objects by their wall time, for qsort().
+ */
+static int sample_compare(const void *a, const void *b) {
+    double x = ((const BenchSample *)a)->real, y = ((const BenchSample *)b)->real;
+    return (x > y) - (x < y);
+}
+
+//======================================================================================
+
+/**
+ * @brief Prints a string as a JSON string literal.
+ *
+ * @param text the string to print. It is printed within quotes, with quotes, backslashes and
+ * control characters escaped.
+ */
+static void json_print_string(const char *text) {
+    putchar('"');
+    for(const unsigned char *c = (const unsigned char *)text; *c != '\0'; c++) {
+        if(*c == '"' || *c == '\\')
+            printf("\\%c", *c);
+        else if(*c < 0x20)
+            printf("\\u%04x", *c);
+        else
+            putchar(*c);
+    }
+    putchar('"');
+}
+
+//======================================================================================
+
+/**
+ * @brief Reports the runs of a pipeline benchmarked with the bench prefix.
+ *
+ * @param samples every measured run, which are sorted by their wall time.
+ * @param sample_amt the amount of measured runs.
+ * @param warmup the amount of runs before them that were not measured.
+ * @param label the text of the pipeline.
+ * @param json flag for a single line JSON object instead of a table.
+ *
+ * @details The minimum, median and 99th percentile of the wall time are reported, the
+ * percentile being the nearest rank, so with fewer than 100 runs it is the slowest run.
+ * CPU times and context switches are the mean of a run and max RSS the largest of any run.
+ * The report goes to stdout, unlike that of the time prefix, since it is the output of the
+ * benchmark, e.g. to be collected with bench -j >> results.json.
+ */
+void bench_report(BenchSample *samples, int sample_amt, int warmup, const char *label, int json) {
+    if(sample_amt == 0) {
+        fprintf(stderr, RED_TEXT "bench: no run was measured" RESET_COLOR "\n");
+        return;
+    }
+    qsort(samples, sample_amt, sizeof(BenchSample), sample_compare);
+
+    double real = 0, user = 0, sys = 0, vcsw = 0, ivcsw = 0;
+    long maxrss = 0;
+    int failed = 0;
+    for(int i = 0; i < sample_amt; i++) {
+        real += samples[i].real;
+        user += timeval_seconds(&samples[i].usage.ru_utime);
+        sys += timeval_seconds(&samples[i].usage.ru_stime);
+        vcsw += samples[i].usage.ru_nvcsw;
+        ivcsw += samples[i].usage.ru_nivcsw;
+        if(samples[i].usage.ru_maxrss > maxrss)
+            maxrss = samples[i].usage.ru_maxrss;
+        failed += samples[i].status != 0;
+    }
+
+    double min = samples[0].real;
+    double median = sample_amt % 2 ? samples[sample_amt / 2].real :
+                    (samples[sample_amt / 2 - 1].real + samples[sample_amt / 2].real) / 2;
+    double p99 = samples[(sample_amt * 99 + 99) / 100 - 1].real;
+
+    if(json) {
+        printf("{\"command\":");
+        json_print_string(label);
+        printf(",\"runs\":%d,\"warmup\":%d,\"failed\":%d,\"real\":{\"min\":%.6f,\"median\":%.6f,\"p99\":%.6f,\"mean\":%.6f},"
+               "\"user\":%.6f,\"sys\":%.6f,\"maxrss_kb\":%ld,\"vcsw\":%.1f,\"ivcsw\":%.1f}\n",
+               sample_amt, warmup, failed, min, median, p99, real / sample_amt, user / sample_amt,
+               sys / sample_amt, maxrss, vcsw / sample_amt, ivcsw / sample_amt);
+    } else {
+        printf("%6s %6s %10s %10s %10s %10s %10s %10s %7s %7s  %s\n", "runs", "failed", "min", "median", "p99",
+               "user", "sys", "maxrss", "vcsw", "ivcsw", "command");
+        printf("%6d %6d %8.3fms %8.3fms %8.3fms %8.3fms %8.3fms %8ldkB %7.1f %7.1f  %s\n", sample_amt, failed,
+               min * 1e3, median * 1e3, p99 * 1e3, user / sample_amt * 1e3, sys / sample_amt * 1e3, maxrss,
+               vcsw / sample_amt, ivcsw / sample_amt, label);
+    }
+}
+
+//======================================================================================
@@ -0,0 +1,36 @@
+/* accounting.h
+ *
+ * Header file for accounting.c
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef ACCOUNTING_H
+#define ACCOUNTING_H
+
+#include "types/types.h"
+
+double timespec_elapsed(const struct timespec *from, const struct timespec *to);
+double job_total(const Job *job, struct rusage *total);
+void usage_print_header(void);
+void usage_print_row(double real, const struct rusage *usage, const char *label);
+void job_report_usage(const Job *job);
+void job_log_record(const Job *job, int fd);
+void bench_report(BenchSample *samples, int sample_amt, int warmup, const char *label, int json);
+
+#endif
@@ -0,0 +1,731 @@
+/* builtins.c
+ *
+ * Contains the dispatch table and logic of every built-in command of SHrimp.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <unistd.h>        // chdir(), getcwd(), dup2(), close(), STDIN_FILENO, STDOUT_FILENO
+#include <fcntl.h>         // fcntl(), open(), F_DUPFD_CLOEXEC, O_RDONLY, O_CLOEXEC
+#include <signal.h>        // sigaction(), sigemptyset(), sig_atomic_t, SIGINT, SIGQUIT
+#include <stdio.h>         // printf(), fputs(), putchar(), fflush(), fprintf()
+#include <stdlib.h>        // getenv(), exit(), strtol(), strtoll(), strtoull(), strtod(), free()
+#include <string.h>        // strcmp(), strchr(), strerror()
+#include <ctype.h>         // isdigit()
+#include <errno.h>         // errno
+#include "config/macros.h" // RED_TEXT, RESET_COLOR, SAVED_FD_MIN
+#include "types/types.h"   // Builtin, SHrimpCommand, SHrimpState
+#include "exec/hash.h"     // hash_builtin()
+#include "exec/options.h"  // set_builtin()
+#include "exec/jobs.h"     // jobs_builtin(), wait_builtin(), fg_builtin(), bg_builtin()
+#include "exec/pmap.h"     // pmap_builtin()
+#include "exec/pipestat.h" // pstat_builtin()
+#include "parse/history.h" // history_builtin()
+#include "parse/cache.h"   // scriptcache_builtin()
+#include "exec/redirect.h" // redirect(), redirect_here()
+#include "utils/copy.h"    // fd_copy()
+#include "utils/trace.h"   // trace_dump(), trace_reset()
+#include "exec/builtins.h"
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in Linux command cd using chdir().
+ *
+ * @param args 2D char array containing the command and all its arguments.
+ * @param state SHrimpState object whose spawn server and prompt must follow the new
+ * directory.
+ *
+ * @return 0 to denote a successful directory change, 1 to denote an insuccessful
+ * directory change.
+ */
+static int cd_builtin(char **args, SHrimpState *state) {
+    // The spawn server follows the shell into its new directory with its next request
+    state->server.cwd_stale = 1;
+
+    if(args[1] != NULL && args[2] != NULL) {
+        printf(RED_TEXT "cd: too many arguments" RESET_COLOR "\n");
+        return 1;        
+    } 
+
+    // cd to home dir
+    if(args[1] == NULL || strcmp(args[1], "~") == 0) {
+        char *home = getenv("HOME");
+        if(home != NULL) {
+            if(chdir(home) == -1) {
+                printf(RED_TEXT "SHrimp: cd home: No home directory found" RESET_COLOR "\n");
+                return 1;
+            }
+        } else {
+            printf(RED_TEXT "SHrimp: cd: error finding home directory" RESET_COLOR "\n");
+            return 1;
+        }
+        state->prompt.stale = 1;
+        return 0;
+    }
+
+    // cd to dir passed as args[1]
+    if(chdir(args[1]) == -1) {
+        printf(RED_TEXT "SHrimp: cd: %s: No such file or directory" RESET_COLOR "\n", args[1]);
+        return 1;
+    }
+    state->prompt.stale = 1;
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command exit.
+ *
+ * @param args 2D char array containing the command and all its arguments.
+ * @param state SHrimpState object holding the exit status of the last command.
+ *
+ * @return 1 if exit was given too many arguments. Otherwise the shell terminates.
+ *
+ * @details With no arguments, the shell exits with the status of the last command, so a
+ * script ending in exit reports the status of the command before it.
+ */
+static int exit_builtin(char **args, SHrimpState *state) {
+    if(args[1] == NULL) {
+        fflush(stdout);
+        exit(state->last_status);
+    }
+
+    if(args[2] != NULL) {
+        fprintf(stderr, RED_TEXT "exit: too many arguments" RESET_COLOR "\n");
+        return 1;
+    }
+
+    char *end;
+    long status = strtol(args[1], &end, 10);
+    if(*end != '\0' || end == args[1]) {
+        fprintf(stderr, RED_TEXT "exit: %s: numeric argument required" RESET_COLOR "\n", args[1]);
+        status = 2;
+    }
+
+    fflush(stdout);
+    exit((int)(status & 0xff));
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command hash. See hash_builtin().
+ *
+ * @param args 2D char array containing the command and all its arguments.
+ * @param state SHrimpState object holding the command hash table.
+ */
+static int hash_wrapper(char **args, SHrimpState *state) {
+    return hash_builtin(args, &state->hash);
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command shrimpstat, which reports the latency histograms of
+ * the tracing layer.
+ *
+ * @param args 2D char array containing the command and all its arguments. With no arguments
+ * the histograms are printed, -e and -d enable and disable recording, and -r clears them.
+ * @param state SHrimpState object holding the histograms.
+ *
+ * @return 0 on success, 1 if the option is invalid or tracing is not compiled in.
+ */
+static int shrimpstat_builtin(char **args, SHrimpState *state) {
+#ifdef SHRIMP_TRACE
+    if(args[1] == NULL) {
+        if(state->trace.enabled == 0)
+            printf("shrimpstat: tracing is disabled, enable it with shrimpstat -e or SHRIMP_TRACE=1\n");
+        trace_dump(&state->trace, stdout);
+        return 0;
+    }
+
+    for(int i = 1; args[i] != NULL; i++) {
+        if(strcmp(args[i], "-e") == 0) {
+            state->trace.enabled = 1;
+        } else if(strcmp(args[i], "-d") == 0) {
+            state->trace.enabled = 0;
+        } else if(strcmp(args[i], "-r") == 0) {
+            trace_reset(&state->trace);
+        } else {
+            fprintf(stderr, RED_TEXT "shrimpstat: %s: invalid option" RESET_COLOR "\n", args[i]);
+            return 1;
+        }
+    }
+
+    return 0;
+#else
+    (void)args;
+    (void)state;
+    fprintf(stderr, RED_TEXT "shrimpstat: tracing is not compiled in, rebuild with make TRACE=1" RESET_COLOR "\n");
+    return 1;
+#endif
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command true.
+ *
+ * @return 0.
+ */
+static int true_builtin(char **args, SHrimpState *state) {
+    (void)args;
+    (void)state;
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command false.
+ *
+ * @return 1.
+ */
+static int false_builtin(char **args, SHrimpState *state) {
+    (void)args;
+    (void)state;
+
+    return 1;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command pwd.
+ *
+ * @param args unused.
+ * @param state unused.
+ *
+ * @return 0 on success, 1 if the current directory could not be determined.
+ */
+static int pwd_builtin(char **args, SHrimpState *state) {
+    (void)args;
+    (void)state;
+
+    char *cwd = getcwd(NULL, 0);
+    if(cwd == NULL) {
+        fprintf(stderr, RED_TEXT "pwd: %s" RESET_COLOR "\n", strerror(errno));
+        return 1;
+    }
+    puts(cwd);
+    free(cwd);
+
+    return 0;
+}
+
+//======================================================================================
+
+// Set to the signal that interrupted the cat built-in while it runs in the shell process
+static volatile sig_atomic_t cat_interrupted;
+
+/**
+ * @brief Signal handler that interrupts the cat built-in.
+ *
+ * @param sig the signal received.
+ */
+static void cat_interrupt(int sig) {
+    cat_interrupted = sig;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command cat.
+ *
+ * @param args 2D char array containing the command and all its arguments. Every arg is a
+ * file to concatenate, - or no args at all meaning stdin. -u is accepted and ignored, since
+ * the output is never buffered. Any other option runs the external cat instead, see
+ * find_command_builtin().
+ * @param state SHrimpState object telling whether job control is enabled.
+ *
+ * @return 0 on success, 1 if any file could not be read or written, or 128 plus the signal
+ * number if interrupted.
+ *
+ * @details Each file is moved with fd_copy(), so "cat a b >> all" or "cat < big > copy"
+ * never copies the data through user space when the kernel can move it. The shell itself
+ * ignores Ctrl-C and Ctrl-\ under job control, so a handler without SA_RESTART is installed
+ * while the copy runs in the shell process, letting the user interrupt a long copy.
+ */
+static int cat_builtin(char **args, SHrimpState *state) {
+    struct sigaction interrupt = { .sa_handler = cat_interrupt };
+    struct sigaction saved_int, saved_quit;
+    int status = 0;
+    int i = 1;
+
+    if(args[i] != NULL && strcmp(args[i], "-u") == 0)
+        i++;
+    if(args[i] != NULL && strcmp(args[i], "--") == 0)
+        i++;
+
+    fflush(stdout);
+    cat_interrupted = 0;
+    if(state->jobs.job_control) {
+        sigemptyset(&interrupt.sa_mask);
+        sigaction(SIGINT, &interrupt, &saved_int);
+        sigaction(SIGQUIT, &interrupt, &saved_quit);
+    }
+
+    char *stdin_only[] = { "-", NULL };
+    char **files = args[i] != NULL ? &args[i] : stdin_only;
+    for(int f = 0; files[f] != NULL && cat_interrupted == 0; f++) {
+        int fd = STDIN_FILENO;
+        if(strcmp(files[f], "-") != 0 && (fd = open(files[f], O_RDONLY | O_CLOEXEC)) < 0) {
+            fprintf(stderr, RED_TEXT "cat: %s: %s" RESET_COLOR "\n", files[f], strerror(errno));
+            status = 1;
+            continue;
+        }
+
+        if(fd_copy(fd, STDOUT_FILENO, &cat_interrupted) < 0 && cat_interrupted == 0) {
+            fprintf(stderr, RED_TEXT "cat: %s: %s" RESET_COLOR "\n", files[f], strerror(errno));
+            status = 1;
+        }
+        if(fd != STDIN_FILENO)
+            close(fd);
+    }
+
+    if(state->jobs.job_control) {
+        sigaction(SIGINT, &saved_int, NULL);
+        sigaction(SIGQUIT, &saved_quit, NULL);
+    }
+
+    return cat_interrupted ? 128 + cat_interrupted : status;
+}
+
+//======================================================================================
+
+/**
+ * @brief Checks whether the cat built-in understands every argument of a cat command.
+ *
+ * @param args 2D char array containing the command and all its arguments.
+ *
+ * @return 1 if every arg is a file or - after an optional -u and an optional --, 0 if any
+ * other option is given, e.g. -n, in which case the external cat must run instead.
+ *
+ * @details Options may follow files, as in "cat file -n", so every arg before a -- is
+ * checked, not just the leading ones.
+ */
+static int cat_accepts(char **args) {
+    int i = 1;
+
+    if(args[i] != NULL && strcmp(args[i], "-u") == 0)
+        i++;
+    if(args[i] != NULL && strcmp(args[i], "--") == 0)
+        return 1;
+
+    for(; args[i] != NULL; i++) {
+        if(args[i][0] == '-' && args[i][1] != '\0')
+            return 0;
+    }
+
+    return 1;
+}
+
+//======================================================================================
+
+/**
+ * @brief Prints the backslash escape sequence starting at p.
+ *
+ * @param p pointer to the backslash beginning the escape sequence.
+ *
+ * @return A pointer to the last character of the escape sequence.
+ *
+ * @details Supports \\, \a, \b, \e, \f, \n, \r, \t, \v and octal escapes of up to three
+ * digits, e.g. \0 or \101. Unknown escapes are printed as-is, backslash included.
+ */
+static const char *print_escape(const char *p) {
+    static const char escapes[] = "\\\\a\ab\be\033f\fn\nr\rt\tv\v";
+
+    const char *match = p[1] != '\0' ? strchr(escapes, p[1]) : NULL;
+    // Only every other character of escapes is a valid escape letter
+    if(match != NULL && (match - escapes) % 2 == 0) {
+        putchar(match[1]);
+        return p + 1;
+    }
+
+    if(p[1] >= '0' && p[1] <= '7') {
+        int value = 0;
+        int digits = 0;
+        p++;
+        while(digits < 3 && *p >= '0' && *p <= '7') {
+            value = value * 8 + (*p - '0');
+            p++;
+            digits++;
+        }
+        putchar(value);
+        return p - 1;
+    }
+
+    putchar('\\');
+    return p;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command echo.
+ *
+ * @param args 2D char array containing the command and all its arguments.
+ * @param state unused.
+ *
+ * @return 0.
+ *
+ * @details Supports -n to omit the trailing newline, and -e and -E to enable and disable
+ * backslash escapes, in any combination, e.g. -ne. The output is buffered and written once
+ * the command completes.
+ */
+static int echo_builtin(char **args, SHrimpState *state) {
+    (void)state;
+
+    int newline = 1;
+    int escapes = 0;
+    int i = 1;
+
+    // Parse options, stopping at the first argument that is not one
+    for(; args[i] != NULL && args[i][0] == '-' && args[i][1] != '\0'; i++) {
+        if(strspn(args[i] + 1, "neE") != strlen(args[i] + 1))
+            break;
+        for(const char *c = args[i] + 1; *c != '\0'; c++) {
+            if(*c == 'n')
+                newline = 0;
+            else
+                escapes = *c == 'e';
+        }
+    }
+
+    for(int first = i; args[i] != NULL; i++) {
+        if(i > first)
+            putchar(' ');
+        if(!escapes) {
+            fputs(args[i], stdout);
+            continue;
+        }
+        for(const char *c = args[i]; *c != '\0'; c++) {
+            if(*c == '\\')
+                c = print_escape(c);
+            else
+                putchar(*c);
+        }
+    }
+
+    if(newline)
+        putchar('\n');
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Prints a single conversion of the printf built-in.
+ *
+ * @param spec the conversion specification without its conversion character, e.g. "%-8".
+ * @param conv the conversion character.
+ * @param arg the argument to convert, or NULL if the arguments are exhausted.
+ *
+ * @return 0 on success, 1 if arg is not a valid number for a numeric conversion, or -1
+ * if conv is not a supported conversion.
+ */
+static int print_conversion(char *spec, char conv, const char *arg) {
+    size_t len = strlen(spec);
+    char *end = NULL;
+    int status = 0;
+
+    switch(conv) {
+        case 's':
+            spec[len] = 's';
+            spec[len + 1] = '\0';
+            printf(spec, arg ? arg : "");
+            return 0;
+        case 'b':
+            for(const char *c = arg ? arg : ""; *c != '\0'; c++) {
+                if(*c == '\\')
+                    c = print_escape(c);
+                else
+                    putchar(*c);
+            }
+            return 0;
+        case 'c':
+            spec[len] = 'c';
+            spec[len + 1] = '\0';
+            if(arg != NULL && arg[0] != '\0')
+                printf(spec, arg[0]);
+            return 0;
+        case 'd':
+        case 'i': {
+            long long value = arg ? strtoll(arg, &end, 0) : 0;
+            if(arg != NULL && (*end != '\0' || end == arg)) {
+                fprintf(stderr, RED_TEXT "printf: %s: invalid number" RESET_COLOR "\n", arg);
+                status = 1;
+            }
+            spec[len] = 'l';
+            spec[len + 1] = 'l';
+            spec[len + 2] = 'd';
+            spec[len + 3] = '\0';
+            printf(spec, value);
+            return status;
+        }
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X': {
+            unsigned long long value = arg ? strtoull(arg, &end, 0) : 0;
+            if(arg != NULL && (*end != '\0' || end == arg)) {
+                fprintf(stderr, RED_TEXT "printf: %s: invalid number" RESET_COLOR "\n", arg);
+                status = 1;
+            }
+            spec[len] = 'l';
+            spec[len + 1] = 'l';
+            spec[len + 2] = conv;
+            spec[len + 3] = '\0';
+            printf(spec, value);
+            return status;
+        }
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G': {
+            double value = arg ? strtod(arg, &end) : 0.0;
+            if(arg != NULL && (*end != '\0' || end == arg)) {
+                fprintf(stderr, RED_TEXT "printf: %s: invalid number" RESET_COLOR "\n", arg);
+                status = 1;
+            }
+            spec[len] = conv;
+            spec[len + 1] = '\0';
+            printf(spec, value);
+            return status;
+        }
+        default:
+            return -1;
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command printf.
+ *
+ * @param args 2D char array containing the command, its format and all its arguments.
+ * @param state unused.
+ *
+ * @return 0 on success, 1 if an argument could not be converted or the format is invalid.
+ *
+ * @details Supports the %s, %b, %c, %d, %i, %u, %o, %x, %X, %e, %f and %g conversions with
+ * flags, width and precision, as well as %% and backslash escapes in the format. As in
+ * other shells the format is reused until every argument has been consumed.
+ */
+static int printf_builtin(char **args, SHrimpState *state) {
+    (void)state;
+
+    if(args[1] == NULL) {
+        fprintf(stderr, RED_TEXT "printf: usage: printf format [arguments]" RESET_COLOR "\n");
+        return 2;
+    }
+
+    const char *format = args[1];
+    char **argp = args + 2;
+    char **start;
+    int status = 0;
+
+    do {
+        start = argp;
+        for(const char *f = format; *f != '\0'; f++) {
+            if(*f == '\\') {
+                f = print_escape(f);
+                continue;
+            }
+            if(*f != '%') {
+                putchar(*f);
+                continue;
+            }
+            if(f[1] == '%') {
+                putchar('%');
+                f++;
+                continue;
+            }
+
+            // Collect the flags, width and precision of the conversion
+            char spec[40];
+            size_t len = 0;
+            spec[len++] = *f++;
+            while(*f != '\0' && strchr("-+ #0", *f) != NULL && len < 8)
+                spec[len++] = *f++;
+            while(isdigit((unsigned char)*f) && len < 20)
+                spec[len++] = *f++;
+            if(*f == '.') {
+                spec[len++] = *f++;
+                while(isdigit((unsigned char)*f) && len < 32)
+                    spec[len++] = *f++;
+            }
+            spec[len] = '\0';
+
+            if(*f == '\0') {
+                fprintf(stderr, RED_TEXT "printf: %s: missing format character" RESET_COLOR "\n", spec);
+                return 1;
+            }
+
+            const char *arg = *argp != NULL ? *argp++ : NULL;
+            int result = print_conversion(spec, *f, arg);
+            if(result < 0) {
+                fprintf(stderr, RED_TEXT "printf: %c: invalid format character" RESET_COLOR "\n", *f);
+                return 1;
+            }
+            status |= result;
+        }
+    } while(*argp != NULL && argp != start);
+
+    return status;
+}
+
+//======================================================================================
+
+// Dispatch table of every built-in command. Special built-ins change the state of the shell
+// itself, so they must run in the shell process and cannot be a stage of a pipeline
+static const Builtin builtins[] = {
+    { "bg",     bg_builtin,     BUILTIN_SPECIAL },
+    { "cat",    cat_builtin,    0 },
+    { "cd",     cd_builtin,     BUILTIN_SPECIAL },
+    { "echo",   echo_builtin,   0 },
+    { "exit",   exit_builtin,   BUILTIN_SPECIAL },
+    { "false",  false_builtin,  0 },
+    { "fg",     fg_builtin,     BUILTIN_SPECIAL },
+    { "hash",   hash_wrapper,   BUILTIN_SPECIAL },
+    { "history", history_builtin, 0 },
+    { "jobs",   jobs_builtin,   0 },
+    { "pmap",   pmap_builtin,   0 },
+    { "printf", printf_builtin, 0 },
+    { "pstat",  pstat_builtin,  0 },
+    { "pwd",    pwd_builtin,    0 },
+    { "scriptcache", scriptcache_builtin, 0 },
+    { "set",    set_builtin,    BUILTIN_SPECIAL },
+    { "shrimpstat", shrimpstat_builtin, 0 },
+    { "true",   true_builtin,   0 },
+    { "wait",   wait_builtin,   BUILTIN_SPECIAL }
+};
+
+//======================================================================================
+
+/**
+ * @brief Looks up a command name in the built-in dispatch table.
+ *
+ * @param name the command name to look up.
+ *
+ * @return The matching Builtin, or NULL if name is not a built-in command.
+ */
+const Builtin *find_builtin(const char *name) {
+    for(size_t i = 0; i < sizeof(builtins) / sizeof(builtins[0]); i++) {
+        if(strcmp(builtins[i].name, name) == 0)
+            return &builtins[i];
+    }
+
+    return NULL;
+}
+
+//======================================================================================
+
+/**
+ * @brief Looks up the built-in command that runs a command, given all of its arguments.
+ *
+ * @param args 2D char array containing the command and all its arguments.
+ *
+ * @return The matching Builtin, or NULL if the command is not a built-in or the built-in
+ * does not understand its arguments, so the executable of the same name in $PATH runs.
+ *
+ * @details Only cat shadows a standard utility without supporting all of its options, so
+ * it is the only built-in whose arguments are checked.
+ */
+const Builtin *find_command_builtin(char **args) {
+    const Builtin *builtin = find_builtin(args[0]);
+
+    if(builtin != NULL && builtin->func == cat_builtin && !cat_accepts(args))
+        return NULL;
+    return builtin;
+}
+
+//======================================================================================
+
+/**
+ * @brief Returns an entry of the built-in dispatch table, e.g. to list every built-in.
+ *
+ * @param index the index of the entry.
+ *
+ * @return The Builtin at index, or NULL if index is past the end of the table.
+ */
+const Builtin *builtin_at(size_t index) {
+    return index < sizeof(builtins) / sizeof(builtins[0]) ? &builtins[index] : NULL;
+}
+
+//======================================================================================
+
+/**
+ * @brief Runs a built-in command within the shell process.
+ *
+ * @param cmd SHrimpCommand object holding the built-in command and its redirection.
+ * @param state SHrimpState object passed on to the built-in command.
+ *
+ * @return The exit status of the built-in command, or 1 if its redirection failed.
+ *
+ * @details If the command is redirected, the shell's own stdin and stdout are saved to
+ * high file descriptors, redirected for the duration of the command, and then restored, so
+ * even "echo one > out.txt" never needs a child process. A here-string or here-doc becomes
+ * the shell's stdin the same way.
+ */
+int run_builtin(SHrimpCommand *cmd, SHrimpState *state) {
+    int saved_in = -1;
+    int saved_out = -1;
+    int status;
+
+    // Save the shell's stdin and stdout before redirecting them
+    if(cmd->input_redirect || cmd->here != NULL)
+        saved_in = fcntl(STDIN_FILENO, F_DUPFD_CLOEXEC, SAVED_FD_MIN);
+    if(cmd->output_redirect || cmd->append_redirect) {
+        fflush(stdout);
+        saved_out = fcntl(STDOUT_FILENO, F_DUPFD_CLOEXEC, SAVED_FD_MIN);
+    }
+
+    int here_fd = cmd->here != NULL ? redirect_here(cmd) : -1;
+    if(here_fd >= 0) {
+        dup2(here_fd, STDIN_FILENO);
+        close(here_fd);
+    }
+
+    if((cmd->here != NULL && here_fd < 0) || redirect(cmd) < 0)
+        status = 1;
+    else
+        status = cmd->builtin->func(cmd->args, state);
+    fflush(stdout);
+
+    // Restore the shell's stdin and stdout
+    if(saved_in >= 0) {
+        dup2(saved_in, STDIN_FILENO);
+        close(saved_in);
+    }
+    if(saved_out >= 0) {
+        dup2(saved_out, STDOUT_FILENO);
+        close(saved_out);
+    }
+
+    return status;
+}
+
+//======================================================================================
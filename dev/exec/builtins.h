@@ -0,0 +1,33 @@
+/* builtins.h
+ *
+ * Header file for builtins.c
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef BUILTINS_H
+#define BUILTINS_H
+
+#include "types/types.h"
+
+const Builtin *find_builtin(const char *name);
+const Builtin *find_command_builtin(char **args);
+const Builtin *builtin_at(size_t index);
+int run_builtin(SHrimpCommand *cmd, SHrimpState *state);
+
+#endif
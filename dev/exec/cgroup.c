@@ -0,0 +1,220 @@
+/* cgroup.c
+ *
+ * Contains the placement of background pipelines into a cgroup v2 directory, along with the
+ * CPU and memory limits applied to it.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/stat.h>      // mkdir()
+#include <fcntl.h>         // open(), openat(), O_RDONLY, O_WRONLY, O_DIRECTORY, O_CLOEXEC
+#include <unistd.h>        // write(), close()
+#include <stdio.h>         // fprintf(), snprintf(), sscanf(), fopen(), fgets(), fclose()
+#include <stdlib.h>        // free()
+#include <string.h>        // strlen(), strcmp(), strrchr(), memcpy(), strerror()
+#include <errno.h>         // errno, EEXIST, ENOENT, EIO
+#include "config/macros.h" // CGROUP_MOUNTS_FILE, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // SHrimpState
+#include "utils/utils.h"   // safe_strdup()
+#include "exec/cgroup.h"
+
+//======================================================================================
+
+/**
+ * @brief Finds where the cgroup v2 hierarchy is mounted.
+ *
+ * @param buf where the mount point is stored.
+ * @param size the size of buf.
+ *
+ * @return 0 on success, -1 if no cgroup2 file system is mounted.
+ *
+ * @details On a pure cgroup v2 system this is /sys/fs/cgroup, while hybrid systems mount it
+ * elsewhere, e.g. /sys/fs/cgroup/unified, so the mount table is read instead of assuming.
+ */
+static int cgroup_mount(char *buf, size_t size) {
+    FILE *mounts = fopen(CGROUP_MOUNTS_FILE, "re");
+    char line[4096], dir[4096], type[64];
+    int found = -1;
+
+    if(mounts == NULL)
+        return -1;
+    while(found < 0 && fgets(line, sizeof(line), mounts) != NULL) {
+        if(sscanf(line, "%*s %4095s %63s", dir, type) == 2 && strcmp(type, "cgroup2") == 0 && strlen(dir) < size) {
+            memcpy(buf, dir, strlen(dir) + 1);
+            found = 0;
+        }
+    }
+    fclose(mounts);
+
+    return found;
+}
+
+//======================================================================================
+
+/**
+ * @brief Writes a value to a file of a cgroup directory.
+ *
+ * @param dir_fd the cgroup directory.
+ * @param file the name of the file within it, e.g. cpu.max.
+ * @param value the value to write.
+ *
+ * @return 0 on success, -1 on failure, with errno set.
+ */
+static int cgroup_write(int dir_fd, const char *file, const char *value) {
+    int fd = openat(dir_fd, file, O_WRONLY | O_CLOEXEC);
+    if(fd < 0)
+        return -1;
+
+    size_t len = strlen(value);
+    ssize_t written = write(fd, value, len);
+    int error = errno;
+    close(fd);
+
+    if(written != (ssize_t)len) {
+        errno = written < 0 ? error : EIO;
+        return -1;
+    }
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Sets the cgroup background pipelines run in, creating it if it does not exist.
+ *
+ * @param state SHrimpState object whose cgroup is set.
+ * @param name the path of the cgroup relative to the root of the cgroup v2 hierarchy, e.g.
+ * shrimp.slice/batch, or "off" to run background pipelines in the shell's own cgroup.
+ *
+ * @return 0 on success, 1 if the hierarchy is not mounted or the cgroup cannot be opened.
+ *
+ * @details The directory is kept open, since CLONE_INTO_CGROUP takes a file descriptor of
+ * it. An unprivileged user can only create cgroups below one delegated to it, such as the
+ * user@.service cgroup of systemd.
+ */
+int cgroup_open(SHrimpState *state, const char *name) {
+    char root[4096], path[8192];
+
+    if(strcmp(name, "off") == 0) {
+        cgroup_close(state);
+        return 0;
+    }
+
+    while(*name == '/')
+        name++;
+    if(*name == '\0' || cgroup_mount(root, sizeof(root)) < 0) {
+        fprintf(stderr, RED_TEXT "set: cgroup: %s" RESET_COLOR "\n", *name == '\0' ? "missing cgroup name" : "no cgroup v2 hierarchy is mounted");
+        return 1;
+    }
+    snprintf(path, sizeof(path), "%s/%s", root, name);
+
+    if(mkdir(path, 0755) < 0 && errno != EEXIST) {
+        fprintf(stderr, RED_TEXT "set: cgroup: %s: %s" RESET_COLOR "\n", path, strerror(errno));
+        return 1;
+    }
+    int fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if(fd < 0) {
+        fprintf(stderr, RED_TEXT "set: cgroup: %s: %s" RESET_COLOR "\n", path, strerror(errno));
+        return 1;
+    }
+
+    cgroup_close(state);
+    state->cgroup_fd = fd;
+    state->cgroup_path = safe_strdup(path, "cgroup: path");
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Sets a limit of the cgroup background pipelines run in.
+ *
+ * @param state SHrimpState object holding the cgroup.
+ * @param option the name of the option setting the limit, used in error messages.
+ * @param controller the controller owning the limit, e.g. cpu.
+ * @param file the file of the limit, e.g. cpu.max.
+ * @param value the value to write to it.
+ *
+ * @return 0 on success, 1 if no cgroup is set or the limit is refused.
+ *
+ * @details The file of a limit only exists once its controller is enabled in the
+ * cgroup.subtree_control of the parent cgroup, so enabling it there is tried once before
+ * giving up.
+ */
+int cgroup_limit(SHrimpState *state, const char *option, const char *controller, const char *file, const char *value) {
+    if(state->cgroup_fd < 0) {
+        fprintf(stderr, RED_TEXT "set: %s: no cgroup is set, set cgroup=NAME first" RESET_COLOR "\n", option);
+        return 1;
+    }
+
+    if(cgroup_write(state->cgroup_fd, file, value) == 0)
+        return 0;
+
+    if(errno == ENOENT) {
+        char parent[8192], enable[64];
+        snprintf(parent, sizeof(parent), "%s", state->cgroup_path);
+        *strrchr(parent, '/') = '\0';
+        snprintf(enable, sizeof(enable), "+%s", controller);
+
+        int parent_fd = open(parent, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        int enabled = parent_fd >= 0 && cgroup_write(parent_fd, "cgroup.subtree_control", enable) == 0;
+        if(parent_fd >= 0)
+            close(parent_fd);
+        if(enabled && cgroup_write(state->cgroup_fd, file, value) == 0)
+            return 0;
+        if(!enabled) {
+            fprintf(stderr, RED_TEXT "set: %s: the %s controller is not available to %s" RESET_COLOR "\n", option, controller, state->cgroup_path);
+            return 1;
+        }
+    }
+
+    fprintf(stderr, RED_TEXT "set: %s: %s/%s: %s" RESET_COLOR "\n", option, state->cgroup_path, file, strerror(errno));
+    return 1;
+}
+
+//======================================================================================
+
+/**
+ * @brief Moves the calling process into a cgroup, for children that could not be created
+ * in it directly.
+ *
+ * @param cgroup_fd the cgroup directory to move into.
+ *
+ * @return 0 on success, -1 on failure, with errno set.
+ */
+int cgroup_join(int cgroup_fd) {
+    return cgroup_write(cgroup_fd, "cgroup.procs", "0");
+}
+
+//======================================================================================
+
+/**
+ * @brief Closes the cgroup background pipelines run in. The cgroup itself is left in place
+ * for any job still running in it.
+ *
+ * @param state SHrimpState object holding the cgroup.
+ */
+void cgroup_close(SHrimpState *state) {
+    if(state->cgroup_fd >= 0)
+        close(state->cgroup_fd);
+    free(state->cgroup_path);
+    state->cgroup_fd = -1;
+    state->cgroup_path = NULL;
+}
+
+//======================================================================================
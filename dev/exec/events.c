@@ -0,0 +1,200 @@
+/* events.c
+ *
+ * Contains the event loop the shell waits on while a line is edited and while a foreground
+ * job with a periodic report runs.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/epoll.h>     // epoll_create1(), epoll_ctl(), epoll_wait(), struct epoll_event
+#include <sys/timerfd.h>   // timerfd_create(), timerfd_settime(), struct itimerspec
+#include <stdint.h>        // uint32_t, uint64_t
+#include <unistd.h>        // read(), close()
+#include <errno.h>         // errno, EINTR
+#include "config/macros.h" // EVENT_INPUT, EVENT_CHILD, EVENT_TIMER
+#include "types/types.h"   // EventLoop
+#include "exec/events.h"
+
+//======================================================================================
+
+/**
+ * @brief Sets up an event loop without creating anything, since most shells never wait on
+ * more than a single child at a time.
+ *
+ * @param loop EventLoop object to set up.
+ */
+void events_init(EventLoop *loop) {
+    loop->epoll_fd = -1;
+    loop->input_fd = -1;
+    loop->child_fd = -1;
+    loop->timer_fd = -1;
+    loop->timer_ms = 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Creates the epoll instance of an event loop, the first time it is needed.
+ *
+ * @param loop EventLoop object to open.
+ *
+ * @return 0 on success, -1 if the epoll instance could not be created.
+ */
+static int events_open(EventLoop *loop) {
+    if(loop->epoll_fd < 0)
+        loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+    return loop->epoll_fd < 0 ? -1 : 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Replaces the fd registered for one kind of event.
+ *
+ * @param loop EventLoop object holding the registration.
+ * @param registered the fd currently registered, replaced by fd.
+ * @param fd the fd to register, or -1 to leave none registered.
+ * @param event the EVENT_* bit reported when fd is readable.
+ *
+ * @return 0 on success, -1 if epoll refused the fd.
+ *
+ * @details Registrations persist between waits, so a caller waiting on the same fds over and
+ * over, such as the line editor between keys, costs a single epoll_wait() per event.
+ */
+static int events_register(EventLoop *loop, int *registered, int fd, uint32_t event) {
+    if(*registered == fd)
+        return 0;
+
+    if(*registered >= 0)
+        epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, *registered, NULL);
+    *registered = -1;
+
+    if(fd >= 0) {
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = event };
+        if(epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0)
+            return -1;
+        *registered = fd;
+    }
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Arms the periodic timer of an event loop, or disarms it.
+ *
+ * @param loop EventLoop object holding the timer.
+ * @param ms the period of the timer, or 0 to disarm it.
+ *
+ * @return 0 on success, -1 if the timer could not be created or armed.
+ *
+ * @details Once armed, every events_wait() reports EVENT_TIMER whenever a period went by.
+ * The timer keeps firing on its own schedule no matter how many other events wake the loop
+ * in between, unlike a timeout that starts over on every wake-up and is never reached while
+ * children keep exiting faster than it.
+ */
+int events_timer(EventLoop *loop, int ms) {
+    if(loop->timer_ms == ms)
+        return 0;
+    if(events_open(loop) < 0)
+        return -1;
+
+    if(loop->timer_fd < 0) {
+        int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if(fd < 0)
+            return -1;
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = EVENT_TIMER };
+        if(epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            close(fd);
+            return -1;
+        }
+        loop->timer_fd = fd;
+    }
+
+    struct itimerspec spec = {
+        .it_interval = { ms / 1000, (ms % 1000) * 1000000L },
+        .it_value = { ms / 1000, (ms % 1000) * 1000000L }
+    };
+    if(timerfd_settime(loop->timer_fd, 0, &spec, NULL) < 0)
+        return -1;
+    loop->timer_ms = ms;
+
+    // A disarmed timer may still hold an expiration that must not be reported later
+    uint64_t expirations;
+    if(ms == 0 && read(loop->timer_fd, &expirations, sizeof(expirations)) < 0)
+        expirations = 0;
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Blocks until an fd is readable, or until the periodic timer fires.
+ *
+ * @param loop EventLoop object to wait on.
+ * @param input_fd fd reported as EVENT_INPUT, e.g. the terminal, or -1 to ignore input.
+ * @param child_fd signalfd reported as EVENT_CHILD, or -1 to ignore child exits.
+ *
+ * @return The EVENT_* bits of every source that is ready, 0 if interrupted by a signal, or
+ * -1 if the event loop could not be set up, in which case the caller should block on its
+ * fd directly.
+ *
+ * @details Nothing is read from input_fd or child_fd, whose owners drain them, so the loop
+ * never holds data back from them. The expirations of the timer are consumed here, so a
+ * single EVENT_TIMER is reported however many periods went by.
+ */
+int events_wait(EventLoop *loop, int input_fd, int child_fd) {
+    if(events_open(loop) < 0 ||
+       events_register(loop, &loop->input_fd, input_fd, EVENT_INPUT) < 0 ||
+       events_register(loop, &loop->child_fd, child_fd, EVENT_CHILD) < 0)
+        return -1;
+
+    struct epoll_event ready[3];
+    int ready_amt = epoll_wait(loop->epoll_fd, ready, 3, -1);
+    if(ready_amt < 0)
+        return errno == EINTR ? 0 : -1;
+
+    int events = 0;
+    for(int i = 0; i < ready_amt; i++)
+        events |= ready[i].data.u32;
+
+    if(events & EVENT_TIMER) {
+        uint64_t expirations;
+        if(read(loop->timer_fd, &expirations, sizeof(expirations)) < 0)
+            events &= ~EVENT_TIMER;
+    }
+    return events;
+}
+
+//======================================================================================
+
+/**
+ * @brief Closes everything an event loop created.
+ *
+ * @param loop EventLoop object to close.
+ */
+void events_free(EventLoop *loop) {
+    if(loop->timer_fd >= 0)
+        close(loop->timer_fd);
+    if(loop->epoll_fd >= 0)
+        close(loop->epoll_fd);
+    events_init(loop);
+}
+
+//======================================================================================
@@ -0,0 +1,33 @@
+/* pipestat.h
+ *
+ * Header file for events.c
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include "types/types.h"
+
+void events_init(EventLoop *loop);
+int events_timer(EventLoop *loop, int ms);
+int events_wait(EventLoop *loop, int input_fd, int child_fd);
+void events_free(EventLoop *loop);
+
+#endif
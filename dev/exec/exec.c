@@ -17,58 +17,161 @@
  *
  * Author: Ryan McHenry
  * Created: January 23, 2026
- * Last Modified: February 10, 2026
+ * Last Modified: October 14, 2026
  */
 
 #include <sys/types.h>     // pid_t
-#include <sys/wait.h>      // waitpid()
-#include <string.h>        // strcmp()
 #include <stdio.h>         // printf(), perror()
 #include <stdlib.h>        // exit()
-#include <unistd.h>        // chdir(), execvp()
+#include <string.h>        // memmove()
+#include <signal.h>        // SIGINT, SIGQUIT
+#include <unistd.h>        // pipe2(), close(), setpgid()
+#include <fcntl.h>         // fcntl(), F_SETPIPE_SZ, O_CLOEXEC
 #include "config/macros.h" // RED_TEXT, RESET_COLOR
-#include "types/types.h"   // SHrimpCommand, DelayedCommand, SHrimpState
-#include "exec/redirect.h" // redirect()
+#include "types/types.h"   // SHrimpCommand, SpawnSpec, Job, SHrimpState
+#include "exec/hash.h"     // hash_lookup()
+#include "exec/spawn.h"    // spawn_command()
+#include "exec/redirect.h" // redirect_here()
+#include "exec/numa.h"     // numa_place()
+#include "exec/jobs.h"     // job_new(), job_launched(), job_foreground(), job_wait_any(), job_collect()
+#include "utils/arena.h"   // arena_alloc()
+#include "utils/trace.h"   // TRACE_DECLARE(), TRACE_START(), TRACE_STOP()
 #include "exec/exec.h"
 
 //======================================================================================
 
 /**
- * @brief Executes the built-in Linux command cd using chdir().
+ * @brief Launches every stage of a pipeline as a new job, without waiting for it.
  *
- * @param args 2D char array containing the command and all its arguments.
+ * @param pipeline Pipeline object containing every command to execute.
+ * @param state SHrimpState object allowing access to the shell's job table and command
+ * hash table.
+ * @param pgid process group the job joins with job control or in the background, 0 to start
+ * a new one led by its first process.
+ * @param foreground flag for if the job's process group takes over the terminal.
+ * @param out_fd fd to use as the stdout of the last stage, -1 to inherit the shell's.
  *
- * @return 0 to denote a successful directory change, 1 to denote an insuccessful
- * directory change.
+ * @return The launched Job, which is already done if none of its stages could be launched.
+ *
+ * @details Each command is launched with the spawn engine selected in the shell state, which
+ * sets up its pipe ends and redirection before executing it. Pipes are created with
+ * O_CLOEXEC one stage at a time, so the shell never holds more than two pipe ends at once
+ * and each child only inherits the ends it duplicates onto its stdin and stdout. The rest
+ * are closed by exec itself, keeping wide pipelines linear in system calls.
+ *
+ * Background pipelines are created in the cgroup set with "set cgroup=NAME", if any, and
+ * every stage of a pipeline prefixed with prio lowers its own priority before executing.
+ * The stages of a pipeline prefixed with pin are pinned to the CPUs of the NUMA node
+ * numa_place() picks, which is recorded in the job.
+ *
+ * A here-string or here-doc is opened by the parent as well and replaces the pipe feeding
+ * its stage, so every spawn engine passes it to the child like any other pipe end.
+ *
+ * Every command is resolved through the command hash table in the parent before launching, so
+ * the table persists between commands and the child can execute the absolute path directly
+ * instead of having execvp() walk $PATH again.
  */
-int cd(char **args) {
-    if(args[2] != NULL) {
-        printf(RED_TEXT "cd: too many arguments" RESET_COLOR "\n");
-        return 1;        
-    } 
-
-    // cd to home dir
-    if(args[1] == NULL || strcmp(args[1], "~") == 0) {
-        char *home = getenv("HOME");
-        if(home != NULL) {
-            if(chdir(home) == -1) {
-                printf(RED_TEXT "SHrimp: cd home: No home directory found" RESET_COLOR "\n");
-                return 1;
-            }
-        } else {
-            printf(RED_TEXT "SHrimp: cd: error finding home directory" RESET_COLOR "\n");
-            return 1;
+Job *exec_launch(Pipeline *pipeline, SHrimpState *state, pid_t pgid, int foreground, int out_fd) {
+    // Flush pending output so the children do not inherit and re-print it
+    fflush(stdout);
+
+    Job *job = job_new(state, pipeline);
+    int job_control = state->jobs.job_control;
+
+    // Background pipelines get a process group of their own even without job control, so a
+    // Ctrl-C meant for the foreground never reaches them and the whole job can be signalled
+    // as one. Foreground pipelines of a script stay in the shell's group, so the terminal can
+    // still interrupt the script as a whole
+    int grouped = job_control || pipeline->background;
+    job->pgid = grouped ? pgid : 0;
+
+    // Every stage of a pinned pipeline shares the CPUs of one NUMA node, so the pipes
+    // between them never cross sockets. A node that cannot be used leaves it unpinned
+    const cpu_set_t *affinity = NULL;
+    if(pipeline->pin) {
+        int index = numa_place(state, pipeline->pin_node);
+        if(index >= 0) {
+            affinity = &state->numa.cpus[index];
+            job->node = state->numa.ids[index];
         }
-        return 0;
     }
 
-    // cd to dir passed as args[1]
-    if(chdir(args[1]) == -1) {
-        printf(RED_TEXT "SHrimp: cd: %s: No such file or directory" RESET_COLOR "\n", args[1]);
-        return 1;
+    // Launch pipeline->command_amt child processes. For each one set the correct fd depending
+    // on its position in the pipeline, redirect if applicable and then execute
+    int prev_read = -1;    // read end of the pipe feeding the current stage
+    for(int i = 0; i < pipeline->command_amt; i++) {
+        // Create the pipe between this stage and the next one only once it is needed
+        int fd[2] = {-1, -1};
+        if(i < pipeline->command_amt - 1 && pipe2(fd, O_CLOEXEC) < 0) {
+            perror("pipe failed");
+            exit(1);
+        }
+
+        // Resize the pipe if requested. A size refused here, e.g. once the per-user pipe
+        // limit is reached, leaves the pipe at its default size
+        if(fd[1] >= 0 && state->pipe_size > 0)
+            fcntl(fd[1], F_SETPIPE_SZ, state->pipe_size);
+
+        // Built-in stages run in a forked child and never look up an executable
+        const char *path = NULL;
+        if(pipeline->commands[i]->builtin == NULL) {
+            TRACE_DECLARE(lookup_start);
+            TRACE_START(state, lookup_start);
+            path = hash_lookup(&state->hash, pipeline->commands[i]->args[0]);
+            TRACE_STOP(state, TRACE_LOOKUP, lookup_start);
+        }
+
+        int here_fd = pipeline->commands[i]->here != NULL ? redirect_here(pipeline->commands[i]) : -1;
+
+        SpawnSpec spec = {
+            .cmd = pipeline->commands[i],
+            .path = path,
+            .in_fd = here_fd >= 0 ? here_fd : prev_read,
+            .out_fd = i < pipeline->command_amt - 1 ? fd[1] : out_fd,
+            .unused_fd = fd[0],
+            .sigmask = &state->jobs.child_mask,
+            .pgid = grouped ? job->pgid : -1,
+            .foreground = job_control && foreground,
+            .job_control = job_control,
+            .cgroup_fd = pipeline->background ? state->cgroup_fd : -1,
+            .nice = pipeline->nice,
+            .ioprio = pipeline->ioprio,
+            .affinity = affinity,
+            .state = state,
+            .status = pipeline->commands[i]->here != NULL && here_fd < 0 ? 1 : 127
+        };
+        TRACE_DECLARE(spawn_start);
+        TRACE_START(state, spawn_start);
+        pid_t pid = -1;
+        if(pipeline->commands[i]->here == NULL || here_fd >= 0)
+            pid = spawn_command(&spec, state->spawn_engine);
+        TRACE_STOP(state, TRACE_SPAWN, spawn_start);
+
+        job->pids[i] = pid;
+        if(pid < 0) {
+            job->statuses[i] = spec.status;
+        } else {
+            job->live++;
+            if(job->pgid == 0)
+                job->pgid = pid;
+            // Also join the process group from the parent, so it exists before any later
+            // stage or tcsetpgrp() refers to it no matter which side runs first
+            if(grouped)
+                setpgid(pid, job->pgid);
+        }
+
+        // Close file descriptors in the parent process
+        if(here_fd >= 0)
+            close(here_fd);
+        if(prev_read >= 0)
+            close(prev_read);
+        if(fd[1] >= 0)
+            close(fd[1]);
+        prev_read = fd[0];
     }
+    job_launched(state, job);
 
-    return 0;
+    return job;
 }
 
 //======================================================================================
@@ -76,79 +179,124 @@ int cd(char **args) {
 /**
  * @brief Executes the user command.
  *
- * @param cmd SHrimpCommand object containing all needed values to execute a unix command.
- * @param state SHrimpState object allowing access to the shell's job_number variable.
+ * @param pipeline Pipeline object containing every command to execute.
+ * @param state SHrimpState object allowing access to the shell's job table and command
+ * hash table.
  *
- * @return 0 if command successfully execited, 1 if execution was insuccessful.
+ * @return The exit status of the last command of the pipeline, 128 plus the signal number if
+ * it was killed or stopped by a signal, 127 if it could not be launched, or 0 for a
+ * background pipeline.
  *
- * @details Executes the user command. The function first pipes the command if applicable. Then,
- * the process is forked and on the child process the command is redirected if applicable, and 
- * then executed. If the process is not run in the background, the parent process waits for the
- * child process to finish executing the command.
+ * @details Every pipeline becomes a job in the job table. With job control each job gets a
+ * process group of its own, led by its first process. If the job is not run in the
+ * background, the shell waits for it to finish or be stopped, otherwise its number and pid
+ * are printed and its status is collected later through the job table.
  */
 int exec_pipeline(Pipeline *pipeline, SHrimpState *state) {
-    // Create file descriptors for each command in the pipeline
-    int fd[pipeline->command_amt - 1][2];
+    Job *job = exec_launch(pipeline, state, 0, pipeline->background == 0, -1);
 
-    // Create pipeline->command_amt - 1 pipes
-    for(int i = 0; i < pipeline->command_amt - 1; i++) {
-        if(pipe(fd[i]) < 0) {
-            perror("pipe failed");
-            exit(1);
+    if(pipeline->background == 0) {
+        TRACE_DECLARE(wait_start);
+        TRACE_START(state, wait_start);
+        int status = job_foreground(state, job, 0);
+        TRACE_STOP(state, TRACE_WAIT, wait_start);
+        return status;
+    }
+
+    // Report the background job by the pid of its last process
+    for(int i = job->proc_amt - 1; i >= 0; i--) {
+        if(job->pids[i] > 0) {
+            printf("[%d] %d\n", job->id, job->pids[i]);
+            break;
         }
     }
+    state->jobs.current = job->id;
 
-    // Fork pipeline->command_amt child processes. For each one set the correct fd depending
-    // on its position in the pipeline, redirect if applicable and then execute
-    pid_t pids[pipeline->command_amt];
-    for(int i = 0; i < pipeline->command_amt; i++) {
-        pids[i] = fork();
-        if(pids[i] < 0) {
-            perror("fork failed");
-            exit(1);
-        } else if(pids[i] > 0) { // parent
-            // Close file descriptors in the parent process
-            if(i > 0)
-                close(fd[i-1][0]);
-            if(i < pipeline->command_amt - 1)
-                close(fd[i][1]);
-        } else if(pids[i] == 0) { // child
-            // Set the correct fd
-            if(i > 0) {
-                dup2(fd[i-1][0], STDIN_FILENO);
-            }
-            if(i < pipeline->command_amt - 1) {
-                dup2(fd[i][1], STDOUT_FILENO);
-            }
-            for(int j = 0; j < pipeline->command_amt - 1; j++) {
-                close(fd[j][0]);
-                close(fd[j][1]);
-            }
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes a group of pipelines joined by &| all at once, e.g.
+ * "rsync a host: &| rsync b host: &| gzip c".
+ *
+ * @param pipelines the Pipeline objects of the group, in the order they appear on the line.
+ * @param pipeline_amt the amount of pipelines in the group.
+ * @param state SHrimpState object holding the job table and the parallel option.
+ *
+ * @return 0 if every pipeline succeeded, otherwise the status of the first pipeline of the
+ * line that failed. If the group is stopped, 128 plus the signal number.
+ *
+ * @details Every pipeline becomes a job of its own and is launched without waiting for the
+ * previous one, so the shell only blocks once the whole group is running or the limit set
+ * with "set parallel=N" is reached. Whenever a job of the group finishes, the next pipeline
+ * takes its slot. With job control the group shares a single process group holding the
+ * terminal, so Ctrl-C and Ctrl-Z reach every pipeline of it. A process group only exists
+ * while one of its processes does, so a pipeline launched after every earlier process of
+ * the group was reaped starts a new one. A stopped group stays in the job table and the
+ * pipelines it never launched are dropped, as are those of a group interrupted by Ctrl-C.
+ */
+int exec_parallel(Pipeline **pipelines, int pipeline_amt, SHrimpState *state) {
+    Job **running = arena_alloc(&state->arena, pipeline_amt * sizeof(Job *));
+    int *positions = arena_alloc(&state->arena, pipeline_amt * sizeof(int));
+    int *statuses = arena_alloc(&state->arena, pipeline_amt * sizeof(int));
+    int running_amt = 0, launched = 0, stopped = -1;
+    pid_t pgid = 0;
+
+    while(stopped < 0 && (launched < pipeline_amt || running_amt > 0)) {
+        // Launch pipelines until every one is running or the limit is reached
+        while(launched < pipeline_amt && (state->parallel_limit <= 0 || running_amt < state->parallel_limit)) {
+            int live = 0;
+            for(int i = 0; i < running_amt; i++)
+                live += running[i]->live;
+            if(live == 0)
+                pgid = 0;
 
-            // Redirect if applicable
-            if(pipeline->commands[i]->input_redirect == 1 || pipeline->commands[i]->output_redirect == 1 || pipeline->commands[i]->append_redirect == 1) {
-                redirect(pipeline->commands[i]);
+            Job *job = exec_launch(pipelines[launched], state, pgid, 1, -1);
+            if(job->pgid > 0)
+                pgid = job->pgid;
+            if(job->state == JOB_DONE) {
+                statuses[launched++] = job_collect(state, job);
+                continue;
             }
+            positions[running_amt] = launched++;
+            running[running_amt++] = job;
+        }
+        if(running_amt == 0)
+            break;
 
-            // Execute the current command in the pipeline
-            execvp(pipeline->commands[i]->args[0], pipeline->commands[i]->args);
-            printf(RED_TEXT "%s: command not found" RESET_COLOR "\n", pipeline->commands[i]->args[0]); 
-            exit(1); 
+        TRACE_DECLARE(wait_start);
+        TRACE_START(state, wait_start);
+        int done = job_wait_any(state, running, running_amt);
+        TRACE_STOP(state, TRACE_WAIT, wait_start);
+
+        Job *job = running[done];
+        if(job->state == JOB_STOPPED)
+            stopped = positions[done];
+        statuses[positions[done]] = job_collect(state, job);
+
+        // Pipelines interrupted by Ctrl-C or Ctrl-\ interrupt the rest of the group as well
+        if(statuses[positions[done]] == 128 + SIGINT || statuses[positions[done]] == 128 + SIGQUIT) {
+            for(; launched < pipeline_amt; launched++)
+                statuses[launched] = statuses[positions[done]];
         }
+
+        // Keep the remaining jobs in the order they were launched
+        running_amt--;
+        memmove(&running[done], &running[done + 1], (running_amt - done) * sizeof(Job *));
+        memmove(&positions[done], &positions[done + 1], (running_amt - done) * sizeof(int));
     }
+    jobs_take_terminal(state);
 
-    if(pipeline->background == 0) {
-        for(int i = 0; i < pipeline->command_amt; i++) {
-            waitpid(pids[i], NULL, 0);
-        }
-    } else {
-        for(int i = 0; i < pipeline->command_amt; i++) {
-            printf("[%d] %d\n", state->job_number++, pids[i]);
-        } 
+    if(stopped >= 0)
+        return statuses[stopped];
+    for(int i = 0; i < pipeline_amt; i++) {
+        if(statuses[i] != 0)
+            return statuses[i];
     }
 
     return 0;
 }
 
 //======================================================================================
-
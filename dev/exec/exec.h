@@ -25,7 +25,8 @@
 
 #include "types/types.h"
 
-int cd(char **args);
+Job *exec_launch(Pipeline *pipeline, SHrimpState *state, pid_t pgid, int foreground, int out_fd);
 int exec_pipeline(Pipeline *pipeline, SHrimpState *state);
+int exec_parallel(Pipeline **pipelines, int pipeline_amt, SHrimpState *state);
 
 #endif
\ No newline at end of file
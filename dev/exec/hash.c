@@ -0,0 +1,254 @@
+/* hash.c
+ *
+ * Contains the logic for the command hash table, which caches the resolved
+ * absolute path of every command looked up in $PATH.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/stat.h>      // stat(), S_ISREG()
+#include <unistd.h>        // access(), X_OK
+#include <stdio.h>         // printf(), fprintf()
+#include <stdlib.h>        // getenv(), free()
+#include <string.h>        // strchr(), strcmp(), strlen(), memcpy()
+#include "config/macros.h" // HASH_BUCKETS, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // CommandHash, HashEntry
+#include "utils/utils.h"   // safe_malloc(), safe_strdup()
+#include "exec/hash.h"
+
+//======================================================================================
+
+/**
+ * @brief Computes the bucket index of a command name using the djb2 string hash.
+ *
+ * @param name the command name to hash.
+ *
+ * @return The bucket index of name, in the range [0, HASH_BUCKETS).
+ */
+static unsigned int hash_index(const char *name) {
+    unsigned int hash = 5381;
+    for(const char *c = name; *c != '\0'; c++) {
+        hash = ((hash << 5) + hash) + (unsigned char)*c;
+    }
+
+    return hash % HASH_BUCKETS;
+}
+
+//======================================================================================
+
+/**
+ * @brief Searches every directory in $PATH for an executable named name.
+ *
+ * @param name the command name to search for.
+ * @param path_env the value of $PATH to search through.
+ *
+ * @return A heap allocated string holding the absolute path of the command, or NULL if
+ * the command was not found in any directory.
+ *
+ * @details An empty $PATH entry denotes the current directory, matching the behavior of
+ * execvp(). Only regular files with execute permission are accepted.
+ */
+static char *hash_search_path(const char *name, const char *path_env) {
+    size_t name_len = strlen(name);
+    const char *dir = path_env;
+
+    while(dir != NULL) {
+        const char *end = strchr(dir, ':');
+        size_t dir_len = end ? (size_t)(end - dir) : strlen(dir);
+
+        // Build "<dir>/<name>", treating an empty entry as "."
+        char *candidate = safe_malloc(dir_len + name_len + 3, "hash: candidate");
+        if(dir_len == 0) {
+            candidate[0] = '.';
+            dir_len = 1;
+        } else {
+            memcpy(candidate, dir, dir_len);
+        }
+        candidate[dir_len] = '/';
+        memcpy(candidate + dir_len + 1, name, name_len + 1);
+
+        struct stat sb;
+        if(stat(candidate, &sb) == 0 && S_ISREG(sb.st_mode) && access(candidate, X_OK) == 0)
+            return candidate;
+
+        free(candidate);
+        dir = end ? end + 1 : NULL;
+    }
+
+    return NULL;
+}
+
+//======================================================================================
+
+/**
+ * @brief Returns the current value of $PATH, first discarding every entry of the command
+ * hash table if $PATH has changed since the table was filled.
+ *
+ * @param table CommandHash object to check.
+ *
+ * @return The value of $PATH, or the default search path if it is unset.
+ *
+ * @details Everything else caching the contents of $PATH, such as the completion trie,
+ * shares this invalidation by comparing the table's generation, which changes whenever
+ * the table is cleared.
+ */
+const char *hash_path(CommandHash *table) {
+    const char *path_env = getenv("PATH");
+    if(path_env == NULL)
+        path_env = "/usr/local/bin:/usr/bin:/bin";
+    if(table->path_env == NULL || strcmp(table->path_env, path_env) != 0) {
+        if(table->path_env != NULL)
+            hash_clear(table);
+        table->path_env = safe_strdup(path_env, "hash: path_env");
+    }
+
+    return path_env;
+}
+
+//======================================================================================
+
+/**
+ * @brief Resolves a command name to the absolute path of its executable, filling the
+ * command hash table on the first lookup of every name.
+ *
+ * @param table CommandHash object to search and fill.
+ * @param name the command name to resolve, as typed by the user.
+ *
+ * @return The path to pass to execv(), or NULL if the command could not be found.
+ *
+ * @details Names containing a slash are returned as-is and are never cached. Before each
+ * lookup the table is checked against the current value of $PATH with hash_path(). Misses
+ * are not cached, so a command installed later is picked up on the next lookup.
+ */
+const char *hash_lookup(CommandHash *table, const char *name) {
+    if(strchr(name, '/') != NULL)
+        return name;
+
+    const char *path_env = hash_path(table);
+
+    // Cache hit
+    unsigned int index = hash_index(name);
+    for(HashEntry *entry = table->buckets[index]; entry != NULL; entry = entry->next) {
+        if(strcmp(entry->name, name) == 0) {
+            entry->hits++;
+            return entry->path;
+        }
+    }
+
+    // Cache miss, walk $PATH once and remember the result
+    char *path = hash_search_path(name, path_env);
+    if(path == NULL)
+        return NULL;
+
+    HashEntry *entry = safe_malloc(sizeof(HashEntry), "hash: entry");
+    entry->name = safe_strdup(name, "hash: entry->name");
+    entry->path = path;
+    entry->hits = 1;
+    entry->next = table->buckets[index];
+    table->buckets[index] = entry;
+    table->count++;
+
+    return entry->path;
+}
+
+//======================================================================================
+
+/**
+ * @brief Frees every entry in the command hash table.
+ *
+ * @param table CommandHash object to clear.
+ */
+void hash_clear(CommandHash *table) {
+    for(int i = 0; i < HASH_BUCKETS; i++) {
+        HashEntry *entry = table->buckets[i];
+        while(entry != NULL) {
+            HashEntry *next = entry->next;
+            free(entry->name);
+            free(entry->path);
+            free(entry);
+            entry = next;
+        }
+        table->buckets[i] = NULL;
+    }
+
+    free(table->path_env);
+    table->path_env = NULL;
+    table->count = 0;
+    table->generation++;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command hash.
+ *
+ * @param args 2D char array containing the command and all its arguments.
+ * @param table CommandHash object to display or modify.
+ *
+ * @return 0 on success, 1 if an argument could not be resolved or was invalid.
+ *
+ * @details With no arguments every remembered command is printed along with its hit
+ * count. "hash -r" forgets every remembered command, and "hash name..." looks up each
+ * name and adds it to the table without running it.
+ */
+int hash_builtin(char **args, CommandHash *table) {
+    // Display the table
+    if(args[1] == NULL) {
+        if(table->count == 0) {
+            printf("hash: hash table empty\n");
+            return 0;
+        }
+
+        printf("hits\tcommand\n");
+        for(int i = 0; i < HASH_BUCKETS; i++) {
+            for(HashEntry *entry = table->buckets[i]; entry != NULL; entry = entry->next) {
+                printf("%4d\t%s\n", entry->hits, entry->path);
+            }
+        }
+        return 0;
+    }
+
+    // Clear the table
+    if(strcmp(args[1], "-r") == 0) {
+        if(args[2] != NULL) {
+            fprintf(stderr, RED_TEXT "hash: -r does not take any arguments" RESET_COLOR "\n");
+            return 1;
+        }
+        hash_clear(table);
+        return 0;
+    }
+
+    // Remember each of the provided commands
+    int status = 0;
+    for(int i = 1; args[i] != NULL; i++) {
+        if(args[i][0] == '-') {
+            fprintf(stderr, RED_TEXT "hash: %s: invalid option" RESET_COLOR "\n", args[i]);
+            return 1;
+        }
+        if(strchr(args[i], '/') != NULL)
+            continue;
+        if(hash_lookup(table, args[i]) == NULL) {
+            fprintf(stderr, RED_TEXT "hash: %s: not found" RESET_COLOR "\n", args[i]);
+            status = 1;
+        }
+    }
+
+    return status;
+}
+
+//======================================================================================
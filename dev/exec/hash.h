@@ -0,0 +1,33 @@
+/* hash.h
+ *
+ * Header file for hash.c
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef HASH_H
+#define HASH_H
+
+#include "types/types.h"
+
+const char *hash_path(CommandHash *table);
+const char *hash_lookup(CommandHash *table, const char *name);
+void hash_clear(CommandHash *table);
+int hash_builtin(char **args, CommandHash *table);
+
+#endif
@@ -0,0 +1,1008 @@
+/* jobs.c
+ *
+ * Contains the job table of SHrimp, the reaping of child processes through a signalfd and
+ * the job control built-in commands jobs, wait, fg and bg.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/types.h>     // pid_t
+#include <sys/wait.h>      // wait4(), WIFEXITED(), WEXITSTATUS(), WIFSIGNALED(), WIFSTOPPED()
+#include <sys/resource.h>  // struct rusage
+#include <time.h>          // clock_gettime()
+#include <sys/signalfd.h>  // signalfd(), struct signalfd_siginfo
+#include <signal.h>        // sigprocmask(), signal(), kill(), killpg(), SIGCHLD, SIGCONT
+#include <termios.h>       // tcgetattr(), tcsetattr()
+#include <unistd.h>        // read(), getpgrp(), setpgid(), tcgetpgrp(), tcsetpgrp(), STDIN_FILENO
+#include <stdio.h>         // printf(), fprintf(), sprintf(), snprintf(), fflush()
+#include <stdlib.h>        // free(), strtol()
+#include <string.h>        // strlen(), memcpy(), memmove(), memset(), strcmp()
+#include <errno.h>         // errno, EINTR
+#include "config/macros.h" // INITIAL_JOBS, INITIAL_PID_SLOTS, EVENT_CHILD, EVENT_TIMER, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // Job, JobTable, JobState, PidSlot, Pipeline, SHrimpCommand, SHrimpState
+#include "utils/utils.h"   // safe_malloc()
+#include "exec/accounting.h" // job_total(), job_report_usage(), job_log_record()
+#include "exec/pipestat.h" // pipestat_report()
+#include "exec/events.h"   // events_timer(), events_wait()
+#include "exec/jobs.h"
+
+//======================================================================================
+
+/**
+ * @brief Blocks SIGCHLD for good, then takes control of the terminal if the shell is
+ * interactive. The signalfd used to reap children is opened by job_new() once the first
+ * job is launched, so a shell that only runs built-ins never opens it.
+ *
+ * @param state SHrimpState object holding the job table to initialize.
+ * @param interactive flag for if the shell reads its commands from a terminal.
+ *
+ * @details Since SIGCHLD is never delivered to a handler, nothing can reap a child behind
+ * the job table's back and no system call of the shell is ever interrupted by it. Children
+ * are launched with the signal mask the shell started with.
+ *
+ * An interactive shell waits until it is in the foreground of its terminal, ignores the
+ * job control signals, and moves into its own process group so that every job can be
+ * given a process group and the terminal of its own.
+ */
+void jobs_init(SHrimpState *state, int interactive) {
+    JobTable *table = &state->jobs;
+
+    sigset_t chld_mask;
+    sigemptyset(&chld_mask);
+    sigaddset(&chld_mask, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &chld_mask, &table->child_mask);
+    table->signal_fd = -1;
+    table->log_fd = -1;
+
+    if(interactive == 0)
+        return;
+
+    // Stop until the shell is placed in the foreground, like any other background job
+    while(tcgetpgrp(STDIN_FILENO) != getpgrp())
+        kill(-getpgrp(), SIGTTIN);
+
+    signal(SIGINT, SIG_IGN);
+    signal(SIGQUIT, SIG_IGN);
+    signal(SIGTSTP, SIG_IGN);
+    signal(SIGTTIN, SIG_IGN);
+    signal(SIGTTOU, SIG_IGN);
+
+    // A session leader cannot change its process group, but already leads one anyway
+    setpgid(0, 0);
+    table->shell_pgid = getpgrp();
+    tcsetpgrp(STDIN_FILENO, table->shell_pgid);
+    tcgetattr(STDIN_FILENO, &table->tmodes);
+    table->job_control = 1;
+}
+
+//======================================================================================
+
+/**
+ * @brief Builds the text of a single command as shown by the jobs built-in.
+ *
+ * @param cmd SHrimpCommand object to describe.
+ *
+ * @return A heap allocated string holding the args and redirections of the command.
+ */
+static char *build_stage(SHrimpCommand *cmd) {
+    size_t len = 1;
+    for(int j = 0; j < cmd->arg_amt; j++)
+        len += strlen(cmd->args[j]) + 1;
+    if(cmd->infile != NULL)
+        len += strlen(cmd->infile) + 3;
+    if(cmd->outfile != NULL)
+        len += strlen(cmd->outfile) + 4;
+
+    char *stage = safe_malloc(len, "jobs: stage");
+    char *p = stage;
+    for(int j = 0; j < cmd->arg_amt; j++)
+        p += sprintf(p, j > 0 ? " %s" : "%s", cmd->args[j]);
+    if(cmd->infile != NULL)
+        p += sprintf(p, " < %s", cmd->infile);
+    if(cmd->outfile != NULL)
+        p += sprintf(p, cmd->append_redirect ? " >> %s" : " > %s", cmd->outfile);
+    *p = '\0';
+
+    return stage;
+}
+
+//======================================================================================
+
+/**
+ * @brief Joins the text of every stage of a job into the text of its pipeline.
+ *
+ * @param stages the text of every stage.
+ * @param stage_amt the amount of stages.
+ *
+ * @return A heap allocated string holding every stage separated by pipes.
+ */
+static char *join_stages(char **stages, int stage_amt) {
+    size_t len = 1;
+    for(int i = 0; i < stage_amt; i++)
+        len += strlen(stages[i]) + 3;
+
+    char *cmdline = safe_malloc(len, "jobs: cmdline");
+    char *p = cmdline;
+    for(int i = 0; i < stage_amt; i++)
+        p += sprintf(p, i > 0 ? " | %s" : "%s", stages[i]);
+    *p = '\0';
+
+    return cmdline;
+}
+
+//======================================================================================
+
+/**
+ * @brief Builds the text of a pipeline, as the jobs built-in shows it.
+ *
+ * @param pipeline Pipeline object to describe.
+ *
+ * @return A heap allocated string holding every stage separated by pipes.
+ */
+char *pipeline_text(Pipeline *pipeline) {
+    char **stages = safe_malloc(pipeline->command_amt * sizeof(char *), "jobs: stages");
+    for(int i = 0; i < pipeline->command_amt; i++)
+        stages[i] = build_stage(pipeline->commands[i]);
+
+    char *text = join_stages(stages, pipeline->command_amt);
+    for(int i = 0; i < pipeline->command_amt; i++)
+        free(stages[i]);
+    free(stages);
+
+    return text;
+}
+
+//======================================================================================
+
+/**
+ * @brief Adds a new job for a pipeline to the job table.
+ *
+ * @param state SHrimpState object holding the job table.
+ * @param pipeline Pipeline object the job is launched from.
+ *
+ * @return The new Job. Each of its pids is -1 until the caller launches the matching stage.
+ *
+ * @details The new job gets the number one past the highest job number in use, so numbers
+ * are reused once every later job has been collected.
+ */
+Job *job_new(SHrimpState *state, Pipeline *pipeline) {
+    JobTable *table = &state->jobs;
+
+    if(table->job_amt == table->job_cap) {
+        int cap = table->job_cap > 0 ? table->job_cap * 2 : INITIAL_JOBS;
+        Job **jobs = safe_malloc(cap * sizeof(Job *), "jobs: job table");
+        if(table->job_amt > 0)
+            memcpy(jobs, table->jobs, table->job_amt * sizeof(Job *));
+        free(table->jobs);
+        table->jobs = jobs;
+        table->job_cap = cap;
+    }
+
+    // The signalfd is only opened once the first child is about to exist. A SIGCHLD of a
+    // child started before that, such as the spawn server, stays pending until it is opened
+    if(table->signal_fd < 0) {
+        sigset_t chld_mask;
+        sigemptyset(&chld_mask);
+        sigaddset(&chld_mask, SIGCHLD);
+        table->signal_fd = signalfd(-1, &chld_mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    }
+
+    Job *job = safe_malloc(sizeof(Job), "jobs: job");
+    job->id = table->job_amt > 0 ? table->jobs[table->job_amt - 1]->id + 1 : 1;
+    job->proc_amt = pipeline->command_amt;
+    job->pids = safe_malloc(job->proc_amt * sizeof(pid_t), "jobs: pids");
+    job->statuses = safe_malloc(job->proc_amt * sizeof(int), "jobs: statuses");
+    for(int i = 0; i < job->proc_amt; i++)
+        job->pids[i] = -1;
+    job->state = JOB_RUNNING;
+    job->background = pipeline->background;
+    job->stages = safe_malloc(job->proc_amt * sizeof(char *), "jobs: stages");
+    for(int i = 0; i < job->proc_amt; i++)
+        job->stages[i] = build_stage(pipeline->commands[i]);
+    job->cmdline = join_stages(job->stages, job->proc_amt);
+    job->usage = safe_malloc(job->proc_amt * sizeof(struct rusage), "jobs: usage");
+    job->ended = safe_malloc(job->proc_amt * sizeof(struct timespec), "jobs: ended");
+    job->timed = pipeline->timed;
+    job->samples = NULL;
+    job->node = -1;
+    job->pipefail = state->pipefail;
+    job->sample = pipeline->sample;
+    clock_gettime(CLOCK_MONOTONIC, &job->started);
+
+    table->jobs[table->job_amt++] = job;
+    return job;
+}
+
+//======================================================================================
+
+/**
+ * @brief Returns the slot a pid is looked up from first in the pid hash.
+ *
+ * @param pid the pid to hash.
+ * @param mask the capacity of the hash minus one.
+ */
+static size_t pid_home(pid_t pid, size_t mask) {
+    return ((uint32_t)pid * 2654435761u) & mask;
+}
+
+//======================================================================================
+
+/**
+ * @brief Finds the slot of a process in the pid hash of the job table.
+ *
+ * @param table JobTable object holding the pid hash.
+ * @param pid the process to find.
+ *
+ * @return The slot of the process, or NULL if it belongs to no job of the table.
+ */
+static PidSlot *pid_find(JobTable *table, pid_t pid) {
+    if(table->slot_cap == 0)
+        return NULL;
+
+    size_t mask = table->slot_cap - 1;
+    for(size_t i = pid_home(pid, mask); table->slots[i].pid != 0; i = (i + 1) & mask) {
+        if(table->slots[i].pid == pid)
+            return &table->slots[i];
+    }
+    return NULL;
+}
+
+//======================================================================================
+
+/**
+ * @brief Adds a process of a job to the pid hash of the job table.
+ *
+ * @param table JobTable object holding the pid hash.
+ * @param pid the process to add.
+ * @param job the Job the process belongs to.
+ * @param stage the index of the process within the job.
+ *
+ * @details The hash uses open addressing with linear probing and is kept at most half full,
+ * doubling and rehashing every live process when it would be fuller, so finding the job of
+ * a reaped child takes constant time however many jobs are running.
+ */
+static void pid_insert(JobTable *table, pid_t pid, Job *job, int stage) {
+    if((table->slot_amt + 1) * 2 > table->slot_cap) {
+        PidSlot *old = table->slots;
+        int old_cap = table->slot_cap;
+
+        table->slot_cap = old_cap > 0 ? old_cap * 2 : INITIAL_PID_SLOTS;
+        table->slots = safe_malloc(table->slot_cap * sizeof(PidSlot), "jobs: pid hash");
+        memset(table->slots, 0, table->slot_cap * sizeof(PidSlot));
+        table->slot_amt = 0;
+        for(int i = 0; i < old_cap; i++) {
+            if(old[i].pid != 0)
+                pid_insert(table, old[i].pid, old[i].job, old[i].stage);
+        }
+        free(old);
+    }
+
+    size_t mask = table->slot_cap - 1;
+    size_t i = pid_home(pid, mask);
+    while(table->slots[i].pid != 0)
+        i = (i + 1) & mask;
+    table->slots[i] = (PidSlot){ pid, job, stage };
+    table->slot_amt++;
+}
+
+//======================================================================================
+
+/**
+ * @brief Removes a process from the pid hash of the job table, if it is in it.
+ *
+ * @param table JobTable object holding the pid hash.
+ * @param pid the process to remove.
+ *
+ * @details Every later slot of the same probe run that may move into the freed slot is
+ * shifted back into it, so the hash never needs tombstones and lookups stay short.
+ */
+static void pid_remove(JobTable *table, pid_t pid) {
+    PidSlot *slot = pid_find(table, pid);
+    if(slot == NULL)
+        return;
+
+    size_t mask = table->slot_cap - 1;
+    size_t hole = slot - table->slots;
+    table->slots[hole].pid = 0;
+    table->slot_amt--;
+
+    for(size_t i = (hole + 1) & mask; table->slots[i].pid != 0; i = (i + 1) & mask) {
+        size_t home = pid_home(table->slots[i].pid, mask);
+        if(((i - home) & mask) >= ((i - hole) & mask)) {
+            table->slots[hole] = table->slots[i];
+            table->slots[i].pid = 0;
+            hole = i;
+        }
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Removes a job from the job table and frees it.
+ *
+ * @param state SHrimpState object holding the job table.
+ * @param job the Job to remove.
+ */
+static void job_remove(SHrimpState *state, Job *job) {
+    JobTable *table = &state->jobs;
+
+    for(int i = 0; i < table->job_amt; i++) {
+        if(table->jobs[i] == job) {
+            memmove(&table->jobs[i], &table->jobs[i + 1], (table->job_amt - i - 1) * sizeof(Job *));
+            table->job_amt--;
+            break;
+        }
+    }
+    if(table->current == job->id)
+        table->current = 0;
+
+    // A job given up on while its processes still run must not be found by them later
+    for(int i = 0; i < job->proc_amt; i++) {
+        PidSlot *slot = job->pids[i] > 0 ? pid_find(table, job->pids[i]) : NULL;
+        if(slot != NULL && slot->job == job)
+            pid_remove(table, job->pids[i]);
+    }
+
+    for(int i = 0; i < job->proc_amt; i++)
+        free(job->stages[i]);
+    free(job->stages);
+    free(job->pids);
+    free(job->statuses);
+    free(job->cmdline);
+    free(job->usage);
+    free(job->ended);
+    free(job->samples);
+    free(job);
+}
+
+//======================================================================================
+
+/**
+ * @brief Marks a job as done, reporting its resource use if it was timed, storing it if it
+ * was benchmarked, and recording it in the job log if one is set.
+ *
+ * @param state SHrimpState object holding the job table.
+ * @param job the Job whose last process was reaped.
+ */
+static void job_done(SHrimpState *state, Job *job) {
+    job->state = JOB_DONE;
+
+    if(job->timed)
+        job_report_usage(job);
+    if(job->sample != NULL)
+        job_total(job, &job->sample->usage);
+    if(state->jobs.log_fd >= 0)
+        job_log_record(job, state->jobs.log_fd);
+}
+
+//======================================================================================
+
+/**
+ * @brief Records a status change reported by wait4() in the job owning the process.
+ *
+ * @param state SHrimpState object holding the job table.
+ * @param pid the process whose status changed.
+ * @param wstatus the status reported by wait4().
+ * @param usage the resources used by the process, valid if it terminated.
+ *
+ * @details The job is found through the pid hash rather than by scanning every job, and a
+ * process that terminated leaves the hash.
+ */
+static void job_update(SHrimpState *state, pid_t pid, int wstatus, const struct rusage *usage) {
+    JobTable *table = &state->jobs;
+
+    PidSlot *slot = pid_find(table, pid);
+    if(slot == NULL)
+        return;
+    Job *job = slot->job;
+    int j = slot->stage;
+
+    if(WIFSTOPPED(wstatus)) {
+        job->state = JOB_STOPPED;
+        job->stop_status = 128 + WSTOPSIG(wstatus);
+        table->current = job->id;
+    } else if(WIFCONTINUED(wstatus)) {
+        job->state = JOB_RUNNING;
+    } else {
+        pid_remove(table, pid);
+        job->statuses[j] = WIFEXITED(wstatus) ? WEXITSTATUS(wstatus) : 128 + WTERMSIG(wstatus);
+        job->usage[j] = *usage;
+        clock_gettime(CLOCK_MONOTONIC, &job->ended[j]);
+        if(--job->live == 0)
+            job_done(state, job);
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Finishes setting up a job once the shell tried to launch every one of its stages.
+ *
+ * @param state SHrimpState object holding the job table.
+ * @param job the Job that was launched.
+ *
+ * @details Every launched process is added to the pid hash, which is how its exit is
+ * matched to the job. A job none of whose stages could be launched is done right away, and
+ * is still recorded in the job log.
+ */
+void job_launched(SHrimpState *state, Job *job) {
+    for(int i = 0; i < job->proc_amt; i++) {
+        if(job->pids[i] < 0) {
+            job->ended[i] = job->started;
+            memset(&job->usage[i], 0, sizeof(struct rusage));
+        } else {
+            pid_insert(&state->jobs, job->pids[i], job, i);
+        }
+    }
+
+    if(job->live == 0)
+        job_done(state, job);
+}
+
+//======================================================================================
+
+/**
+ * @brief Returns the exit status of a finished job.
+ *
+ * @param job the Job to get the status of.
+ *
+ * @return The exit status of the last process of the job. With set pipefail=on when the job
+ * was launched, that of the last process that failed, or 0 if none did.
+ */
+static int job_status(Job *job) {
+    if(job->pipefail) {
+        for(int i = job->proc_amt - 1; i >= 0; i--) {
+            if(job->statuses[i] != 0)
+                return job->statuses[i];
+        }
+    }
+
+    return job->statuses[job->proc_amt - 1];
+}
+
+//======================================================================================
+
+/**
+ * @brief Reaps every child process whose status changed, without blocking.
+ *
+ * @param state SHrimpState object holding the job table.
+ *
+ * @details The signalfd is drained first, and waitpid() is only called if a SIGCHLD was
+ * actually pending. Since the signal is blocked, a SIGCHLD arriving after the signalfd was
+ * drained stays pending until the next call, so no status change is ever missed.
+ */
+void jobs_reap(SHrimpState *state) {
+    struct signalfd_siginfo info;
+    int pending = 0;
+    if(state->jobs.signal_fd < 0)
+        return;
+    while(read(state->jobs.signal_fd, &info, sizeof(info)) == sizeof(info))
+        pending = 1;
+    if(pending == 0)
+        return;
+
+    pid_t pid;
+    int wstatus;
+    struct rusage usage;
+    while((pid = wait4(-1, &wstatus, WNOHANG | WUNTRACED | WCONTINUED, &usage)) > 0)
+        job_update(state, pid, wstatus, &usage);
+}
+
+//======================================================================================
+
+/**
+ * @brief Blocks until any of a set of jobs finishes or is stopped.
+ *
+ * @param state SHrimpState object holding the job table.
+ * @param jobs the Jobs to wait for.
+ * @param job_amt the amount of jobs.
+ *
+ * @return The index of the first job in jobs that is no longer running.
+ *
+ * @details Children are reaped with wait4(-1), so the status of any background job
+ * finishing in the meantime is recorded in the job table rather than being lost.
+ *
+ * With set pipestat, the shell waits on its event loop instead of blocking in wait4(), with
+ * a periodic timer that reports the pipes of every job with more than one stage once every
+ * interval, no matter how often other children exit in between. Without a timer there is
+ * nothing but the children to wait for, which a blocking wait4() does in one system call
+ * per exit.
+ */
+int job_wait_any(SHrimpState *state, Job **jobs, int job_amt) {
+    int timed = state->pipestat_ms > 0 && state->jobs.signal_fd >= 0 &&
+                events_timer(&state->events, state->pipestat_ms) == 0;
+
+    while(1) {
+        for(int i = 0; i < job_amt; i++) {
+            if(jobs[i]->state != JOB_RUNNING) {
+                if(timed)
+                    events_timer(&state->events, 0);
+                return i;
+            }
+        }
+
+        int ready = timed ? events_wait(&state->events, -1, state->jobs.signal_fd) : -1;
+        if(ready >= 0) {
+            if(ready & EVENT_CHILD)
+                jobs_reap(state);
+            for(int i = 0; (ready & EVENT_TIMER) && i < job_amt; i++) {
+                if(jobs[i]->proc_amt > 1 && jobs[i]->state == JOB_RUNNING)
+                    pipestat_report(jobs[i], stderr);
+            }
+            continue;
+        }
+
+        int wstatus;
+        struct rusage usage;
+        pid_t pid = wait4(-1, &wstatus, WUNTRACED, &usage);
+        if(pid < 0) {
+            if(errno == EINTR)
+                continue;
+            // No children are left, so the job cannot finish on its own anymore
+            job_done(state, jobs[0]);
+            if(timed)
+                events_timer(&state->events, 0);
+            return 0;
+        }
+        job_update(state, pid, wstatus, &usage);
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Prints a single line describing a job, in the format of the jobs built-in.
+ *
+ * @param state SHrimpState object holding the job table.
+ * @param job the Job to describe.
+ * @param show_pgid flag for if the process group of the job is printed as well, along with
+ * the NUMA node of a pinned job.
+ */
+static void job_print(SHrimpState *state, Job *job, int show_pgid) {
+    char text[32];
+    if(job->state == JOB_RUNNING)
+        snprintf(text, sizeof(text), "Running");
+    else if(job->state == JOB_STOPPED)
+        snprintf(text, sizeof(text), "Stopped");
+    else if(job_status(job) == 0)
+        snprintf(text, sizeof(text), "Done");
+    else
+        snprintf(text, sizeof(text), "Exit %d", job_status(job));
+
+    printf("[%d]%c  ", job->id, job->id == state->jobs.current ? '+' : ' ');
+    if(show_pgid)
+        printf("%d ", job->pgid);
+    if(show_pgid && job->node >= 0)
+        printf("node=%d ", job->node);
+    printf("%-24s%s%s\n", text, job->cmdline, job->state == JOB_RUNNING && job->background ? " &" : "");
+}
+
+//======================================================================================
+
+/**
+ * @brief Reaps finished children and, in an interactive shell, reports every background
+ * job that finished since the last prompt.
+ *
+ * @param state SHrimpState object holding the job table.
+ *
+ * @details Reported jobs are removed from the job table. A non-interactive shell keeps
+ * finished jobs until their status is collected by wait or reported by jobs.
+ */
+void jobs_notify(SHrimpState *state) {
+    JobTable *table = &state->jobs;
+
+    jobs_reap(state);
+    if(table->job_control == 0)
+        return;
+
+    for(int i = 0; i < table->job_amt; i++) {
+        Job *job = table->jobs[i];
+        if(job->state == JOB_DONE) {
+            job_print(state, job, 0);
+            job_remove(state, job);
+            i--;
+        }
+    }
+    fflush(stdout);
+}
+
+//======================================================================================
+
+/**
+ * @brief Reaps finished children and counts the jobs jobs_notify() would report.
+ *
+ * @param state SHrimpState object holding the job table.
+ *
+ * @return The amount of finished jobs waiting to be reported, always 0 without job control.
+ *
+ * @details Lets the line editor clear the line being edited only when a report is due.
+ */
+int jobs_finished(SHrimpState *state) {
+    JobTable *table = &state->jobs;
+    int finished = 0;
+
+    jobs_reap(state);
+    for(int i = 0; table->job_control && i < table->job_amt; i++)
+        finished += table->jobs[i]->state == JOB_DONE;
+
+    return finished;
+}
+
+//======================================================================================
+
+/**
+ * @brief Takes the terminal back from a foreground job along with the shell's terminal
+ * modes. Does nothing without job control.
+ *
+ * @param state SHrimpState object holding the job table.
+ */
+void jobs_take_terminal(SHrimpState *state) {
+    JobTable *table = &state->jobs;
+
+    if(table->job_control) {
+        tcsetpgrp(STDIN_FILENO, table->shell_pgid);
+        tcsetattr(STDIN_FILENO, TCSADRAIN, &table->tmodes);
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Collects a foreground job that finished or was stopped.
+ *
+ * @param state SHrimpState object holding the job table.
+ * @param job the Job that is no longer running.
+ *
+ * @return The exit status of the job, or 128 plus the signal number if it was stopped.
+ *
+ * @details A finished job is removed from the job table, while a stopped job is reported
+ * and stays in it as the current job.
+ */
+int job_collect(SHrimpState *state, Job *job) {
+    if(job->state == JOB_STOPPED) {
+        // A stopped benchmark run is no longer measured, its sample does not outlive the line
+        job->sample = NULL;
+        state->jobs.current = job->id;
+        printf("\n");
+        job_print(state, job, 0);
+        return job->stop_status;
+    }
+
+    int status = job_status(job);
+    job_remove(state, job);
+    return status;
+}
+
+//======================================================================================
+
+/**
+ * @brief Runs a job in the foreground until it finishes or is stopped.
+ *
+ * @param state SHrimpState object holding the job table.
+ * @param job the Job to run in the foreground.
+ * @param cont flag for if the job must be sent SIGCONT first, as when resumed by fg.
+ *
+ * @return The exit status of the job, or 128 plus the signal number if it was stopped.
+ *
+ * @details With job control the terminal is handed to the job's process group, and taken
+ * back along with the shell's terminal modes once the job is done or stopped. A finished
+ * job is removed from the job table, while a stopped job stays in it as the current job.
+ */
+int job_foreground(SHrimpState *state, Job *job, int cont) {
+    JobTable *table = &state->jobs;
+
+    job->background = 0;
+    if(table->job_control && job->pgid > 0)
+        tcsetpgrp(STDIN_FILENO, job->pgid);
+    if(cont && job->state == JOB_STOPPED) {
+        job->state = JOB_RUNNING;
+        if(table->job_control)
+            killpg(job->pgid, SIGCONT);
+    }
+
+    job_wait_any(state, &job, 1);
+    jobs_take_terminal(state);
+
+    return job_collect(state, job);
+}
+
+//======================================================================================
+
+/**
+ * @brief Frees every job of the job table and closes its signalfd and job log.
+ *
+ * @param state SHrimpState object holding the job table.
+ */
+void jobs_free(SHrimpState *state) {
+    JobTable *table = &state->jobs;
+
+    while(table->job_amt > 0)
+        job_remove(state, table->jobs[table->job_amt - 1]);
+    free(table->jobs);
+    table->jobs = NULL;
+    table->job_cap = 0;
+    free(table->slots);
+    table->slots = NULL;
+    table->slot_cap = 0;
+    table->slot_amt = 0;
+
+    if(table->signal_fd >= 0)
+        close(table->signal_fd);
+    table->signal_fd = -1;
+    if(table->log_owned)
+        close(table->log_fd);
+    table->log_fd = -1;
+    table->log_owned = 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Finds the job a job spec refers to.
+ *
+ * @param state SHrimpState object holding the job table.
+ * @param spec the job spec, either %n for job n or NULL, % , %% or %+ for the current job.
+ *
+ * @return The matching Job, or NULL if there is none.
+ *
+ * @details The current job is the job most recently stopped or started in the background,
+ * falling back to the most recently started job once it has been collected.
+ */
+Job *job_find(SHrimpState *state, const char *spec) {
+    JobTable *table = &state->jobs;
+    int id = table->current;
+
+    if(spec != NULL && strcmp(spec, "%") != 0 && strcmp(spec, "%%") != 0 && strcmp(spec, "%+") != 0) {
+        char *end;
+        if(spec[0] != '%')
+            return NULL;
+        id = (int)strtol(spec + 1, &end, 10);
+        if(end == spec + 1 || *end != '\0')
+            return NULL;
+    } else if(id == 0 && table->job_amt > 0) {
+        return table->jobs[table->job_amt - 1];
+    }
+
+    for(int i = 0; i < table->job_amt; i++) {
+        if(table->jobs[i]->id == id)
+            return table->jobs[i];
+    }
+
+    return NULL;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command jobs, which lists the jobs of the shell.
+ *
+ * @param args 2D char array containing the command and all its arguments. -l also lists
+ * the process group of each job and the NUMA node of each pinned job, -p lists only the
+ * process groups, and job specs limit the listing to the given jobs.
+ * @param state SHrimpState object holding the job table.
+ *
+ * @return 0 on success, 1 if a job spec or option is invalid.
+ *
+ * @details Finished jobs are removed from the job table once they have been listed.
+ */
+int jobs_builtin(char **args, SHrimpState *state) {
+    JobTable *table = &state->jobs;
+    int show_pgid = 0, pgid_only = 0, status = 0;
+    int i = 1;
+
+    jobs_reap(state);
+
+    for(; args[i] != NULL && args[i][0] == '-'; i++) {
+        if(strcmp(args[i], "-l") == 0) {
+            show_pgid = 1;
+        } else if(strcmp(args[i], "-p") == 0) {
+            pgid_only = 1;
+        } else {
+            fprintf(stderr, RED_TEXT "jobs: %s: invalid option" RESET_COLOR "\n", args[i]);
+            return 1;
+        }
+    }
+
+    // Mark the jobs to list, every job if no job specs are given
+    int amt = table->job_amt;
+    Job *listed[amt > 0 ? amt : 1];
+    int listed_amt = 0;
+    if(args[i] == NULL) {
+        for(int j = 0; j < amt; j++)
+            listed[listed_amt++] = table->jobs[j];
+    }
+    for(; args[i] != NULL; i++) {
+        Job *job = job_find(state, args[i]);
+        if(job == NULL) {
+            fprintf(stderr, RED_TEXT "jobs: %s: no such job" RESET_COLOR "\n", args[i]);
+            status = 1;
+        } else if(listed_amt < amt) {
+            listed[listed_amt++] = job;
+        }
+    }
+
+    for(int j = 0; j < listed_amt; j++) {
+        if(pgid_only)
+            printf("%d\n", listed[j]->pgid);
+        else
+            job_print(state, listed[j], show_pgid);
+    }
+
+    // Finished jobs have now been reported. A job listed twice must only be removed once
+    for(int j = 0; j < listed_amt; j++) {
+        if(listed[j] == NULL || listed[j]->state != JOB_DONE)
+            continue;
+        for(int k = j + 1; k < listed_amt; k++) {
+            if(listed[k] == listed[j])
+                listed[k] = NULL;
+        }
+        job_remove(state, listed[j]);
+    }
+
+    return status;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command wait, which waits for jobs to finish.
+ *
+ * @param args 2D char array containing the command and all its arguments. With no arguments
+ * every running job is waited for, otherwise each argument is a job spec or a pid.
+ * @param state SHrimpState object holding the job table.
+ *
+ * @return 0 if no arguments were given, otherwise the status of the last job or process
+ * waited for, or 127 if it is not a child of the shell.
+ *
+ * @details Collected jobs are removed from the job table. Waiting for a single pid only
+ * removes its job once every process of the job has been collected.
+ */
+int wait_builtin(char **args, SHrimpState *state) {
+    JobTable *table = &state->jobs;
+
+    jobs_reap(state);
+
+    if(args[1] == NULL) {
+        for(int i = 0; i < table->job_amt; i++) {
+            Job *job = table->jobs[i];
+            if(job->state == JOB_RUNNING)
+                job_wait_any(state, &job, 1);
+            if(job->state == JOB_DONE) {
+                job_remove(state, job);
+                i--;
+            }
+        }
+        return 0;
+    }
+
+    int status = 0;
+    for(int i = 1; args[i] != NULL; i++) {
+        Job *job = NULL;
+        int proc = -1;
+
+        if(args[i][0] == '%') {
+            job = job_find(state, args[i]);
+            if(job == NULL) {
+                fprintf(stderr, RED_TEXT "wait: %s: no such job" RESET_COLOR "\n", args[i]);
+                status = 127;
+                continue;
+            }
+        } else {
+            char *end;
+            pid_t pid = (pid_t)strtol(args[i], &end, 10);
+            for(int j = 0; end != args[i] && *end == '\0' && job == NULL && j < table->job_amt; j++) {
+                for(int k = 0; k < table->jobs[j]->proc_amt; k++) {
+                    if(table->jobs[j]->pids[k] == pid) {
+                        job = table->jobs[j];
+                        proc = k;
+                    }
+                }
+            }
+            if(job == NULL) {
+                fprintf(stderr, RED_TEXT "wait: pid %s is not a child of this shell" RESET_COLOR "\n", args[i]);
+                status = 127;
+                continue;
+            }
+        }
+
+        if(job->state == JOB_RUNNING)
+            job_wait_any(state, &job, 1);
+        if(job->state == JOB_STOPPED) {
+            status = job->stop_status;
+            continue;
+        }
+
+        status = proc >= 0 ? job->statuses[proc] : job_status(job);
+        job_remove(state, job);
+    }
+
+    return status;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command fg, which resumes a job in the foreground.
+ *
+ * @param args 2D char array containing the command and all its arguments. args[1] is the
+ * job spec of the job to resume, the current job if omitted.
+ * @param state SHrimpState object holding the job table.
+ *
+ * @return The status of the resumed job, or 1 if there is no such job or no job control.
+ */
+int fg_builtin(char **args, SHrimpState *state) {
+    if(state->jobs.job_control == 0) {
+        fprintf(stderr, RED_TEXT "fg: no job control" RESET_COLOR "\n");
+        return 1;
+    }
+
+    jobs_reap(state);
+    Job *job = job_find(state, args[1]);
+    if(job == NULL) {
+        fprintf(stderr, RED_TEXT "fg: %s: no such job" RESET_COLOR "\n", args[1] != NULL ? args[1] : "current");
+        return 1;
+    }
+
+    printf("%s\n", job->cmdline);
+    fflush(stdout);
+
+    return job_foreground(state, job, 1);
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command bg, which resumes stopped jobs in the background.
+ *
+ * @param args 2D char array containing the command and all its arguments. Each argument is
+ * the job spec of a job to resume, the current job if none are given.
+ * @param state SHrimpState object holding the job table.
+ *
+ * @return 0 if every job was resumed, 1 if there is no such job or no job control.
+ */
+int bg_builtin(char **args, SHrimpState *state) {
+    if(state->jobs.job_control == 0) {
+        fprintf(stderr, RED_TEXT "bg: no job control" RESET_COLOR "\n");
+        return 1;
+    }
+
+    jobs_reap(state);
+
+    int status = 0;
+    int i = 1;
+    do {
+        Job *job = job_find(state, args[i]);
+        if(job == NULL) {
+            fprintf(stderr, RED_TEXT "bg: %s: no such job" RESET_COLOR "\n", args[i] != NULL ? args[i] : "current");
+            status = 1;
+        } else {
+            job->background = 1;
+            state->jobs.current = job->id;
+            if(job->state == JOB_STOPPED) {
+                job->state = JOB_RUNNING;
+                killpg(job->pgid, SIGCONT);
+            }
+            printf("[%d]+ %s &\n", job->id, job->cmdline);
+        }
+    } while(args[i] != NULL && args[++i] != NULL);
+
+    return status;
+}
+
+//======================================================================================
@@ -0,0 +1,46 @@
+/* jobs.h
+ *
+ * Header file for jobs.c
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef JOBS_H
+#define JOBS_H
+
+#include "types/types.h"
+
+void jobs_init(SHrimpState *state, int interactive);
+char *pipeline_text(Pipeline *pipeline);
+Job *job_new(SHrimpState *state, Pipeline *pipeline);
+void job_launched(SHrimpState *state, Job *job);
+int job_wait_any(SHrimpState *state, Job **jobs, int job_amt);
+void jobs_take_terminal(SHrimpState *state);
+int job_collect(SHrimpState *state, Job *job);
+int job_foreground(SHrimpState *state, Job *job, int cont);
+void jobs_reap(SHrimpState *state);
+Job *job_find(SHrimpState *state, const char *spec);
+void jobs_notify(SHrimpState *state);
+int jobs_finished(SHrimpState *state);
+void jobs_free(SHrimpState *state);
+int jobs_builtin(char **args, SHrimpState *state);
+int wait_builtin(char **args, SHrimpState *state);
+int fg_builtin(char **args, SHrimpState *state);
+int bg_builtin(char **args, SHrimpState *state);
+
+#endif
@@ -0,0 +1,179 @@
+/* numa.c
+ *
+ * Contains the placement of pinned pipelines on the CPUs of a single NUMA node.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sched.h>         // sched_getaffinity(), cpu_set_t, CPU_ZERO(), CPU_SET(), CPU_ISSET(), CPU_AND(), CPU_COUNT()
+#include <stdio.h>         // fprintf(), snprintf(), fopen(), fgets(), fclose()
+#include <stdlib.h>        // strtol(), free()
+#include "config/macros.h" // NUMA_NODE_DIR, PIN_NODE_AUTO, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // SHrimpState, NumaTopology, Job
+#include "utils/utils.h"   // safe_malloc()
+#include "exec/numa.h"
+
+//======================================================================================
+
+/**
+ * @brief Reads a list of numbers in the format of the kernel's cpulist files, e.g. 0-3,8.
+ *
+ * @param path the file to read.
+ * @param set where the numbers are stored as set bits.
+ *
+ * @return 0 on success, -1 if the file cannot be read or is malformed.
+ */
+static int read_list(const char *path, cpu_set_t *set) {
+    char text[4096];
+    FILE *file = fopen(path, "re");
+    if(file == NULL)
+        return -1;
+    char *read = fgets(text, sizeof(text), file);
+    fclose(file);
+    if(read == NULL)
+        return -1;
+
+    CPU_ZERO(set);
+    char *cursor = text;
+    while(*cursor != '\0' && *cursor != '\n') {
+        char *end;
+        long first = strtol(cursor, &end, 10), last = first;
+        if(end == cursor)
+            return -1;
+        if(*end == '-') {
+            cursor = end + 1;
+            last = strtol(cursor, &end, 10);
+            if(end == cursor)
+                return -1;
+        }
+        for(long n = first; n <= last && n < CPU_SETSIZE; n++)
+            CPU_SET(n, set);
+
+        cursor = *end == ',' ? end + 1 : end;
+    }
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Reads the NUMA nodes of the system and the CPUs of each one the shell may run on.
+ *
+ * @param numa NumaTopology object to fill in.
+ *
+ * @details CPUs outside the shell's own affinity mask, e.g. those a cpuset cgroup denies,
+ * are left out, and so are nodes left without any CPU, such as memory-only nodes. A system
+ * without NUMA support in sysfs is treated as a single node 0 holding every CPU.
+ */
+static void numa_load(NumaTopology *numa) {
+    cpu_set_t allowed, online, node_cpus;
+    char path[256];
+
+    numa->loaded = 1;
+    if(sched_getaffinity(0, sizeof(allowed), &allowed) < 0)
+        return;
+
+    snprintf(path, sizeof(path), "%s/online", NUMA_NODE_DIR);
+    if(read_list(path, &online) < 0) {
+        CPU_ZERO(&online);
+        CPU_SET(0, &online);
+    }
+
+    int node_amt = CPU_COUNT(&online);
+    numa->ids = safe_malloc(node_amt * sizeof(int), "numa: ids");
+    numa->cpus = safe_malloc(node_amt * sizeof(cpu_set_t), "numa: cpus");
+    for(int node = 0; node < CPU_SETSIZE && numa->node_amt < node_amt; node++) {
+        if(!CPU_ISSET(node, &online))
+            continue;
+
+        snprintf(path, sizeof(path), "%s/node%d/cpulist", NUMA_NODE_DIR, node);
+        if(read_list(path, &node_cpus) < 0)
+            node_cpus = allowed;
+        CPU_AND(&node_cpus, &node_cpus, &allowed);
+        if(CPU_COUNT(&node_cpus) == 0)
+            continue;
+
+        numa->ids[numa->node_amt] = node;
+        numa->cpus[numa->node_amt++] = node_cpus;
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Picks the NUMA node every stage of a pinned pipeline runs on.
+ *
+ * @param state SHrimpState object holding the NUMA topology and the job table.
+ * @param node the node requested by the pin prefix, or PIN_NODE_AUTO to pick one.
+ *
+ * @return The index of the node in state->numa, or -1 if the requested node does not
+ * exist or holds no CPU the shell may run on.
+ *
+ * @details Automatic placement picks the node running the fewest pinned jobs, starting
+ * from the node after the previous placement, so concurrent background jobs rotate
+ * round-robin across the nodes while a node freed by a finished job is reused first.
+ */
+int numa_place(SHrimpState *state, int node) {
+    NumaTopology *numa = &state->numa;
+    if(!numa->loaded)
+        numa_load(numa);
+
+    if(node != PIN_NODE_AUTO) {
+        for(int i = 0; i < numa->node_amt; i++) {
+            if(numa->ids[i] == node)
+                return i;
+        }
+        fprintf(stderr, RED_TEXT "pin: node %d: no such NUMA node" RESET_COLOR "\n", node);
+        return -1;
+    }
+    if(numa->node_amt == 0)
+        return -1;
+
+    int best = -1, best_load = 0;
+    for(int offset = 0; offset < numa->node_amt; offset++) {
+        int i = (numa->next + offset) % numa->node_amt;
+        int load = 0;
+        for(int j = 0; j < state->jobs.job_amt; j++) {
+            Job *job = state->jobs.jobs[j];
+            load += job->node == numa->ids[i] && job->state != JOB_DONE;
+        }
+        if(best < 0 || load < best_load) {
+            best = i;
+            best_load = load;
+        }
+    }
+
+    numa->next = (best + 1) % numa->node_amt;
+    return best;
+}
+
+//======================================================================================
+
+/**
+ * @brief Releases the NUMA topology read by numa_place().
+ *
+ * @param numa NumaTopology object to release.
+ */
+void numa_free(NumaTopology *numa) {
+    free(numa->ids);
+    free(numa->cpus);
+    *numa = (NumaTopology){0};
+}
+
+//======================================================================================
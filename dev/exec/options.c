@@ -0,0 +1,459 @@
+/* options.c
+ *
+ * Contains the shell options of SHrimp and the set built-in command that changes them.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <unistd.h>        // pipe2(), close()
+#include <fcntl.h>         // fcntl(), open(), F_SETPIPE_SZ, F_GETFD, O_CLOEXEC
+#include <stdio.h>         // printf(), fprintf(), snprintf(), fopen(), fscanf(), fclose()
+#include <stdlib.h>        // strtol(), strtoull()
+#include <string.h>        // strcmp(), strchr(), strerror()
+#include <limits.h>        // INT_MAX
+#include <errno.h>         // errno
+#include "config/macros.h" // PIPE_MAX_SIZE_FILE, CGROUP_CPU_PERIOD, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // SHrimpState, JobTable, SpawnEngine
+#include "exec/spawn.h"    // spawn_engine_from_name(), spawn_engine_name()
+#include "exec/server.h"   // spawn_server_start(), spawn_server_stop()
+#include "exec/pipestat.h" // pipestat_parse_interval()
+#include "exec/cgroup.h"   // cgroup_open(), cgroup_limit()
+#include "exec/options.h"
+
+//======================================================================================
+
+/**
+ * @brief Parses a size such as 65536, 64K or 1M.
+ *
+ * @param text the size to parse. A K or M suffix multiplies it by 1024 or 1024 * 1024.
+ * @param size where the parsed size is stored.
+ *
+ * @return 0 on success, -1 if text is not a size or does not fit in an int.
+ */
+static int parse_size(const char *text, long *size) {
+    char *end;
+
+    errno = 0;
+    long value = strtol(text, &end, 10);
+    if(errno != 0 || end == text || value < 0)
+        return -1;
+
+    if(*end == 'K' || *end == 'k') {
+        value *= 1024;
+        end++;
+    } else if(*end == 'M' || *end == 'm') {
+        if(value > INT_MAX / (1024 * 1024))
+            return -1;
+        value *= 1024 * 1024;
+        end++;
+    }
+
+    if(*end != '\0' || value > INT_MAX)
+        return -1;
+
+    *size = value;
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Reads the largest pipe size an unprivileged process may request.
+ *
+ * @return The value of /proc/sys/fs/pipe-max-size, or -1 if it cannot be read.
+ */
+static long read_pipe_max_size(void) {
+    FILE *file = fopen(PIPE_MAX_SIZE_FILE, "re");
+    if(file == NULL)
+        return -1;
+
+    long max = -1;
+    if(fscanf(file, "%ld", &max) != 1)
+        max = -1;
+    fclose(file);
+
+    return max;
+}
+
+//======================================================================================
+
+/**
+ * @brief Sets the size applied to every pipe the shell creates.
+ *
+ * @param state SHrimpState object whose pipe_size is set.
+ * @param value the requested size, or "default" or 0 to keep the kernel's default size.
+ *
+ * @return 0 on success, 1 if the size is invalid or refused by the kernel.
+ *
+ * @details The size is applied once to a probe pipe so that invalid sizes are reported here
+ * instead of on every pipeline. Sizes above /proc/sys/fs/pipe-max-size are clamped to it and
+ * the kernel rounds every size up to a power of two pages, so the size actually stored is
+ * the one the probe pipe reports, and it is printed whenever it differs from the request.
+ */
+static int set_pipebuf(SHrimpState *state, const char *value) {
+    long size;
+
+    if(strcmp(value, "default") == 0) {
+        state->pipe_size = 0;
+        return 0;
+    }
+    if(parse_size(value, &size) < 0) {
+        fprintf(stderr, RED_TEXT "set: pipebuf: invalid size '%s'" RESET_COLOR "\n", value);
+        return 1;
+    }
+    if(size == 0) {
+        state->pipe_size = 0;
+        return 0;
+    }
+
+    long requested = size;
+    long max = read_pipe_max_size();
+    if(max > 0 && size > max)
+        size = max;
+
+    int probe[2];
+    if(pipe2(probe, O_CLOEXEC) < 0) {
+        fprintf(stderr, RED_TEXT "set: pipebuf: %s" RESET_COLOR "\n", strerror(errno));
+        return 1;
+    }
+
+    int effective = fcntl(probe[1], F_SETPIPE_SZ, (int)size);
+    int error = errno;
+    close(probe[0]);
+    close(probe[1]);
+
+    if(effective < 0) {
+        fprintf(stderr, RED_TEXT "set: pipebuf: %s: %s" RESET_COLOR "\n", value, strerror(error));
+        return 1;
+    }
+
+    if(effective != requested) {
+        if(size != requested)
+            fprintf(stderr, "set: pipebuf: %ld bytes exceeds %s, using %d bytes\n", requested, PIPE_MAX_SIZE_FILE, effective);
+        else
+            fprintf(stderr, "set: pipebuf: kernel rounded %ld bytes up to %d bytes\n", requested, effective);
+    }
+
+    state->pipe_size = effective;
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Sets the job log, which receives a one line record of every finished job.
+ *
+ * @param state SHrimpState object whose job log is set.
+ * @param value "off" to disable the job log, an fd number to write to an fd the shell
+ * inherited, e.g. set joblog=3 after starting SHrimp with 3>jobs.log, or the path of a file
+ * to append to.
+ *
+ * @return 0 on success, 1 if the fd is not open or the file cannot be opened.
+ */
+static int set_joblog(SHrimpState *state, const char *value) {
+    JobTable *table = &state->jobs;
+    int fd = -1, owned = 0;
+
+    if(strcmp(value, "off") != 0) {
+        char *end;
+        long number = strtol(value, &end, 10);
+        if(end != value && *end == '\0') {
+            if(number < 0 || number > INT_MAX || fcntl((int)number, F_GETFD) < 0) {
+                fprintf(stderr, RED_TEXT "set: joblog: %s: bad file descriptor" RESET_COLOR "\n", value);
+                return 1;
+            }
+            fd = (int)number;
+        } else {
+            fd = open(value, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0666);
+            if(fd < 0) {
+                fprintf(stderr, RED_TEXT "set: joblog: %s: %s" RESET_COLOR "\n", value, strerror(errno));
+                return 1;
+            }
+            owned = 1;
+        }
+    }
+
+    if(table->log_owned)
+        close(table->log_fd);
+    table->log_fd = fd;
+    table->log_owned = owned;
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Sets the most pipelines of a &| group that run at once.
+ *
+ * @param state SHrimpState object whose parallel_limit is set.
+ * @param value the limit, or "unlimited" or 0 to launch every pipeline of a group at once.
+ *
+ * @return 0 on success, 1 if the limit is not a number.
+ */
+static int set_parallel(SHrimpState *state, const char *value) {
+    if(strcmp(value, "unlimited") == 0) {
+        state->parallel_limit = 0;
+        return 0;
+    }
+
+    char *end;
+    errno = 0;
+    long limit = strtol(value, &end, 10);
+    if(errno != 0 || end == value || *end != '\0' || limit < 0 || limit > INT_MAX) {
+        fprintf(stderr, RED_TEXT "set: parallel: invalid limit '%s'" RESET_COLOR "\n", value);
+        return 1;
+    }
+
+    state->parallel_limit = (int)limit;
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Sets whether a pipeline fails when any of its stages fails.
+ *
+ * @param state SHrimpState object whose pipefail is set.
+ * @param value "on" for the status of a pipeline to be that of its last failing stage, or
+ * "off" for it to be that of its last stage.
+ *
+ * @return 0 on success, 1 if the value is neither.
+ *
+ * @details The option applies to pipelines launched after it is set, so a background job
+ * keeps the setting it was launched with.
+ */
+static int set_pipefail(SHrimpState *state, const char *value) {
+    if(strcmp(value, "on") != 0 && strcmp(value, "off") != 0) {
+        fprintf(stderr, RED_TEXT "set: pipefail: expected on or off, not '%s'" RESET_COLOR "\n", value);
+        return 1;
+    }
+
+    state->pipefail = strcmp(value, "on") == 0;
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Sets how often the pipes of a foreground pipeline are reported while it runs.
+ *
+ * @param state SHrimpState object whose pipestat_ms is set.
+ * @param value the seconds between reports, e.g. 0.5, or "off" or 0 to disable them.
+ *
+ * @return 0 on success, 1 if the interval is invalid.
+ */
+static int set_pipestat(SHrimpState *state, const char *value) {
+    if(strcmp(value, "off") == 0 || strcmp(value, "0") == 0) {
+        state->pipestat_ms = 0;
+        return 0;
+    }
+
+    int ms;
+    if(pipestat_parse_interval(value, &ms) < 0) {
+        fprintf(stderr, RED_TEXT "set: pipestat: invalid interval '%s'" RESET_COLOR "\n", value);
+        return 1;
+    }
+
+    state->pipestat_ms = ms;
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Limits the CPU time of the cgroup background pipelines run in.
+ *
+ * @param state SHrimpState object holding the cgroup.
+ * @param value the share of a single CPU the cgroup may use, e.g. 50 or 200 for two CPUs,
+ * or "max" to remove the limit.
+ *
+ * @return 0 on success, 1 if the percentage is invalid or the limit is refused.
+ *
+ * @details The percentage is written to cpu.max as a quota of CGROUP_CPU_PERIOD microseconds.
+ */
+static int set_cgroup_cpu(SHrimpState *state, const char *value) {
+    char limit[64];
+
+    if(strcmp(value, "max") == 0)
+        return cgroup_limit(state, "cgroup_cpu", "cpu", "cpu.max", "max");
+
+    char *end;
+    errno = 0;
+    long percent = strtol(value, &end, 10);
+    if(errno != 0 || end == value || *end != '\0' || percent <= 0 || percent > 100000) {
+        fprintf(stderr, RED_TEXT "set: cgroup_cpu: invalid percentage '%s'" RESET_COLOR "\n", value);
+        return 1;
+    }
+
+    snprintf(limit, sizeof(limit), "%ld %d", percent * CGROUP_CPU_PERIOD / 100, CGROUP_CPU_PERIOD);
+    return cgroup_limit(state, "cgroup_cpu", "cpu", "cpu.max", limit);
+}
+
+//======================================================================================
+
+/**
+ * @brief Limits the memory of the cgroup background pipelines run in.
+ *
+ * @param state SHrimpState object holding the cgroup.
+ * @param value the limit in bytes, which a K, M or G suffix multiplies by a power of 1024,
+ * e.g. 512M, or "max" to remove the limit.
+ *
+ * @return 0 on success, 1 if the size is invalid or the limit is refused.
+ *
+ * @details Unlike the pipe sizes of parse_size(), memory limits routinely exceed an int, so
+ * the size is parsed as an unsigned long long here.
+ */
+static int set_cgroup_memory(SHrimpState *state, const char *value) {
+    char limit[64];
+
+    if(strcmp(value, "max") == 0)
+        return cgroup_limit(state, "cgroup_memory", "memory", "memory.max", "max");
+
+    char *end;
+    errno = 0;
+    unsigned long long size = strtoull(value, &end, 10);
+    int shift = 0;
+    if(*end == 'K' || *end == 'k')
+        shift = 10;
+    else if(*end == 'M' || *end == 'm')
+        shift = 20;
+    else if(*end == 'G' || *end == 'g')
+        shift = 30;
+    if(shift > 0)
+        end++;
+
+    if(errno != 0 || end == value || value[0] == '-' || *end != '\0' || size == 0 || size > (~0ULL >> shift)) {
+        fprintf(stderr, RED_TEXT "set: cgroup_memory: invalid size '%s'" RESET_COLOR "\n", value);
+        return 1;
+    }
+
+    snprintf(limit, sizeof(limit), "%llu", size << shift);
+    return cgroup_limit(state, "cgroup_memory", "memory", "memory.max", limit);
+}
+
+//======================================================================================
+
+/**
+ * @brief Sets a single shell option.
+ *
+ * @param state SHrimpState object holding the shell options.
+ * @param name the name of the option, either "cgroup", "cgroup_cpu", "cgroup_memory", "joblog",
+ * "parallel", "pipebuf", "pipefail", "pipestat" or "spawn".
+ * @param value the new value of the option.
+ *
+ * @return 0 on success, 1 if name is not an option or value is invalid for it.
+ */
+int set_option(SHrimpState *state, const char *name, const char *value) {
+    if(strcmp(name, "cgroup") == 0)
+        return cgroup_open(state, value);
+
+    if(strcmp(name, "cgroup_cpu") == 0)
+        return set_cgroup_cpu(state, value);
+
+    if(strcmp(name, "cgroup_memory") == 0)
+        return set_cgroup_memory(state, value);
+
+    if(strcmp(name, "joblog") == 0)
+        return set_joblog(state, value);
+
+    if(strcmp(name, "parallel") == 0)
+        return set_parallel(state, value);
+
+    if(strcmp(name, "pipebuf") == 0)
+        return set_pipebuf(state, value);
+
+    if(strcmp(name, "pipefail") == 0)
+        return set_pipefail(state, value);
+
+    if(strcmp(name, "pipestat") == 0)
+        return set_pipestat(state, value);
+
+    if(strcmp(name, "spawn") == 0) {
+        SpawnEngine engine = spawn_engine_from_name(value);
+        if(engine == SPAWN_INVALID) {
+            fprintf(stderr, RED_TEXT "set: spawn: unknown spawn engine '%s'" RESET_COLOR "\n", value);
+            return 1;
+        }
+
+        // The spawn server only runs while it is the selected engine
+        if(engine == SPAWN_SERVER && spawn_server_start(state) < 0)
+            return 1;
+        if(engine != SPAWN_SERVER)
+            spawn_server_stop(state);
+        state->spawn_engine = engine;
+        return 0;
+    }
+
+    fprintf(stderr, RED_TEXT "set: %s: unknown option" RESET_COLOR "\n", name);
+    return 1;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command set, which lists or changes the shell options.
+ *
+ * @param args 2D char array containing the command and all its arguments. With no arguments
+ * every option is printed, otherwise each argument has the form name=value.
+ * @param state SHrimpState object holding the shell options.
+ *
+ * @return 0 if every option was set, 1 if any argument was invalid.
+ */
+int set_builtin(char **args, SHrimpState *state) {
+    if(args[1] == NULL) {
+        printf("cgroup=%s\n", state->cgroup_path != NULL ? state->cgroup_path : "off");
+        if(state->jobs.log_fd >= 0)
+            printf("joblog=%d\n", state->jobs.log_fd);
+        else
+            printf("joblog=off\n");
+        if(state->parallel_limit > 0)
+            printf("parallel=%d\n", state->parallel_limit);
+        else
+            printf("parallel=unlimited\n");
+        if(state->pipe_size > 0)
+            printf("pipebuf=%d\n", state->pipe_size);
+        else
+            printf("pipebuf=default\n");
+        printf("pipefail=%s\n", state->pipefail ? "on" : "off");
+        if(state->pipestat_ms > 0)
+            printf("pipestat=%g\n", state->pipestat_ms / 1000.0);
+        else
+            printf("pipestat=off\n");
+        printf("spawn=%s\n", spawn_engine_name(state->spawn_engine));
+        return 0;
+    }
+
+    int status = 0;
+    for(int i = 1; args[i] != NULL; i++) {
+        char *equals = strchr(args[i], '=');
+        if(equals == NULL) {
+            fprintf(stderr, RED_TEXT "set: %s: expected name=value" RESET_COLOR "\n", args[i]);
+            status = 1;
+            continue;
+        }
+
+        // Split the argument in place and restore it once the option is set
+        *equals = '\0';
+        status |= set_option(state, args[i], equals + 1);
+        *equals = '=';
+    }
+
+    return status;
+}
+
+//======================================================================================
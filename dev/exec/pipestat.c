@@ -0,0 +1,340 @@
+/* pipestat.c
+ *
+ * Contains the pipe monitor of SHrimp, which samples the throughput of every stage of a
+ * pipeline and how full each pipe between them is, along with the built-in command pstat.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/types.h>     // pid_t
+#include <sys/stat.h>      // stat(), S_ISFIFO()
+#include <sys/ioctl.h>     // ioctl(), FIONREAD
+#include <fcntl.h>         // open(), fcntl(), F_GETPIPE_SZ, O_RDONLY, O_NONBLOCK
+#include <unistd.h>        // close()
+#include <time.h>          // clock_gettime(), nanosleep()
+#include <stdio.h>         // fprintf(), snprintf(), fopen(), fgets(), sscanf(), fclose()
+#include <stdlib.h>        // strtod(), free()
+#include <string.h>        // strcmp()
+#include <errno.h>         // errno, EINTR
+#include "config/macros.h" // PIPESTAT_FULL_PERCENT, PIPESTAT_DEFAULT_MS, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // Job, PipeSample, SHrimpState
+#include "utils/utils.h"   // safe_malloc()
+#include "exec/accounting.h" // timespec_elapsed()
+#include "exec/jobs.h"     // jobs_reap(), job_find()
+#include "exec/pipestat.h"
+
+//======================================================================================
+
+/**
+ * @brief Reads how many bytes a process has read and written so far.
+ *
+ * @param pid the process to read the counters of.
+ * @param sample PipeSample object whose rchar and wchar are set.
+ *
+ * @return 0 on success, -1 if the process is gone.
+ *
+ * @details rchar and wchar count every byte passed to read() and write() like calls, so for
+ * a stage between two pipes they are the bytes that went through its pipes.
+ */
+static int read_io(pid_t pid, PipeSample *sample) {
+    char path[64], line[128];
+    snprintf(path, sizeof(path), "/proc/%d/io", (int)pid);
+
+    FILE *file = fopen(path, "re");
+    if(file == NULL)
+        return -1;
+
+    int found = 0;
+    while(fgets(line, sizeof(line), file) != NULL) {
+        if(sscanf(line, "rchar: %llu", &sample->rchar) == 1 || sscanf(line, "wchar: %llu", &sample->wchar) == 1)
+            found++;
+    }
+    fclose(file);
+
+    return found == 2 ? 0 : -1;
+}
+
+//======================================================================================
+
+/**
+ * @brief Reads how full the pipe a process writes to is.
+ *
+ * @param pid the process whose stdout is checked.
+ * @param sample PipeSample object whose queued and pipe_size are set, or queued is set to
+ * -1 if the stdout of the process is not a pipe.
+ *
+ * @details The shell closes its own ends of every pipe once a stage is launched, so the pipe
+ * is briefly reopened through /proc/<pid>/fd/1 instead. Keeping an end open for the whole
+ * job would stop the stages from ever seeing EOF or EPIPE. The reopened end is never read
+ * from, and the stage's stdout is only opened once stat() shows it is a pipe, so a terminal
+ * or file is never touched.
+ */
+static void read_pipe(pid_t pid, PipeSample *sample) {
+    char path[64];
+    struct stat sb;
+
+    sample->queued = -1;
+    snprintf(path, sizeof(path), "/proc/%d/fd/1", (int)pid);
+    if(stat(path, &sb) < 0 || S_ISFIFO(sb.st_mode) == 0)
+        return;
+
+    int fd = open(path, O_RDONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC);
+    if(fd < 0)
+        return;
+
+    int queued, size = fcntl(fd, F_GETPIPE_SZ);
+    if(size > 0 && ioctl(fd, FIONREAD, &queued) == 0) {
+        sample->queued = queued;
+        sample->pipe_size = size;
+    }
+    close(fd);
+}
+
+//======================================================================================
+
+/**
+ * @brief Samples every stage of a job.
+ *
+ * @param job the Job to sample.
+ * @param samples where the sample of every stage is stored, one per process of the job.
+ */
+static void pipestat_sample(const Job *job, PipeSample *samples) {
+    for(int i = 0; i < job->proc_amt; i++) {
+        PipeSample *sample = &samples[i];
+        *sample = (PipeSample){ .queued = -1 };
+
+        if(job->pids[i] < 0 || read_io(job->pids[i], sample) < 0)
+            continue;
+        sample->valid = 1;
+
+        // The stdout of the last stage is not a pipe of the job, even when it is a pipe
+        if(i < job->proc_amt - 1)
+            read_pipe(job->pids[i], sample);
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Formats a rate in bytes per second with a K, M or G suffix.
+ *
+ * @param buf where the rate is written.
+ * @param size the size of buf.
+ * @param rate the rate in bytes per second, negative if unknown.
+ */
+static void format_rate(char *buf, size_t size, double rate) {
+    const char *suffixes = "BKMG";
+    int i = 0;
+
+    if(rate < 0) {
+        snprintf(buf, size, "-");
+        return;
+    }
+    while(rate >= 1024 && i < 3) {
+        rate /= 1024;
+        i++;
+    }
+
+    if(i == 0)
+        snprintf(buf, size, "%.0fB/s", rate);
+    else
+        snprintf(buf, size, "%.1f%c/s", rate, suffixes[i]);
+}
+
+//======================================================================================
+
+/**
+ * @brief Prints the throughput of every stage of a job and how full its pipes are.
+ *
+ * @param job the Job to report.
+ * @param prev the earlier sample of every stage, or NULL to measure from the launch of
+ * the job.
+ * @param cur the later sample of every stage.
+ * @param seconds the time between both samples.
+ * @param out where the report is printed.
+ *
+ * @details A pipe stays full when the stage reading it cannot keep up, so the bottleneck is
+ * the first stage after a full pipe whose own output pipe is not full, as every full pipe
+ * before it is only backed up behind it.
+ */
+static void pipestat_print(const Job *job, const PipeSample *prev, const PipeSample *cur, double seconds, FILE *out) {
+    int bottleneck = -1, backed_up = 0;
+
+    fprintf(out, "[%d] %s\n", job->id, job->cmdline);
+    fprintf(out, "%5s %8s %10s %10s %11s  %s\n", "stage", "pid", "read/s", "write/s", "pipe", "command");
+
+    for(int i = 0; i < job->proc_amt; i++) {
+        char read_rate[32], write_rate[32], pipe[32];
+        double rchar = -1, wchar = -1;
+
+        if(cur[i].valid && (prev == NULL || prev[i].valid) && seconds > 0) {
+            rchar = (double)(cur[i].rchar - (prev != NULL ? prev[i].rchar : 0)) / seconds;
+            wchar = (double)(cur[i].wchar - (prev != NULL ? prev[i].wchar : 0)) / seconds;
+        }
+        format_rate(read_rate, sizeof(read_rate), rchar);
+        format_rate(write_rate, sizeof(write_rate), wchar);
+
+        int full = 0;
+        if(cur[i].valid && cur[i].queued >= 0) {
+            int percent = (int)((long long)cur[i].queued * 100 / cur[i].pipe_size);
+            full = percent >= PIPESTAT_FULL_PERCENT;
+            snprintf(pipe, sizeof(pipe), "%dK %3d%%", cur[i].pipe_size / 1024, percent);
+        } else {
+            snprintf(pipe, sizeof(pipe), "-");
+        }
+
+        if(backed_up && full == 0 && bottleneck < 0)
+            bottleneck = i;
+        backed_up |= full;
+
+        fprintf(out, "%5d %8d %10s %10s %11s  %s\n", i + 1, (int)job->pids[i], read_rate, write_rate, pipe, job->stages[i]);
+    }
+
+    if(bottleneck >= 0)
+        fprintf(out, "bottleneck: stage %d (%s)\n", bottleneck + 1, job->stages[bottleneck]);
+}
+
+//======================================================================================
+
+/**
+ * @brief Reports the pipes of a running foreground job, as requested by set pipestat.
+ *
+ * @param job the Job to report, which must have more than one stage.
+ * @param out where the report is printed.
+ *
+ * @details Every report covers the time since the previous one, or since the job was
+ * launched for the first report, so rates are never averaged over the whole job.
+ */
+void pipestat_report(Job *job, FILE *out) {
+    PipeSample *samples = safe_malloc(job->proc_amt * sizeof(PipeSample), "pipestat: samples");
+    struct timespec now;
+
+    pipestat_sample(job, samples);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    const struct timespec *since = job->samples != NULL ? &job->sampled : &job->started;
+    pipestat_print(job, job->samples, samples, timespec_elapsed(since, &now), out);
+    fflush(out);
+
+    free(job->samples);
+    job->samples = samples;
+    job->sampled = now;
+}
+
+//======================================================================================
+
+/**
+ * @brief Parses an interval in seconds, such as 1 or 0.5.
+ *
+ * @param text the interval to parse.
+ * @param ms where the interval is stored in milliseconds.
+ *
+ * @return 0 on success, -1 if text is not a positive amount of seconds.
+ */
+int pipestat_parse_interval(const char *text, int *ms) {
+    char *end;
+
+    errno = 0;
+    double seconds = strtod(text, &end);
+    if(errno != 0 || end == text || *end != '\0' || seconds * 1000 < 1 || seconds > 86400)
+        return -1;
+
+    *ms = (int)(seconds * 1000);
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command pstat, which reports the pipes of running jobs.
+ *
+ * @param args 2D char array containing the command and all its arguments. -i sets the
+ * seconds between both samples, 1 by default, and job specs limit the report to the given
+ * jobs.
+ * @param state SHrimpState object holding the job table.
+ *
+ * @return 0 on success, 1 if a job spec or option is invalid.
+ *
+ * @details Every job is sampled once, then again after the interval, so each row shows the
+ * rates over that interval along with how full each pipe is at its end.
+ */
+int pstat_builtin(char **args, SHrimpState *state) {
+    JobTable *table = &state->jobs;
+    int ms = PIPESTAT_DEFAULT_MS, status = 0;
+    int i = 1;
+
+    jobs_reap(state);
+
+    if(args[i] != NULL && strcmp(args[i], "-i") == 0) {
+        if(args[i + 1] == NULL || pipestat_parse_interval(args[i + 1], &ms) < 0) {
+            fprintf(stderr, RED_TEXT "pstat: -i: invalid interval '%s'" RESET_COLOR "\n", args[i + 1] != NULL ? args[i + 1] : "");
+            return 1;
+        }
+        i += 2;
+    }
+    if(args[i] != NULL && args[i][0] == '-') {
+        fprintf(stderr, RED_TEXT "pstat: %s: invalid option" RESET_COLOR "\n", args[i]);
+        return 1;
+    }
+
+    // Pick the running jobs to report, every one if no job specs are given
+    int amt = table->job_amt;
+    Job *listed[amt > 0 ? amt : 1];
+    int listed_amt = 0;
+    if(args[i] == NULL) {
+        for(int j = 0; j < amt; j++) {
+            if(table->jobs[j]->state == JOB_RUNNING)
+                listed[listed_amt++] = table->jobs[j];
+        }
+    }
+    for(; args[i] != NULL; i++) {
+        Job *job = job_find(state, args[i]);
+        if(job == NULL) {
+            fprintf(stderr, RED_TEXT "pstat: %s: no such job" RESET_COLOR "\n", args[i]);
+            status = 1;
+        } else if(job->state == JOB_RUNNING && listed_amt < amt) {
+            listed[listed_amt++] = job;
+        }
+    }
+    if(listed_amt == 0)
+        return status;
+
+    PipeSample *before[listed_amt], *after[listed_amt];
+    for(int j = 0; j < listed_amt; j++) {
+        before[j] = safe_malloc(listed[j]->proc_amt * sizeof(PipeSample), "pstat: samples");
+        after[j] = safe_malloc(listed[j]->proc_amt * sizeof(PipeSample), "pstat: samples");
+        pipestat_sample(listed[j], before[j]);
+    }
+
+    struct timespec start, end, delay = { ms / 1000, (ms % 1000) * 1000000L };
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while(nanosleep(&delay, &delay) < 0 && errno == EINTR)
+        continue;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    for(int j = 0; j < listed_amt; j++) {
+        pipestat_sample(listed[j], after[j]);
+        pipestat_print(listed[j], before[j], after[j], timespec_elapsed(&start, &end), stdout);
+        free(before[j]);
+        free(after[j]);
+    }
+
+    return status;
+}
+
+//======================================================================================
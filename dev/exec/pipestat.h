@@ -0,0 +1,33 @@
+/* pipestat.h
+ *
+ * Header file for pipestat.c
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef PIPESTAT_H
+#define PIPESTAT_H
+
+#include <stdio.h>       // FILE
+#include "types/types.h"
+
+void pipestat_report(Job *job, FILE *out);
+int pipestat_parse_interval(const char *text, int *ms);
+int pstat_builtin(char **args, SHrimpState *state);
+
+#endif
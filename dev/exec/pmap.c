@@ -0,0 +1,309 @@
+/* pmap.c
+ *
+ * Contains the built-in command pmap of SHrimp, which runs a command once per line of input
+ * with a bounded amount of them running at once.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/types.h>     // ssize_t, pid_t
+#include <sys/mman.h>      // memfd_create(), MFD_CLOEXEC
+#include <unistd.h>        // sysconf(), lseek(), close()
+#include <fcntl.h>         // open(), fcntl(), O_RDONLY, O_CLOEXEC, F_DUPFD_CLOEXEC
+#include <stdio.h>         // fprintf(), fdopen(), fclose(), getline(), stderr
+#include <stdlib.h>        // strtol(), free()
+#include <string.h>        // strcmp(), strstr(), strlen(), strcpy(), memcpy(), memmove(), strerror()
+#include <signal.h>        // SIGINT, SIGQUIT
+#include <errno.h>         // errno
+#include "config/macros.h" // ARENA_BLOCK_SIZE, BUILTIN_SPECIAL, PMAP_MAX_JOBS, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // SHrimpState, SHrimpCommand, Pipeline, Job, Builtin, Arena
+#include "utils/arena.h"   // arena_init(), arena_alloc(), arena_reset(), arena_free()
+#include "utils/copy.h"    // fd_copy()
+#include "utils/utils.h"   // safe_malloc()
+#include "exec/builtins.h" // find_command_builtin()
+#include "exec/exec.h"     // exec_launch()
+#include "exec/jobs.h"     // job_wait_any(), job_collect(), jobs_take_terminal()
+#include "exec/pmap.h"
+
+//======================================================================================
+
+/**
+ * @brief Replaces every {} within an arg of the command template with the item.
+ *
+ * @param arg the arg of the template.
+ * @param item the item to substitute.
+ * @param arena Arena object owning the substituted arg.
+ *
+ * @return arg itself if it holds no {}, otherwise the substituted copy of it.
+ */
+static char *substitute(char *arg, const char *item, Arena *arena) {
+    char *hole = strstr(arg, "{}");
+    if(hole == NULL)
+        return arg;
+
+    size_t holes = 0;
+    for(char *p = hole; p != NULL; p = strstr(p + 2, "{}"))
+        holes++;
+
+    size_t item_len = strlen(item);
+    char *copy = arena_alloc(arena, strlen(arg) - holes * 2 + holes * item_len + 1);
+    char *out = copy;
+    while(hole != NULL) {
+        memcpy(out, arg, hole - arg);
+        out += hole - arg;
+        memcpy(out, item, item_len);
+        out += item_len;
+        arg = hole + 2;
+        hole = strstr(arg, "{}");
+    }
+    strcpy(out, arg);
+
+    return copy;
+}
+
+//======================================================================================
+
+/**
+ * @brief Launches the command template for a single item as a job of its own.
+ *
+ * @param template the command and args to run, where {} is replaced by the item. If no arg
+ * holds {}, the item is appended as the last arg instead.
+ * @param builtin the built-in command template[0] names, NULL if it is an executable.
+ * @param item the item to run the template for.
+ * @param arena Arena object owning the args of the command, reset once it is launched.
+ * @param state SHrimpState object holding the job table.
+ * @param pgid process group the job joins with job control, 0 to start a new one.
+ * @param out_fd fd to use as the command's stdout, -1 to inherit pmap's.
+ *
+ * @return The launched Job.
+ *
+ * @details The command reads from /dev/null rather than competing with pmap for its input.
+ * Every string of the command is copied into the job table, so the arena can be reset as
+ * soon as the command is launched.
+ */
+static Job *pmap_launch(char **template, const Builtin *builtin, const char *item, Arena *arena, SHrimpState *state, pid_t pgid, int out_fd) {
+    int template_amt = 0, substituted = 0;
+    while(template[template_amt] != NULL)
+        template_amt++;
+
+    SHrimpCommand cmd = {0};
+    cmd.args = arena_alloc(arena, (template_amt + 2) * sizeof(char *));
+    for(int i = 0; i < template_amt; i++) {
+        cmd.args[i] = substitute(template[i], item, arena);
+        substituted |= cmd.args[i] != template[i];
+    }
+    cmd.arg_amt = template_amt;
+    if(!substituted)
+        cmd.args[cmd.arg_amt++] = (char *)item;
+    cmd.args[cmd.arg_amt] = NULL;
+    cmd.builtin = builtin;
+    cmd.input_redirect = 1;
+    cmd.infile = "/dev/null";
+
+    SHrimpCommand *commands[] = { &cmd };
+    Pipeline pipeline = {0};
+    pipeline.commands = commands;
+    pipeline.command_amt = 1;
+    pipeline.has_builtin = builtin != NULL;
+    pipeline.has_redirect = 1;
+
+    Job *job = exec_launch(&pipeline, state, pgid, 1, out_fd);
+    arena_reset(arena);
+
+    return job;
+}
+
+//======================================================================================
+
+/**
+ * @brief Copies the grouped output of a finished job to stdout and closes it.
+ *
+ * @param fd the memfd the job wrote its output to.
+ *
+ * @details fd_copy() moves the output without it passing through the shell whenever the
+ * kernel allows it.
+ */
+static void pmap_flush(int fd) {
+    lseek(fd, 0, SEEK_SET);
+    fd_copy(fd, STDOUT_FILENO, NULL);
+    close(fd);
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command pmap, which runs a command template once for every
+ * line of its input, e.g. "ls logs | pmap -j 8 gzip -9 logs/{}".
+ *
+ * @param args 2D char array containing the command and all its arguments. Options are
+ * -j N to run at most N commands at once, by default one per online CPU and never more
+ * than PMAP_MAX_JOBS, -a FILE to read items from FILE instead of stdin, and -g to group the
+ * output of each command so lines of different commands never interleave. The rest of args
+ * is the command template.
+ * @param state SHrimpState object holding the job table.
+ *
+ * @return 0 if the command succeeded for every item, otherwise the status of the first
+ * failing item in input order. 1 if the arguments are invalid or the input cannot be read,
+ * or 128 plus the signal number if the commands were stopped.
+ *
+ * @details Every item becomes a job of its own, launched with the selected spawn engine,
+ * so pmap never starts an interpreter of its own. Whenever a job finishes, which is learned
+ * by blocking in wait4() rather than polling, the next item takes its slot. With -g the
+ * stdout of each job is a memfd that is copied to pmap's stdout once the job finished, so
+ * grouped output appears in the order the jobs finish. Empty lines are skipped. With job
+ * control the running jobs share a single process group holding the terminal, as a &|
+ * group does.
+ */
+int pmap_builtin(char **args, SHrimpState *state) {
+    long limit = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *file = NULL;
+    int group = 0, i = 1;
+
+    for(; args[i] != NULL && args[i][0] == '-'; i++) {
+        if(strcmp(args[i], "--") == 0) {
+            i++;
+            break;
+        } else if(strcmp(args[i], "-g") == 0) {
+            group = 1;
+        } else if(strcmp(args[i], "-a") == 0 && args[i + 1] != NULL) {
+            file = args[++i];
+        } else if(strcmp(args[i], "-j") == 0 && args[i + 1] != NULL) {
+            char *end;
+            limit = strtol(args[++i], &end, 10);
+            if(end == args[i] || *end != '\0' || limit < 1 || limit > PMAP_MAX_JOBS) {
+                fprintf(stderr, RED_TEXT "pmap: -j: invalid limit '%s'" RESET_COLOR "\n", args[i]);
+                return 1;
+            }
+        } else {
+            fprintf(stderr, RED_TEXT "pmap: %s: invalid option" RESET_COLOR "\n", args[i]);
+            fprintf(stderr, "Usage: pmap [-g] [-j N] [-a FILE] command [arg...]\n");
+            return 1;
+        }
+    }
+    if(args[i] == NULL) {
+        fprintf(stderr, "Usage: pmap [-g] [-j N] [-a FILE] command [arg...]\n");
+        return 1;
+    }
+    if(limit < 1)
+        limit = 1;
+    else if(limit > PMAP_MAX_JOBS)
+        limit = PMAP_MAX_JOBS;
+
+    char **template = &args[i];
+    const Builtin *builtin = find_command_builtin(template);
+    if(builtin != NULL && (builtin->flags & BUILTIN_SPECIAL)) {
+        fprintf(stderr, RED_TEXT "pmap: the built-in command %s cannot be run by pmap" RESET_COLOR "\n", builtin->name);
+        return 1;
+    }
+
+    // Items are read through a stream of pmap's own, so no input the shell buffered in
+    // stdin is mistaken for an item
+    int in_fd = file != NULL ? open(file, O_RDONLY | O_CLOEXEC) : fcntl(STDIN_FILENO, F_DUPFD_CLOEXEC, 0);
+    FILE *in = in_fd >= 0 ? fdopen(in_fd, "r") : NULL;
+    if(in == NULL) {
+        fprintf(stderr, RED_TEXT "pmap: %s: %s" RESET_COLOR "\n", file != NULL ? file : "stdin", strerror(errno));
+        if(in_fd >= 0)
+            close(in_fd);
+        return 1;
+    }
+
+    Job **running = safe_malloc(limit * sizeof(Job *), "pmap: running");
+    long *positions = safe_malloc(limit * sizeof(long), "pmap: positions");
+    int *outputs = safe_malloc(limit * sizeof(int), "pmap: outputs");
+    int running_amt = 0, stopped = 0, status = 0, eof = 0;
+    long launched = 0, failed_at = -1;
+    pid_t pgid = 0;
+    char *line = NULL;
+    size_t line_size = 0;
+    Arena arena;
+    arena_init(&arena, ARENA_BLOCK_SIZE);
+
+    while(!stopped && (!eof || running_amt > 0)) {
+        // Fill every free slot with the next item
+        while(!eof && running_amt < limit) {
+            ssize_t len = getline(&line, &line_size, in);
+            if(len < 0) {
+                eof = 1;
+                break;
+            }
+            if(len > 0 && line[len - 1] == '\n')
+                line[--len] = '\0';
+            if(len == 0)
+                continue;
+
+            int out_fd = -1;
+            if(group && (out_fd = memfd_create("pmap", MFD_CLOEXEC)) < 0)
+                fprintf(stderr, RED_TEXT "pmap: %s, not grouping output" RESET_COLOR "\n", strerror(errno));
+
+            // A process group only exists while one of its processes does
+            int live = 0;
+            for(int j = 0; j < running_amt; j++)
+                live += running[j]->live;
+            if(live == 0)
+                pgid = 0;
+
+            running[running_amt] = pmap_launch(template, builtin, line, &arena, state, pgid, out_fd);
+            if(running[running_amt]->pgid > 0)
+                pgid = running[running_amt]->pgid;
+            positions[running_amt] = launched++;
+            outputs[running_amt++] = out_fd;
+        }
+        if(running_amt == 0)
+            break;
+
+        int done = job_wait_any(state, running, running_amt);
+        Job *job = running[done];
+        stopped = job->state == JOB_STOPPED;
+        int job_status = job_collect(state, job);
+        if(outputs[done] >= 0)
+            pmap_flush(outputs[done]);
+
+        // Commands interrupted by Ctrl-C or Ctrl-\ interrupt pmap as well
+        if(job_status == 128 + SIGINT || job_status == 128 + SIGQUIT)
+            eof = 1;
+
+        if(stopped) {
+            status = job_status;
+        } else if(job_status != 0 && (failed_at < 0 || positions[done] < failed_at)) {
+            failed_at = positions[done];
+            status = job_status;
+        }
+
+        running_amt--;
+        memmove(&running[done], &running[done + 1], (running_amt - done) * sizeof(Job *));
+        memmove(&positions[done], &positions[done + 1], (running_amt - done) * sizeof(long));
+        memmove(&outputs[done], &outputs[done + 1], (running_amt - done) * sizeof(int));
+    }
+    jobs_take_terminal(state);
+
+    // A stopped pmap leaves its jobs in the job table, but their grouped output is discarded
+    for(int j = 0; j < running_amt; j++) {
+        if(outputs[j] >= 0)
+            close(outputs[j]);
+    }
+    free(running);
+    free(positions);
+    free(outputs);
+    free(line);
+    arena_free(&arena);
+    fclose(in);
+
+    return status;
+}
+
+//======================================================================================
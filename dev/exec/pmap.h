@@ -1,6 +1,6 @@
-/* pipe.h
+/* pmap.h
  *
- * Header file for pipe.c
+ * Header file for pmap.c
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -16,15 +16,15 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  *
  * Author: Ryan McHenry
- * Created: January 23, 2026
- * Last Modified: February 10, 2026
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
  */
 
-#ifndef PIPE_H
-#define PIPE_H
+#ifndef PMAP_H
+#define PMAP_H
 
 #include "types/types.h"
 
-ParseCode check_piping(SHrimpCommand *cmd, Pipeline *pipeline);
+int pmap_builtin(char **args, SHrimpState *state);
 
-#endif
\ No newline at end of file
+#endif
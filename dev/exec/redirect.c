@@ -17,49 +17,57 @@
  *
  * Author: Ryan McHenry
  * Created: January 23, 2026
- * Last Modified: February 10, 2026
+ * Last Modified: October 14, 2026
  */
 
-#include <string.h>        // strcmp()
-#include <unistd.h>        // STDIN_FILENO, STDOUT_FILENO, close(), dup2()
-#include <fcntl.h>         // O_RDONLY, O_CREAT, O_WRONLY, O_TRUNC, O_APPEND, open()
-#include "types/types.h"   // SHrimpCommand, DelayedCommand
+#include <string.h>        // strerror()
+#include <sys/mman.h>      // memfd_create(), MFD_CLOEXEC
+#include <unistd.h>        // STDIN_FILENO, STDOUT_FILENO, close(), dup2(), pipe2(), write(), lseek()
+#include <fcntl.h>         // O_RDONLY, O_CREAT, O_WRONLY, O_TRUNC, O_APPEND, O_CLOEXEC, open(), fcntl(), F_GETPIPE_SZ
+#include <errno.h>         // errno
+#include <stdio.h>         // fprintf()
+#include "config/macros.h" // RED_TEXT, RESET_COLOR
+#include "types/types.h"   // SHrimpCommand
 #include "exec/redirect.h"
 
 //======================================================================================
 
 /**
- * @brief Parses args within the command pipeline to check for the redirection
- * tokens <, >, or >>.
+ * @brief Opens a redirection file, reporting it by name if it cannot be opened.
  *
- * @param pipeline Pipeline object to check redirection for.
+ * @param path the file to open.
+ * @param flags the flags to open the file with.
+ *
+ * @return The file descriptor of the file, or -1 if it could not be opened.
  */
-void check_redirection(Pipeline *pipeline) {
-    // O(n^2), should probably be streamlined in the future if possible
-    for(int i = 0; i < pipeline->command_amt; i++) {
-        for(int j = 0; pipeline->commands[i]->args[j] != NULL; j++) {
-            // Redirect input token found
-            if(strcmp(pipeline->commands[i]->args[j], "<") == 0) {
-                pipeline->commands[i]->input_redirect = 1;
-                pipeline->commands[i]->index = j;
-                pipeline->has_redirect = 1; // true
-            }
-
-            // Redirect output token found
-            if(strcmp(pipeline->commands[i]->args[j], ">") == 0) {
-                pipeline->commands[i]->output_redirect = 1;
-                pipeline->commands[i]->outdex = j;
-                pipeline->has_redirect = 1; // true
-            }
-
-            // Append token found
-            if(strcmp(pipeline->commands[i]->args[j], ">>") == 0) {
-                pipeline->commands[i]->append_redirect = 1;
-                pipeline->commands[i]->appenddex = j;
-                pipeline->has_redirect = 1; // true
-            }
-        }
-    }
+static int redirect_open_file(const char *path, int flags) {
+    int fd = open(path, flags, 0666);
+    if(fd < 0)
+        fprintf(stderr, RED_TEXT "SHrimp: %s: %s" RESET_COLOR "\n", path, strerror(errno));
+
+    return fd;
+}
+
+//======================================================================================
+
+/**
+ * @brief Opens a file and moves it onto the provided standard file descriptor.
+ *
+ * @param path the file to open.
+ * @param flags the flags to open the file with.
+ * @param target_fd STDIN_FILENO or STDOUT_FILENO.
+ *
+ * @return 0 on success, -1 if the file could not be opened.
+ */
+static int redirect_fd(const char *path, int flags, int target_fd) {
+    int fd = redirect_open_file(path, flags);
+    if(fd < 0)
+        return -1;
+    close(target_fd);
+    dup2(fd, target_fd);
+    close(fd);
+
+    return 0;
 }
 
 //======================================================================================
@@ -68,37 +76,138 @@ void check_redirection(Pipeline *pipeline) {
  * @brief Redirects the input/output of the command.
  *
  * @param cmd SHrimpCommand object to redirect the input and/or output of.
+ *
+ * @return 0 on success, -1 if a file could not be opened, in which case the caller must not
+ * run the command.
+ *
+ * @details The redirection tokens and their file names were already removed from the
+ * command's args by the parser, so only the file descriptors need to be set up here.
  */
-void redirect(SHrimpCommand *cmd) {
+int redirect(SHrimpCommand *cmd) {
     // Redirect the command's input
-    if(cmd->input_redirect == 1) {
-        int in = open(cmd->args[cmd->index + 1], O_RDONLY, 0666);
-        close(STDIN_FILENO);
-        dup2(in, STDIN_FILENO);
-        close(in);
-        cmd->args[cmd->index] = NULL;
-        cmd->args[cmd->index + 1] = NULL;
-    }
+    if(cmd->input_redirect == 1 && redirect_fd(cmd->infile, O_RDONLY, STDIN_FILENO) < 0)
+        return -1;
 
     // Redirect the command's output 
-    if(cmd->output_redirect == 1) {
-        int out = open(cmd->args[cmd->outdex + 1], O_CREAT | O_WRONLY | O_TRUNC, 0666);  
-        close(STDOUT_FILENO);
-        dup2(out, STDOUT_FILENO);
-        close(out);
-        cmd->args[cmd->outdex] = NULL;
-        cmd->args[cmd->outdex + 1] = NULL;    
-    }
+    if(cmd->output_redirect == 1 && redirect_fd(cmd->outfile, O_CREAT | O_WRONLY | O_TRUNC, STDOUT_FILENO) < 0)
+        return -1;
 
     // Redirect the command's output and append it to the provided file
-    if(cmd->append_redirect == 1) {
-        int out = open(cmd->args[cmd->appenddex + 1], O_CREAT | O_WRONLY | O_APPEND, 0666);
-        close(STDOUT_FILENO);
-        dup2(out, STDOUT_FILENO);
-        close(out);
-        cmd->args[cmd->appenddex] = NULL;
-        cmd->args[cmd->appenddex + 1] = NULL;
+    if(cmd->append_redirect == 1 && redirect_fd(cmd->outfile, O_CREAT | O_WRONLY | O_APPEND, STDOUT_FILENO) < 0)
+        return -1;
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Opens the redirection files of a command in the shell, for spawn engines that
+ * cannot run redirect() in the child.
+ *
+ * @param cmd SHrimpCommand object whose redirection files are opened.
+ * @param in_fd set to the O_CLOEXEC file descriptor of the input file, or -1 if none.
+ * @param out_fd set to the O_CLOEXEC file descriptor of the output file, or -1 if none.
+ *
+ * @return 0 on success, -1 if a file could not be opened, in which case it was reported
+ * exactly as redirect() does, nothing is left open and the caller must not run the command.
+ *
+ * @details The files are opened in the same order as redirect() opens them, so a missing
+ * input file keeps the output file from being created with every spawn engine.
+ */
+int redirect_open(SHrimpCommand *cmd, int *in_fd, int *out_fd) {
+    *in_fd = -1;
+    *out_fd = -1;
+
+    if(cmd->input_redirect == 1 && (*in_fd = redirect_open_file(cmd->infile, O_RDONLY | O_CLOEXEC)) < 0)
+        return -1;
+
+    int flags = O_CREAT | O_WRONLY | O_CLOEXEC | (cmd->append_redirect == 1 ? O_APPEND : O_TRUNC);
+    if((cmd->output_redirect == 1 || cmd->append_redirect == 1) && (*out_fd = redirect_open_file(cmd->outfile, flags)) < 0) {
+        if(*in_fd >= 0)
+            close(*in_fd);
+        *in_fd = -1;
+        return -1;
     }
+
+    return 0;
 }
 
-//======================================================================================
\ No newline at end of file
+//======================================================================================
+
+/**
+ * @brief Writes the whole of a buffer to a file descriptor.
+ *
+ * @param fd the file descriptor to write to.
+ * @param data the bytes to write.
+ * @param len the amount of bytes to write.
+ *
+ * @return 0 on success, -1 if a write failed, with errno set.
+ */
+static int write_all(int fd, const char *data, size_t len) {
+    while(len > 0) {
+        ssize_t written = write(fd, data, len);
+        if(written < 0) {
+            if(errno == EINTR)
+                continue;
+            return -1;
+        }
+        data += written;
+        len -= written;
+    }
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Opens the text of a here-string or here-doc as a file descriptor to read it from.
+ *
+ * @param cmd SHrimpCommand object whose here text is opened.
+ *
+ * @return An O_CLOEXEC file descriptor positioned at the start of the text, or -1 if it
+ * could not be created, in which case the error is reported and the command must not run.
+ *
+ * @details Nothing ever touches the filesystem. Text that fits in a pipe is written into
+ * one by the shell before the command starts, after which only the read end is kept, so
+ * the write can never block and the command sees EOF right after the text. Larger text
+ * would fill a pipe long before the command could start reading it, so it goes to an
+ * anonymous memfd_create() file instead, rewound to its start. Pipes can be as small as a
+ * single page once the per-user pipe limit is reached, so the size of the pipe is checked
+ * rather than assumed.
+ */
+int redirect_here(SHrimpCommand *cmd) {
+    int fd[2];
+
+    if(pipe2(fd, O_CLOEXEC) < 0) {
+        fprintf(stderr, RED_TEXT "SHrimp: here-doc: %s" RESET_COLOR "\n", strerror(errno));
+        return -1;
+    }
+
+    int size = fcntl(fd[1], F_GETPIPE_SZ);
+    if(size > 0 && cmd->here_len <= (size_t)size) {
+        if(write_all(fd[1], cmd->here, cmd->here_len) == 0) {
+            close(fd[1]);
+            return fd[0];
+        }
+        fprintf(stderr, RED_TEXT "SHrimp: here-doc: %s" RESET_COLOR "\n", strerror(errno));
+        close(fd[0]);
+        close(fd[1]);
+        return -1;
+    }
+    close(fd[0]);
+    close(fd[1]);
+
+    int memfd = memfd_create("shrimp-heredoc", MFD_CLOEXEC);
+    if(memfd < 0 || write_all(memfd, cmd->here, cmd->here_len) < 0 || lseek(memfd, 0, SEEK_SET) < 0) {
+        fprintf(stderr, RED_TEXT "SHrimp: here-doc: %s" RESET_COLOR "\n", strerror(errno));
+        if(memfd >= 0)
+            close(memfd);
+        return -1;
+    }
+
+    return memfd;
+}
+
+//======================================================================================
@@ -17,7 +17,7 @@
  *
  * Author: Ryan McHenry
  * Created: January 23, 2026
- * Last Modified: February 10, 2026
+ * Last Modified: October 14, 2026
  */
 
 #ifndef REDIRECT_H
@@ -25,7 +25,8 @@
 
 #include "types/types.h"
 
-void check_redirection(Pipeline *pipeline);
-void redirect(SHrimpCommand *cmd);
+int redirect(SHrimpCommand *cmd);
+int redirect_open(SHrimpCommand *cmd, int *in_fd, int *out_fd);
+int redirect_here(SHrimpCommand *cmd);
 
 #endif
\ No newline at end of file
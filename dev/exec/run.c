@@ -0,0 +1,414 @@
+/* run.c
+ *
+ * Contains the logic for running a single line of input, from parsing it to executing
+ * each of its pipelines.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <stdio.h>         // fprintf(), snprintf()
+#include <stdlib.h>        // free()
+#include <string.h>        // strstr(), strlen(), memcpy(), memset()
+#include <signal.h>        // SIGINT, SIGQUIT, SIGTSTP
+#include <sys/resource.h>  // getrusage(), struct rusage
+#include <sys/time.h>      // timersub()
+#include <time.h>          // clock_gettime(), struct timespec
+#include "config/macros.h" // BUILTIN_SPECIAL, BENCH_MAX_RUNS, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // ParseCode, Commands, Pipeline, ListCondition, Builtin, BenchSample, SHrimpState
+#include "exec/exec.h"     // exec_pipeline(), exec_parallel()
+#include "exec/builtins.h" // run_builtin()
+#include "exec/accounting.h" // timespec_elapsed(), usage_print_header(), usage_print_row(), bench_report()
+#include "exec/jobs.h"     // pipeline_text()
+#include "parse/parse.h"   // parse_line(), parse_heredocs()
+#include "utils/arena.h"   // arena_alloc()
+#include "utils/trace.h"   // TRACE_DECLARE(), TRACE_START(), TRACE_STOP()
+#include "exec/run.h"
+
+//======================================================================================
+
+/**
+ * @brief Checks whether any stage of a pipeline is a special built-in command.
+ *
+ * @param pipeline Pipeline object to check.
+ *
+ * @return The first stage that is a built-in with the BUILTIN_SPECIAL flag, or NULL if
+ * there is none.
+ */
+static const Builtin *find_special_builtin(Pipeline *pipeline) {
+    for(int i = 0; i < pipeline->command_amt; i++) {
+        const Builtin *builtin = pipeline->commands[i]->builtin;
+        if(builtin != NULL && (builtin->flags & BUILTIN_SPECIAL))
+            return builtin;
+    }
+
+    return NULL;
+}
+
+//======================================================================================
+
+/**
+ * @brief Checks whether a pipeline joined by && or || is skipped.
+ *
+ * @param pipeline Pipeline object to check.
+ * @param status the exit status of the pipeline before it.
+ *
+ * @return 1 if the condition of the pipeline does not hold, 0 if it runs.
+ */
+static int list_skips(Pipeline *pipeline, int status) {
+    return (pipeline->condition == LIST_AND && status != 0) || (pipeline->condition == LIST_OR && status == 0);
+}
+
+//======================================================================================
+
+/**
+ * @brief Expands every $? in the args of a pipeline to the exit status of the last pipeline.
+ *
+ * @param pipeline Pipeline object whose args hold $?.
+ * @param state SHrimpState object holding the status and the per-line arena.
+ *
+ * @details The args as parsed are kept in the words of each command the first time it is
+ * expanded, so a pipeline run again, e.g. by bench, expands the status it runs with rather
+ * than the one it first ran with. Only args are expanded, file names of redirections are
+ * used as written.
+ */
+static void expand_status(Pipeline *pipeline, SHrimpState *state) {
+    char status[12];
+    int status_len = snprintf(status, sizeof(status), "%d", state->last_status);
+
+    for(int i = 0; i < pipeline->command_amt; i++) {
+        SHrimpCommand *cmd = pipeline->commands[i];
+        if(!cmd->has_status)
+            continue;
+
+        if(cmd->words == NULL) {
+            cmd->words = arena_alloc(&state->arena, cmd->arg_amt * sizeof(char *));
+            memcpy(cmd->words, cmd->args, cmd->arg_amt * sizeof(char *));
+        }
+
+        for(int j = 0; j < cmd->arg_amt; j++) {
+            const char *word = cmd->words[j];
+            const char *mark = strstr(word, "$?");
+            if(mark == NULL) {
+                cmd->args[j] = cmd->words[j];
+                continue;
+            }
+
+            // A word holds at most len / 2 $?, each becoming status_len bytes
+            size_t len = strlen(word);
+            char *arg = arena_alloc(&state->arena, len / 2 * status_len + len + 1);
+            char *out = arg;
+            for(; mark != NULL; mark = strstr(word, "$?")) {
+                memcpy(out, word, mark - word);
+                out += mark - word;
+                memcpy(out, status, status_len);
+                out += status_len;
+                word = mark + 2;
+            }
+            memcpy(out, word, strlen(word) + 1);
+            cmd->args[j] = arg;
+        }
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Runs a lone built-in command in the shell process and measures its resource use.
+ *
+ * @param cmd SHrimpCommand object of the built-in to run.
+ * @param state SHrimpState object passed on to the built-in.
+ * @param usage where the resource use of the built-in is stored.
+ *
+ * @return The exit status of the built-in.
+ *
+ * @details Since no child is created, the CPU time and context switches are the difference
+ * of the shell's own rusage around the call, and max RSS is that of the shell itself.
+ */
+static int run_builtin_usage(SHrimpCommand *cmd, SHrimpState *state, struct rusage *usage) {
+    struct rusage before;
+
+    getrusage(RUSAGE_SELF, &before);
+    int status = run_builtin(cmd, state);
+    getrusage(RUSAGE_SELF, usage);
+
+    timersub(&usage->ru_utime, &before.ru_utime, &usage->ru_utime);
+    timersub(&usage->ru_stime, &before.ru_stime, &usage->ru_stime);
+    usage->ru_nvcsw -= before.ru_nvcsw;
+    usage->ru_nivcsw -= before.ru_nivcsw;
+
+    return status;
+}
+
+//======================================================================================
+
+/**
+ * @brief Runs a lone built-in command in the shell process and reports its resource use, as
+ * requested by the time prefix.
+ *
+ * @param cmd SHrimpCommand object of the built-in to run.
+ * @param state SHrimpState object passed on to the built-in.
+ *
+ * @return The exit status of the built-in.
+ */
+static int run_builtin_timed(SHrimpCommand *cmd, SHrimpState *state) {
+    struct rusage usage;
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int status = run_builtin_usage(cmd, state, &usage);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    usage_print_header();
+    usage_print_row(timespec_elapsed(&start, &end), &usage, cmd->args[0]);
+
+    return status;
+}
+
+//======================================================================================
+
+/**
+ * @brief Runs a pipeline prefixed with bench again and again and reports how long it took.
+ *
+ * @param pipeline Pipeline object to benchmark, already parsed.
+ * @param state SHrimpState object holding the rest of the shell state.
+ *
+ * @return The exit status of the last run.
+ *
+ * @details The pipeline is parsed once and every run goes through exec_pipeline(), so the
+ * measured wall time holds the shell's own launch and wait overhead but no parsing. The job
+ * of each run stores the resource use of its processes in the run's BenchSample once it is
+ * done. A lone built-in runs in the shell process, as it would without bench. $? is expanded
+ * again before every run. Interrupting or stopping a run ends the benchmark, and only the
+ * runs that finished before it are reported.
+ */
+static int run_bench(Pipeline *pipeline, SHrimpState *state) {
+    BenchSample *samples = arena_alloc(&state->arena, pipeline->bench_runs * sizeof(BenchSample));
+    BenchSample warmup;
+    int lone_builtin = pipeline->has_builtin && pipeline->command_amt == 1;
+    int measured = 0, status = state->last_status;
+
+    for(int i = 0; i < pipeline->bench_warmup + pipeline->bench_runs; i++) {
+        BenchSample *sample = i < pipeline->bench_warmup ? &warmup : &samples[measured];
+        memset(&sample->usage, 0, sizeof(sample->usage));
+        if(pipeline->has_status)
+            expand_status(pipeline, state);
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if(lone_builtin) {
+            status = run_builtin_usage(pipeline->commands[0], state, &sample->usage);
+        } else {
+            pipeline->sample = sample;
+            status = exec_pipeline(pipeline, state);
+            pipeline->sample = NULL;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        state->last_status = status;
+
+        if(status == 128 + SIGINT || status == 128 + SIGQUIT || status == 128 + SIGTSTP)
+            break;
+        sample->real = timespec_elapsed(&start, &end);
+        sample->status = status;
+        if(i >= pipeline->bench_warmup)
+            measured++;
+    }
+
+    char *label = pipeline_text(pipeline);
+    bench_report(samples, measured, pipeline->bench_warmup, label, pipeline->bench_json);
+    free(label);
+
+    return status;
+}
+
+//======================================================================================
+
+/**
+ * @brief Parses and executes a single line of input.
+ *
+ * @param line the line of input to run. It is modified in place.
+ * @param source InputSource object the line was read from, which the body of every <<
+ * here-doc of the line is read from as well.
+ * @param state SHrimpState object holding the per-line arena and the rest of the shell state.
+ *
+ * @return The exit status of the last pipeline executed, which is also stored in
+ * state->last_status. A malformed line has the status 2.
+ *
+ * @details Every allocation made while parsing comes from state->arena, which the caller is
+ * expected to reset before the next line. An INPUT_STDIN source reads every line into the
+ * same buffer, so a line that may hold a here-doc is parsed from a copy in the arena, which
+ * stays valid while the body lines are read.
+ */
+int run_line(char *line, InputSource *source, SHrimpState *state) {
+    Commands commands;
+
+    if(source->kind == INPUT_STDIN && strstr(line, "<<") != NULL) {
+        size_t len = strlen(line) + 1;
+        line = memcpy(arena_alloc(&state->arena, len), line, len);
+    }
+    
+    // Parse the whole line into its pipelines, nothing is executed if any part is malformed
+    TRACE_DECLARE(parse_start);
+    TRACE_START(state, parse_start);
+    ParseCode parsecode = parse_line(line, &commands, &state->arena);
+    TRACE_STOP(state, TRACE_PARSE, parse_start);
+    if(parsecode == PARSE_OK && commands.heredoc_amt > 0)
+        parsecode = parse_heredocs(&commands, source, &state->arena);
+    if(parsecode != PARSE_OK) {
+        print_parse_error(parsecode);
+        state->last_status = 2;
+        return state->last_status;
+    }
+
+    return run_commands(&commands, state);
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes every pipeline of a parsed line of input.
+ *
+ * @param commands Commands object holding the pipelines of the line, e.g. as parsed by
+ * parse_line() or loaded from a compiled script.
+ * @param state SHrimpState object holding the rest of the shell state.
+ *
+ * @return The exit status of the last pipeline executed, which is also stored in
+ * state->last_status.
+ *
+ * @details A pipeline consisting of a single built-in command runs in the shell process
+ * itself, while built-in stages of a longer pipeline are run by a forked child without
+ * calling exec. Pipelines joined by &| run as one parallel group, whose status is that of
+ * the first failing pipeline of the group.
+ *
+ * A pipeline joined by && or || whose condition does not hold is skipped, along with the
+ * rest of its group, without expanding or launching anything, and the status is left as
+ * it was. Every $? is expanded just before its pipeline runs. A pipeline prefixed with
+ * bench runs as many times as it asks for.
+ */
+int run_commands(Commands *commands, SHrimpState *state) {
+    // Execute each pipeline in commands
+    for(int i = 0; i < commands->command_amt; i++) {
+        Pipeline *pipeline = commands->commands[i];
+
+        int group_amt = 1;
+        while(commands->commands[i + group_amt - 1]->parallel)
+            group_amt++;
+
+        if(list_skips(pipeline, state->last_status)) {
+            i += group_amt - 1;
+            continue;
+        }
+        for(int j = 0; j < group_amt; j++) {
+            if(commands->commands[i + j]->has_status)
+                expand_status(commands->commands[i + j], state);
+        }
+
+        // A group of pipelines joined by &| is launched all at once and waited for together
+        if(pipeline->parallel) {
+
+            const Builtin *special = NULL;
+            for(int j = 0; j < group_amt && special == NULL; j++)
+                special = find_special_builtin(commands->commands[i + j]);
+            if(special != NULL) {
+                fprintf(stderr, RED_TEXT "Error: the built-in command %s cannot be run in parallel\n" RESET_COLOR, special->name);
+                state->last_status = 1;
+            } else {
+                state->last_status = exec_parallel(&commands->commands[i], group_amt, state);
+            }
+            i += group_amt - 1;
+            continue;
+        }
+
+        if(pipeline->has_builtin == 1) {
+            // A lone built-in runs directly in the shell process, without forking at all
+            if(pipeline->command_amt == 1 && pipeline->background == 0) {
+                TRACE_DECLARE(builtin_start);
+                TRACE_START(state, builtin_start);
+                if(pipeline->bench)
+                    state->last_status = run_bench(pipeline, state);
+                else if(pipeline->timed)
+                    state->last_status = run_builtin_timed(pipeline->commands[0], state);
+                else
+                    state->last_status = run_builtin(pipeline->commands[0], state);
+                TRACE_STOP(state, TRACE_BUILTIN, builtin_start);
+                continue;
+            }
+
+            // Built-ins that change the state of the shell would have no effect in a child
+            const Builtin *special = find_special_builtin(pipeline);
+            if(special != NULL) {
+                fprintf(stderr, RED_TEXT "Error: the built-in command %s cannot be part of a pipeline or run in the background\n" RESET_COLOR, special->name);
+                state->last_status = 1;
+                continue;
+            }
+        }
+        
+        // Execute the full command pipeline, built-in stages run in a forked child
+        if(pipeline->bench)
+            state->last_status = run_bench(pipeline, state);
+        else
+            state->last_status = exec_pipeline(pipeline, state);
+    }
+
+    return state->last_status;
+}
+
+//======================================================================================
+
+/**
+ * @brief Prints the error message matching a ParseCode returned by parse_line().
+ *
+ * @param parsecode the ParseCode to describe.
+ */
+void print_parse_error(ParseCode parsecode) {
+    switch(parsecode) {
+        case PARSE_INVALID_PIPE:
+            fprintf(stderr, RED_TEXT "Pipe error: A pipe cannot begin or end a line\n" RESET_COLOR);
+            break;
+        case PARSE_INVALID_REDIRECT:
+            fprintf(stderr, RED_TEXT "Redirection error: <, > and >> must be followed by a file name, and <<< and << by a word\n" RESET_COLOR);
+            break;
+        case PARSE_UNTERMINATED_HEREDOC:
+            fprintf(stderr, RED_TEXT "Here-doc error: the input ended before the delimiter of a here-doc\n" RESET_COLOR);
+            break;
+        case PARSE_INVALID_PRIO:
+            fprintf(stderr, RED_TEXT "Prio error: expected -n -20 to 19 or -i idle, none or 0 to 7\n" RESET_COLOR);
+            break;
+        case PARSE_INVALID_PIN:
+            fprintf(stderr, RED_TEXT "Pin error: expected node=auto or node=N\n" RESET_COLOR);
+            break;
+        case PARSE_INVALID_CMD:
+            fprintf(stderr, RED_TEXT "Error: missing command\n" RESET_COLOR);
+            break;
+        case PARSE_INVALID_PARALLEL:
+            fprintf(stderr, RED_TEXT "Parallel error: &| must join two commands and cannot be followed by &\n" RESET_COLOR);
+            break;
+        case PARSE_INVALID_BENCH:
+            fprintf(stderr, RED_TEXT "Bench error: expected -n 1 to %d, -w 0 to %d, -j or --, and no & or &|\n" RESET_COLOR, BENCH_MAX_RUNS, BENCH_MAX_RUNS);
+            break;
+        case PARSE_INVALID_LIST:
+            fprintf(stderr, RED_TEXT "List error: && and || must join two commands\n" RESET_COLOR);
+            break;
+        case PARSE_CMD_OUT_OF_RANGE:
+            fprintf(stderr, RED_TEXT "Error: argument list too long\n" RESET_COLOR);
+            break;
+        default:
+            break;
+    }
+}
+
+//======================================================================================
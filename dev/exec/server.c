@@ -0,0 +1,430 @@
+/* server.c
+ *
+ * Contains the spawn server of SHrimp, a small helper process started from a fresh image of
+ * the shell that launches commands on its behalf, along with the shell's side of it.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/types.h>     // pid_t
+#include <sys/socket.h>    // socketpair(), sendmsg(), recvmsg(), send(), recv(), SCM_RIGHTS
+#include <sys/syscall.h>   // SYS_clone
+#include <sys/wait.h>      // waitpid()
+#include <sched.h>         // CLONE_PARENT
+#include <spawn.h>         // posix_spawn()
+#include <fcntl.h>         // open(), fcntl(), O_PATH, O_DIRECTORY, O_CLOEXEC, FD_CLOEXEC
+#include <unistd.h>        // close(), fchdir(), execv(), syscall(), _exit()
+#include <signal.h>        // SIGCHLD
+#include <stdio.h>         // fprintf(), snprintf(), stderr
+#include <string.h>        // memcpy(), memchr(), strlen(), strerror()
+#include <errno.h>         // errno
+#include "config/macros.h" // SPAWN_REQUEST_MAX, SERVER_*, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // SHrimpState, SpawnServer, SpawnRequest, SpawnSpec, SHrimpCommand
+#include "exec/spawn.h"    // spawn_child_setup()
+#include "exec/server.h"
+
+extern char **environ;
+
+//======================================================================================
+
+/**
+ * @brief Starts the spawn server, unless it is already running.
+ *
+ * @param state SHrimpState object whose spawn server is started.
+ *
+ * @return 0 on success, -1 if the server could not be started.
+ *
+ * @details The server is a new image of /proc/self/exe rather than a fork of the shell, so
+ * its address space stays a few pages large no matter when it is started or how large the
+ * heap of the shell grows. It inherits the environment, working directory, stdio and signal
+ * dispositions of the shell and talks to it over a SOCK_SEQPACKET socket pair, which keeps
+ * every request and reply a single message.
+ */
+int spawn_server_start(SHrimpState *state) {
+    SpawnServer *server = &state->server;
+    if(server->pid > 0)
+        return 0;
+
+    // Only the shell's end is close-on-exec, so the server inherits its own end
+    int sv[2];
+    if(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv) < 0) {
+        fprintf(stderr, RED_TEXT "SHrimp: spawn server: %s" RESET_COLOR "\n", strerror(errno));
+        return -1;
+    }
+    fcntl(sv[0], F_SETFD, FD_CLOEXEC);
+
+    char fd_arg[16];
+    snprintf(fd_arg, sizeof(fd_arg), "%d", sv[1]);
+    char *args[] = { "shrimp", "--spawn-server", fd_arg, NULL };
+
+    pid_t pid;
+    int err = posix_spawn(&pid, "/proc/self/exe", NULL, NULL, args, environ);
+    close(sv[1]);
+    if(err != 0) {
+        fprintf(stderr, RED_TEXT "SHrimp: spawn server: %s" RESET_COLOR "\n", strerror(err));
+        close(sv[0]);
+        return -1;
+    }
+
+    server->pid = pid;
+    server->sock = sv[0];
+    server->cwd_stale = 0;
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Stops the spawn server if it is running.
+ *
+ * @param state SHrimpState object whose spawn server is stopped.
+ *
+ * @details Closing the socket is what tells the server to exit. The server may already have
+ * been collected by the job table if it died on its own, in which case waitpid() fails.
+ */
+void spawn_server_stop(SHrimpState *state) {
+    SpawnServer *server = &state->server;
+    if(server->pid <= 0)
+        return;
+
+    close(server->sock);
+    waitpid(server->pid, NULL, 0);
+    server->pid = 0;
+    server->sock = -1;
+}
+
+//======================================================================================
+
+/**
+ * @brief Gives up on a spawn server that stopped answering, switching to posix_spawn().
+ *
+ * @param state SHrimpState object whose spawn server was lost.
+ */
+static void spawn_server_lost(SHrimpState *state) {
+    fprintf(stderr, RED_TEXT "SHrimp: spawn server exited, using posix_spawn" RESET_COLOR "\n");
+    spawn_server_stop(state);
+    state->spawn_engine = SPAWN_POSIX;
+}
+
+//======================================================================================
+
+/**
+ * @brief Appends a NUL terminated string to a request being assembled.
+ *
+ * @param buf the request being assembled.
+ * @param len the current length of the request, advanced past the string.
+ * @param str the string to append.
+ *
+ * @return 0 on success, -1 if the string does not fit in SPAWN_REQUEST_MAX.
+ */
+static int request_append(char *buf, size_t *len, const char *str) {
+    size_t size = strlen(str) + 1;
+    if(size > SPAWN_REQUEST_MAX - *len)
+        return -1;
+
+    memcpy(buf + *len, str, size);
+    *len += size;
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Launches a command through the spawn server.
+ *
+ * @param spec SpawnSpec object describing the command to launch. Its path must not be NULL.
+ * @param pid where the pid of the child process is stored, -1 if the server could not
+ * create it.
+ *
+ * @return 0 if the server handled the command, -1 if the caller must launch it another way
+ * because the server is not running, has exited or the request is too large.
+ *
+ * @details The request carries the path, args and redirection files of the command while
+ * its pipe ends travel along as SCM_RIGHTS. After a cd the shell's working directory is
+ * passed on as well so the server can follow it. The server creates the child with
+ * CLONE_PARENT, so it is a child of the shell that is reaped through the job table as usual.
+ */
+int spawn_server_launch(SpawnSpec *spec, pid_t *pid) {
+    SHrimpState *state = spec->state;
+    SpawnServer *server = &state->server;
+    SHrimpCommand *cmd = spec->cmd;
+    static char buf[SPAWN_REQUEST_MAX];
+
+    if(server->pid <= 0)
+        return -1;
+
+    SpawnRequest req = {0};
+    req.pgid = spec->pgid;
+    req.sigmask = *spec->sigmask;
+    req.arg_amt = cmd->arg_amt;
+    if(spec->pgid >= 0)
+        req.flags |= SERVER_SETPGID;
+    if(spec->foreground)
+        req.flags |= SERVER_FOREGROUND;
+    if(spec->job_control)
+        req.flags |= SERVER_JOB_CONTROL;
+    if(cmd->input_redirect == 1)
+        req.flags |= SERVER_INPUT_REDIRECT;
+    if(cmd->output_redirect == 1)
+        req.flags |= SERVER_OUTPUT_REDIRECT;
+    if(cmd->append_redirect == 1)
+        req.flags |= SERVER_APPEND_REDIRECT;
+
+    // The fds travel in the order cwd, stdin, stdout, each only if its flag is set
+    int fds[3], fd_amt = 0, cwd_fd = -1;
+    if(server->cwd_stale) {
+        cwd_fd = open(".", O_PATH | O_DIRECTORY | O_CLOEXEC);
+        if(cwd_fd >= 0) {
+            req.flags |= SERVER_CWD_FD;
+            fds[fd_amt++] = cwd_fd;
+        }
+    }
+    if(spec->in_fd >= 0) {
+        req.flags |= SERVER_IN_FD;
+        fds[fd_amt++] = spec->in_fd;
+    }
+    if(spec->out_fd >= 0) {
+        req.flags |= SERVER_OUT_FD;
+        fds[fd_amt++] = spec->out_fd;
+    }
+
+    // Assemble the request, leaving commands that do not fit to the caller
+    size_t len = sizeof(req);
+    memcpy(buf, &req, sizeof(req));
+    int fits = request_append(buf, &len, spec->path) == 0;
+    for(int i = 0; fits && i < cmd->arg_amt; i++)
+        fits = request_append(buf, &len, cmd->args[i]) == 0;
+    if(fits && cmd->input_redirect == 1)
+        fits = request_append(buf, &len, cmd->infile) == 0;
+    if(fits && (cmd->output_redirect == 1 || cmd->append_redirect == 1))
+        fits = request_append(buf, &len, cmd->outfile) == 0;
+    if(!fits) {
+        if(cwd_fd >= 0)
+            close(cwd_fd);
+        return -1;
+    }
+
+    union {
+        struct cmsghdr hdr;
+        char space[CMSG_SPACE(sizeof(fds))];
+    } control;
+    struct iovec iov = { buf, len };
+    struct msghdr msg = {0};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    if(fd_amt > 0) {
+        msg.msg_control = control.space;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * fd_amt);
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fd_amt);
+        memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * fd_amt);
+    }
+
+    ssize_t sent = sendmsg(server->sock, &msg, MSG_NOSIGNAL);
+    if(cwd_fd >= 0)
+        close(cwd_fd);
+    if(sent < 0) {
+        spawn_server_lost(state);
+        return -1;
+    }
+    if(cwd_fd >= 0)
+        server->cwd_stale = 0;
+
+    // The reply is the pid of the child, or a negated errno if it could not be created
+    pid_t reply;
+    if(recv(server->sock, &reply, sizeof(reply), 0) != (ssize_t)sizeof(reply)) {
+        spawn_server_lost(state);
+        return -1;
+    }
+    if(reply < 0) {
+        fprintf(stderr, RED_TEXT "SHrimp: %s: %s" RESET_COLOR "\n", cmd->args[0], strerror(-reply));
+        *pid = -1;
+        return 0;
+    }
+
+    *pid = reply;
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Reads the next NUL terminated string of a received request.
+ *
+ * @param buf the received request.
+ * @param len the length of the request.
+ * @param pos the offset of the string, advanced past it.
+ *
+ * @return The string, or NULL if the request ends before the string does.
+ */
+static char *request_next(char *buf, size_t len, size_t *pos) {
+    if(*pos >= len)
+        return NULL;
+
+    char *str = buf + *pos;
+    char *end = memchr(str, '\0', len - *pos);
+    if(end == NULL)
+        return NULL;
+
+    *pos += (size_t)(end - str) + 1;
+    return str;
+}
+
+//======================================================================================
+
+/**
+ * @brief Runs a command in a child of the spawn server. Never returns.
+ *
+ * @param req the request describing the command.
+ * @param path the resolved path of the command's executable.
+ * @param cmd SHrimpCommand object holding the args and redirection files of the command.
+ * @param in_fd fd to use as the command's stdin, -1 to inherit the server's.
+ * @param out_fd fd to use as the command's stdout, -1 to inherit the server's.
+ */
+static void server_child(const SpawnRequest *req, const char *path, SHrimpCommand *cmd, int in_fd, int out_fd) {
+    SpawnSpec spec = {0};
+    spec.cmd = cmd;
+    spec.path = path;
+    spec.in_fd = in_fd;
+    spec.out_fd = out_fd;
+    spec.unused_fd = -1;
+    spec.cgroup_fd = -1;
+    spec.sigmask = &req->sigmask;
+    spec.pgid = (req->flags & SERVER_SETPGID) ? req->pgid : -1;
+    spec.foreground = (req->flags & SERVER_FOREGROUND) != 0;
+    spec.job_control = (req->flags & SERVER_JOB_CONTROL) != 0;
+
+    if(spawn_child_setup(&spec) < 0)
+        _exit(1);
+
+    execv(path, cmd->args);
+    fprintf(stderr, RED_TEXT "SHrimp: %s: %s" RESET_COLOR "\n", cmd->args[0], strerror(errno));
+    _exit(127);
+}
+
+//======================================================================================
+
+/**
+ * @brief Main loop of the spawn server, run by "shrimp --spawn-server fd".
+ *
+ * @param sock the server's end of the socket to the shell.
+ *
+ * @return 0 once the shell closed its end of the socket, 1 on a socket error.
+ *
+ * @details Each request is answered with the pid of the child created for it. Requests are
+ * received into static buffers and the server allocates nothing, so creating a child
+ * copies the page tables of a tiny address space instead of those of the shell. Received
+ * fds are close-on-exec in the server and only become the child's stdio through dup2().
+ */
+int spawn_server_main(int sock) {
+    static char buf[SPAWN_REQUEST_MAX];
+    static char *args[SPAWN_REQUEST_MAX / 2 + 1];
+
+    fcntl(sock, F_SETFD, FD_CLOEXEC);
+
+    while(1) {
+        union {
+            struct cmsghdr hdr;
+            char space[CMSG_SPACE(sizeof(int) * 3)];
+        } control;
+        struct iovec iov = { buf, sizeof(buf) };
+        struct msghdr msg = {0};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control.space;
+        msg.msg_controllen = sizeof(control.space);
+
+        ssize_t len = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+        if(len == 0)
+            return 0;
+        if(len < 0) {
+            if(errno == EINTR)
+                continue;
+            return 1;
+        }
+
+        int fds[3], fd_amt = 0;
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        if(cmsg != NULL && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            fd_amt = (int)((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+            if(fd_amt > 3)
+                fd_amt = 3;
+            memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * fd_amt);
+        }
+
+        // Unpack the request, rejecting any that does not match what the shell sends
+        SpawnRequest req;
+        SHrimpCommand cmd = {0};
+        char *path = NULL;
+        int valid = (size_t)len >= sizeof(req) && (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) == 0;
+        if(valid) {
+            memcpy(&req, buf, sizeof(req));
+            size_t pos = sizeof(req);
+            path = request_next(buf, len, &pos);
+            valid = path != NULL && req.arg_amt > 0 && req.arg_amt < (int)(sizeof(args) / sizeof(args[0]));
+            for(int i = 0; valid && i < req.arg_amt; i++)
+                valid = (args[i] = request_next(buf, len, &pos)) != NULL;
+            if(valid) {
+                args[req.arg_amt] = NULL;
+                cmd.args = args;
+                cmd.arg_amt = req.arg_amt;
+                cmd.input_redirect = (req.flags & SERVER_INPUT_REDIRECT) != 0;
+                cmd.output_redirect = (req.flags & SERVER_OUTPUT_REDIRECT) != 0;
+                cmd.append_redirect = (req.flags & SERVER_APPEND_REDIRECT) != 0;
+                if(cmd.input_redirect)
+                    valid = (cmd.infile = request_next(buf, len, &pos)) != NULL;
+                if(valid && (cmd.output_redirect || cmd.append_redirect))
+                    valid = (cmd.outfile = request_next(buf, len, &pos)) != NULL;
+            }
+            int expected = ((req.flags & SERVER_CWD_FD) != 0) + ((req.flags & SERVER_IN_FD) != 0) + ((req.flags & SERVER_OUT_FD) != 0);
+            valid = valid && expected == fd_amt;
+        }
+
+        pid_t reply = -EINVAL;
+        if(valid) {
+            int next = 0, in_fd = -1, out_fd = -1;
+
+            // Follow the shell into its new working directory for this and later children
+            if(req.flags & SERVER_CWD_FD) {
+                if(fchdir(fds[next]) < 0)
+                    fprintf(stderr, RED_TEXT "SHrimp: spawn server: %s" RESET_COLOR "\n", strerror(errno));
+                next++;
+            }
+            if(req.flags & SERVER_IN_FD)
+                in_fd = fds[next++];
+            if(req.flags & SERVER_OUT_FD)
+                out_fd = fds[next++];
+
+            // CLONE_PARENT makes the child a sibling of the server, so the shell reaps it
+            pid_t pid = (pid_t)syscall(SYS_clone, CLONE_PARENT | SIGCHLD, NULL, NULL, NULL, NULL);
+            if(pid == 0)
+                server_child(&req, path, &cmd, in_fd, out_fd);
+            reply = pid < 0 ? -errno : pid;
+        }
+
+        for(int i = 0; i < fd_amt; i++)
+            close(fds[i]);
+
+        if(send(sock, &reply, sizeof(reply), MSG_NOSIGNAL) < 0)
+            return 1;
+    }
+}
+
+//======================================================================================
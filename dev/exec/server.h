@@ -0,0 +1,34 @@
+/* server.h
+ *
+ * Header file for server.c
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <sys/types.h>   // pid_t
+#include "types/types.h"
+
+int spawn_server_start(SHrimpState *state);
+void spawn_server_stop(SHrimpState *state);
+int spawn_server_launch(SpawnSpec *spec, pid_t *pid);
+int spawn_server_main(int sock);
+
+#endif
@@ -0,0 +1,339 @@
+/* spawn.c
+ *
+ * Contains the spawn engines used to launch each command of a pipeline.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/types.h>     // pid_t
+#include <sys/syscall.h>   // SYS_clone3, SYS_ioprio_set
+#include <linux/sched.h>   // struct clone_args, CLONE_INTO_CGROUP
+#include <linux/ioprio.h>  // IOPRIO_WHO_PROCESS
+#include <spawn.h>         // posix_spawn(), posix_spawn_file_actions_t
+#include <sched.h>         // sched_setaffinity(), cpu_set_t
+#include <unistd.h>        // fork(), syscall(), nice(), dup2(), close(), close_range(), execv(), setpgid(), tcsetpgrp()
+#include <signal.h>        // sigprocmask(), signal(), SIGCHLD, SIGINT, SIGQUIT, SIGTSTP, SIGTTIN, SIGTTOU
+#include <stdio.h>         // printf(), fprintf(), perror(), fflush()
+#include <stdlib.h>        // exit(), _exit()
+#include <string.h>        // strcmp(), strerror()
+#include <errno.h>         // errno
+#include "config/macros.h" // RED_TEXT, RESET_COLOR
+#include "types/types.h"   // SHrimpCommand, SpawnSpec, SpawnEngine
+#include "exec/redirect.h" // redirect(), redirect_open()
+#include "exec/server.h"   // spawn_server_launch()
+#include "exec/cgroup.h"   // cgroup_join()
+#include "exec/spawn.h"
+
+extern char **environ;
+
+// Signals an interactive shell ignores, which every job must receive with their defaults
+static const int job_control_signals[] = { SIGINT, SIGQUIT, SIGTSTP, SIGTTIN, SIGTTOU };
+
+//======================================================================================
+
+/**
+ * @brief Converts the name of a spawn engine into its SpawnEngine value.
+ *
+ * @param name the engine name, either "fork", "posix_spawn" or "server".
+ *
+ * @return The matching SpawnEngine, or SPAWN_INVALID if name is not a known engine.
+ */
+SpawnEngine spawn_engine_from_name(const char *name) {
+    if(strcmp(name, "fork") == 0)
+        return SPAWN_FORK;
+    if(strcmp(name, "posix_spawn") == 0 || strcmp(name, "spawn") == 0)
+        return SPAWN_POSIX;
+    if(strcmp(name, "server") == 0)
+        return SPAWN_SERVER;
+
+    return SPAWN_INVALID;
+}
+
+//======================================================================================
+
+/**
+ * @brief Converts a SpawnEngine value into its printable name.
+ *
+ * @param engine the engine to name.
+ *
+ * @return A static string holding the name of the engine.
+ */
+const char *spawn_engine_name(SpawnEngine engine) {
+    switch(engine) {
+        case SPAWN_FORK:
+            return "fork";
+        case SPAWN_POSIX:
+            return "posix_spawn";
+        case SPAWN_SERVER:
+            return "server";
+        default:
+            return "invalid";
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Prepares a freshly created child process to run the command of a SpawnSpec.
+ *
+ * @param spec SpawnSpec object describing the command the child runs.
+ *
+ * @return 0 on success, -1 if a redirection file could not be opened, in which case the
+ * child must exit without running the command.
+ *
+ * @details Shared by the fork engine and the children of the spawn server. The child joins
+ * its job, restores the signal state the shell started with, lowers its CPU and I/O
+ * priority when the pipeline is prefixed with prio, pins itself to the CPUs of a NUMA node
+ * when it is prefixed with pin, sets its stdin and stdout to the provided pipe ends and
+ * then redirects if applicable. A priority or affinity the kernel refuses is reported, but
+ * the command still runs.
+ */
+int spawn_child_setup(SpawnSpec *spec) {
+    // Join the job's process group and take the terminal while the ignored SIGTTOU still
+    // allows it, then restore the signal dispositions and mask the shell started with
+    if(spec->pgid >= 0) {
+        setpgid(0, spec->pgid);
+        if(spec->foreground)
+            tcsetpgrp(STDIN_FILENO, getpgrp());
+    }
+    if(spec->job_control) {
+        for(size_t j = 0; j < sizeof(job_control_signals) / sizeof(job_control_signals[0]); j++)
+            signal(job_control_signals[j], SIG_DFL);
+    }
+    sigprocmask(SIG_SETMASK, spec->sigmask, NULL);
+
+    // Apply the priority of a prio prefix. nice() may legitimately return -1, so failure is
+    // told apart through errno
+    if(spec->nice != 0) {
+        errno = 0;
+        if(nice(spec->nice) == -1 && errno != 0)
+            fprintf(stderr, RED_TEXT "prio: nice %d: %s" RESET_COLOR "\n", spec->nice, strerror(errno));
+    }
+    if(spec->ioprio != 0 && syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, spec->ioprio) < 0)
+        fprintf(stderr, RED_TEXT "prio: ioprio: %s" RESET_COLOR "\n", strerror(errno));
+    if(spec->affinity != NULL && sched_setaffinity(0, sizeof(cpu_set_t), spec->affinity) < 0)
+        fprintf(stderr, RED_TEXT "pin: %s" RESET_COLOR "\n", strerror(errno));
+
+    // Set the correct fd. Every pipe end is O_CLOEXEC, so exec closes the originals
+    if(spec->in_fd >= 0)
+        dup2(spec->in_fd, STDIN_FILENO);
+    if(spec->out_fd >= 0)
+        dup2(spec->out_fd, STDOUT_FILENO);
+
+    // Redirect if applicable
+    SHrimpCommand *cmd = spec->cmd;
+    if(cmd->input_redirect == 1 || cmd->output_redirect == 1 || cmd->append_redirect == 1)
+        return redirect(cmd);
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Launches a command with fork(), wiring up its file descriptors in the child.
+ *
+ * @param spec SpawnSpec object describing the command to launch.
+ *
+ * @return The pid of the child process.
+ *
+ * @details The child sets its stdin and stdout to the provided pipe ends, redirects if
+ * applicable and then executes the resolved path. Built-in
+ * commands are run by the child itself, which then exits without ever calling exec.
+ *
+ * A child placed in a cgroup is created with clone3(CLONE_INTO_CGROUP), so it never runs
+ * outside its limits, not even for the few instructions before exec. Kernels before 5.7
+ * and cgroups the shell may not create processes in fall back to fork(), and the child then
+ * writes itself to cgroup.procs instead.
+ */
+static pid_t spawn_fork(SpawnSpec *spec) {
+    pid_t pid = -1;
+    int joined = spec->cgroup_fd < 0;
+
+    // Create an executed stage directly in its cgroup. Built-in stages keep going through
+    // fork(), whose atfork handlers leave malloc and stdio usable for the shell code they run
+    if(spec->cgroup_fd >= 0 && spec->cmd->builtin == NULL) {
+        struct clone_args args = { .flags = CLONE_INTO_CGROUP, .exit_signal = SIGCHLD, .cgroup = (__u64)spec->cgroup_fd };
+        pid = syscall(SYS_clone3, &args, sizeof(args));
+        joined = pid >= 0;
+    }
+    if(pid < 0)
+        pid = fork();
+
+    if(pid < 0) {
+        perror("fork failed");
+        exit(1);
+    } else if(pid > 0) { // parent
+        return pid;
+    }
+
+    // Without CLONE_INTO_CGROUP, the child moves itself in before running anything
+    if(!joined && cgroup_join(spec->cgroup_fd) < 0)
+        fprintf(stderr, RED_TEXT "SHrimp: cgroup: %s" RESET_COLOR "\n", strerror(errno));
+
+    if(spawn_child_setup(spec) < 0)
+        exit(1);
+
+    // Run a built-in stage directly in the child, without executing anything. It never
+    // reaches exec, so every descriptor above stdio is closed in one call instead
+    SHrimpCommand *cmd = spec->cmd;
+    if(cmd->builtin != NULL) {
+        if(close_range(3, ~0U, 0) < 0 && spec->unused_fd >= 0)
+            close(spec->unused_fd);
+
+        // The child is not the shell, so commands a built-in such as pmap launches get
+        // neither job control nor the spawn server, whose children belong to the shell
+        SHrimpState *state = spec->state;
+        state->jobs.job_control = 0;
+        state->server.pid = 0;
+        if(state->spawn_engine == SPAWN_SERVER)
+            state->spawn_engine = SPAWN_POSIX;
+        int status = cmd->builtin->func(cmd->args, state);
+        fflush(NULL);
+        _exit(status);
+    }
+
+    // Execute the command
+    if(spec->path != NULL)
+        execv(spec->path, cmd->args);
+    printf(RED_TEXT "%s: command not found" RESET_COLOR "\n", cmd->args[0]);
+    exit(127);
+}
+
+//======================================================================================
+
+/**
+ * @brief Launches a command with posix_spawn(), expressing the pipe and redirection
+ * handling of the fork engine as spawn file actions.
+ *
+ * @param spec SpawnSpec object describing the command to launch.
+ *
+ * @return The pid of the child process, or -1 if the command could not be launched, with
+ * spec->status set to the status of the command.
+ *
+ * @details glibc implements posix_spawn() with clone(CLONE_VM | CLONE_VFORK), so the page
+ * tables of the shell are never copied no matter how large its heap grows. Since no code of
+ * ours runs in the child, redirection files are opened by the shell with redirect_open()
+ * before anything else, so a file that cannot be opened is reported by its name with
+ * status 1, exactly as with the fork engine. They are moved onto stdin and stdout after the
+ * pipe ends, which gives redirection precedence over the pipe exactly as redirect() does.
+ */
+static pid_t spawn_posix(SpawnSpec *spec) {
+    SHrimpCommand *cmd = spec->cmd;
+
+    int redirect_in = -1, redirect_out = -1;
+    if(redirect_open(cmd, &redirect_in, &redirect_out) < 0) {
+        spec->status = 1;
+        return -1;
+    }
+
+    // The command was not found in $PATH, no process needs to be created
+    if(spec->path == NULL) {
+        printf(RED_TEXT "%s: command not found" RESET_COLOR "\n", cmd->args[0]);
+        if(redirect_in >= 0)
+            close(redirect_in);
+        if(redirect_out >= 0)
+            close(redirect_out);
+        spec->status = 127;
+        return -1;
+    }
+
+    // Take the terminal while stdin still refers to it, set the correct fd, then redirect if
+    // applicable. The O_CLOEXEC pipe ends need no close actions since exec closes them
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    if(spec->pgid >= 0 && spec->foreground)
+        posix_spawn_file_actions_addtcsetpgrp_np(&actions, STDIN_FILENO);
+    if(spec->in_fd >= 0)
+        posix_spawn_file_actions_adddup2(&actions, spec->in_fd, STDIN_FILENO);
+    if(spec->out_fd >= 0)
+        posix_spawn_file_actions_adddup2(&actions, spec->out_fd, STDOUT_FILENO);
+    if(redirect_in >= 0)
+        posix_spawn_file_actions_adddup2(&actions, redirect_in, STDIN_FILENO);
+    if(redirect_out >= 0)
+        posix_spawn_file_actions_adddup2(&actions, redirect_out, STDOUT_FILENO);
+
+    // Restore the signal mask the shell started with, and with job control join the job's
+    // process group and restore the default job control signals
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    short flags = POSIX_SPAWN_SETSIGMASK;
+    posix_spawnattr_setsigmask(&attr, spec->sigmask);
+    if(spec->pgid >= 0) {
+        flags |= POSIX_SPAWN_SETPGROUP;
+        posix_spawnattr_setpgroup(&attr, spec->pgid);
+    }
+    if(spec->job_control) {
+        sigset_t defaults;
+        sigemptyset(&defaults);
+        for(size_t j = 0; j < sizeof(job_control_signals) / sizeof(job_control_signals[0]); j++)
+            sigaddset(&defaults, job_control_signals[j]);
+        flags |= POSIX_SPAWN_SETSIGDEF;
+        posix_spawnattr_setsigdefault(&attr, &defaults);
+    }
+    posix_spawnattr_setflags(&attr, flags);
+
+    pid_t pid;
+    int err = posix_spawn(&pid, spec->path, &actions, &attr, cmd->args, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+    if(redirect_in >= 0)
+        close(redirect_in);
+    if(redirect_out >= 0)
+        close(redirect_out);
+
+    if(err != 0) {
+        fprintf(stderr, RED_TEXT "SHrimp: %s: %s" RESET_COLOR "\n", cmd->args[0], strerror(err));
+        spec->status = 127;
+        return -1;
+    }
+
+    return pid;
+}
+
+//======================================================================================
+
+/**
+ * @brief Launches a single command of a pipeline with the selected spawn engine.
+ *
+ * @param spec SpawnSpec object describing the command to launch.
+ * @param engine the spawn engine to launch the command with.
+ *
+ * @return The pid of the child process, or -1 if the command could not be launched, with
+ * spec->status set to the status of the command.
+ *
+ * @details Built-in commands always use the fork engine, since they run code of the shell
+ * in the child which no other engine can do. So do commands placed in a cgroup or prefixed
+ * with prio or pin, since neither posix_spawn() nor the spawn server can set a cgroup, a
+ * priority or an affinity. Commands the spawn server cannot take, such as commands that
+ * were not found or whose request does not fit in SPAWN_REQUEST_MAX, fall back to
+ * posix_spawn().
+ */
+pid_t spawn_command(SpawnSpec *spec, SpawnEngine engine) {
+    if(engine == SPAWN_FORK || spec->cmd->builtin != NULL || spec->cgroup_fd >= 0 || spec->nice != 0 || spec->ioprio != 0 ||
+       spec->affinity != NULL)
+        return spawn_fork(spec);
+
+    pid_t pid;
+    if(engine == SPAWN_SERVER && spec->path != NULL && spawn_server_launch(spec, &pid) == 0)
+        return pid;
+
+    return spawn_posix(spec);
+}
+
+//======================================================================================
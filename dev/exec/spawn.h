@@ -0,0 +1,34 @@
+/* spawn.h
+ *
+ * Header file for spawn.c
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef SPAWN_H
+#define SPAWN_H
+
+#include <sys/types.h>   // pid_t
+#include "types/types.h"
+
+SpawnEngine spawn_engine_from_name(const char *name);
+const char *spawn_engine_name(SpawnEngine engine);
+int spawn_child_setup(SpawnSpec *spec);
+pid_t spawn_command(SpawnSpec *spec, SpawnEngine engine);
+
+#endif
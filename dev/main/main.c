@@ -17,218 +17,264 @@
  *
  * Author: Ryan McHenry
  * Created: March 21, 2025
- * Last Modified: February 14, 2026
+ * Last Modified: October 14, 2026
  */
 
 #include <pthread.h>
-#include <sys/wait.h>      // waitpid(), WNOHANG
-#include <stdlib.h>        // malloc(), free()
-#include <stdio.h>         // printf(), clearerr(), stdin
-#include <signal.h>        // SIGCHLD, signal()
-#include <errno.h>         // errno, EINTR
-#include <string.h>        // strcmp()
-#include "types/types.h"   // ParseCode, SHrimpCommand, Commands, Pipeline, SHrimpState
-#include "exec/pipe.h"     // check_piping()
-#include "exec/redirect.h" // check_redirection()
-#include "exec/exec.h"     // execute_command()
-#include "parse/parse.h"   // get_input(), parse_input()
-#include "utils/utils.h"   // safe_malloc()
-
-// function prototypes
-void reset_vars(SHrimpCommand *cmd, Pipeline *pipeline);
-void sig_handler(int signo);
+#include <stdlib.h>        // getenv(), atoi()
+#include <stdio.h>         // fprintf(), stderr
+#include <string.h>        // strcmp(), strerror()
+#include <errno.h>         // errno
+#include "config/macros.h" // ARENA_BLOCK_SIZE, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // InputSource, SHrimpState
+#include "exec/hash.h"     // hash_clear()
+#include "exec/spawn.h"    // spawn_engine_from_name()
+#include "exec/options.h"  // set_option()
+#include "exec/server.h"   // spawn_server_main(), spawn_server_start(), spawn_server_stop()
+#include "exec/cgroup.h"   // cgroup_close()
+#include "exec/numa.h"     // numa_free()
+#include "exec/events.h"   // events_init(), events_free()
+#include "exec/jobs.h"     // jobs_init(), jobs_notify(), jobs_free()
+#include "exec/run.h"      // run_line(), run_commands(), print_parse_error()
+#include "parse/parse.h"   // free_input()
+#include "parse/input.h"   // input_open_stdin(), input_open_string(), input_open_file(), input_next_line()
+#include "parse/prompt.h"  // prompt_free()
+#include "parse/history.h" // history_close()
+#include "parse/editor.h"  // editor_supported(), editor_free()
+#include "parse/cache.h"   // script_cache_open(), script_cache_next(), script_cache_close()
+#include "utils/arena.h"   // arena_init(), arena_reset(), arena_free()
+#include "utils/trace.h"   // TRACE_DECLARE(), TRACE_START(), TRACE_STOP(), trace_dump()
+#include "utils/profile.h" // profile_start(), profile_mark(), profile_dump()
 
 //======================================================================================
 
 /**
  * @brief main function that contains all vars, initializes everything, and contains the
  * main loop of the shell.
+ *
+ * @param argc the amount of command line arguments.
+ * @param argv the command line arguments. "shrimp -c 'commands'" runs the provided string,
+ * "shrimp script" runs a script file, and "shrimp" alone reads commands from stdin.
+ * A leading --startup-profile prints the time spent in every phase of startup to stderr.
+ * "shrimp --spawn-server fd" is only run by SHrimp itself to start its spawn server.
  * 
- * @return 0 on successfully terminating.
+ * @return The exit status of the last command executed.
  *
- * @details  Declares vars used by all helper functions, sets up the signal handler to catch child
- * processes, initializes the ThreadQueue struct variable as well as the background thread
- * used within the helper function poll().
+ * @details  Declares vars used by all helper functions, sets up the job table to reap child
+ * processes, initializes the shell state and opens the input source selected by argv.
  *
  * Contains the main loop of the shell itself. The each time the shell initializes a new
  * iteration of the while loop, it executes the following steps:
  *
- *   1. Reset all variables from the previous iteration.
- *   2. Receive the user input.
- *   3. Parse the user input.
- *   4. Further parse the input to check for redirection or piping.
- *   5. If reaching this step without any errors, execute the provided command.
+ *   1. Release the per-line arena from the previous iteration.
+ *   2. Receive the next line of input.
+ *   3. Parse the line into its pipelines in a single pass.
+ *   4. If reaching this step without any errors, execute each pipeline in order.
+ *
+ * Scripts and -c strings are read into memory once up front and never display the prompt,
+ * so running them is a tight loop of the steps above with no per-line allocation. With
+ * $SHRIMP_SCRIPT_CACHE set, a script whose compiled form is in the script cache skips steps
+ * 2 and 3, loading each line's pipelines from the cache instead.
+ *
+ * Startup only does what every session needs. The history is opened and the completion
+ * trie is built once the first prompt is due, and a non-interactive shell never probes the
+ * terminal beyond the single isatty() check of stdin.
  *
  * After exiting the main loop of the shell, allocated heap memory is freed.
  */
-int main() {
+int main(int argc, char **argv) {
     // Vars
-    int display = 1;              // flag to display the SHrimp prompt or not
     char *input;                  // string to store CLI input
-    SHrimpCommand cmd = {0};      // shell command
-    Commands commands = {0};      // list of commands in a line of input
-    Pipeline pipeline = {0};      // pipeline of current command to execute
     SHrimpState state = {0};      // shell state
-    ParseCode parsecode;          // enum used to handle errors while parsing commands
-
-    // Allocate memory for cmd
-    cmd.args = safe_malloc(MAX_ARGS * sizeof(char *), "cmd.args");
+    InputSource source;           // where lines of input are read from
+    ScriptCache cache;            // compiled form of a script run from the script cache
+    const char *script = NULL;    // path of the script file being run, NULL if none
+    int cached = 0;               // flag for if lines are loaded from cache instead of source
+    StartupProfile profile = {0}; // time spent in every phase of startup
 
-    // Set up handler to catch child processes in order to prevent zombies
-    signal(SIGCHLD, sig_handler);
+    // Run as the spawn server of another SHrimp process, see spawn_server_start()
+    if(argc == 3 && strcmp(argv[1], "--spawn-server") == 0)
+        return spawn_server_main(atoi(argv[2]));
 
-    // Init shell state
-    state.job_number = 1;
+    if(argc > 1 && strcmp(argv[1], "--startup-profile") == 0) {
+        profile.enabled = 1;
+        argv++;
+        argc--;
+    }
+    profile_start(&profile);
 
-    // Main loop of SHrimp
-    while(1) {
-        // Reset for new loop iteration
-        commands.command_amt = 0;
-        reset_vars(&cmd, &pipeline);
-        
-        // Obtain user input
-        input = get_input(display);
-        if(input == NULL){
-            if(errno == EINTR) {
-                display = 0;
-                clearerr(stdin);
-                continue;
-            }
-            break;
+    // Select the input source
+    if(argc > 1 && strcmp(argv[1], "-c") == 0) {
+        if(argc < 3) {
+            fprintf(stderr, RED_TEXT "SHrimp: -c: option requires an argument" RESET_COLOR "\n");
+            return 2;
+        }
+        input_open_string(&source, argv[2]);
+    } else if(argc > 1 && argv[1][0] == '-') {
+        fprintf(stderr, RED_TEXT "SHrimp: %s: invalid option" RESET_COLOR "\n", argv[1]);
+        fprintf(stderr, "Usage: shrimp [--startup-profile] [-c command | script]\n");
+        return 2;
+    } else if(argc > 1) {
+        if(input_open_file(&source, argv[1]) < 0) {
+            fprintf(stderr, RED_TEXT "SHrimp: %s: %s" RESET_COLOR "\n", argv[1], strerror(errno));
+            return 127;
         }
+        script = argv[1];
+    } else {
+        input_open_stdin(&source, &state.prompt);
+    }
+    profile_mark(&profile, "source");
 
-        // Parse raw input for semi-colons to determine if there are multiple commands to execute
-        parsecode = parse_commands(input, &commands);
-        
-        display = 1;
-
-        // Parse, check redirection and piping, and then execute each command in commands
-        for(int i = 0; i < commands.command_amt; i++) {
-            reset_vars(&cmd, &pipeline);
-
-            // Parse user input
-            parsecode = parse_input(commands.commands[i], &cmd);
-
-            // Continue if the user pressed enter or if the command is delayed
-            if(cmd.args[0] == NULL)
-                continue; 
-
-            // Error handling for certain parsecode values
-            switch(parsecode) {
-                case PARSE_INVALID_DELAY:
-                    fprintf(stderr, RED_TEXT "Error: invalid delay amount. Must be a positive integer\n" RESET_COLOR);
-                    continue;
-                case PARSE_DELAY_OUT_OF_RANGE:
-                    fprintf(stderr, RED_TEXT "Error: delay amount out of range.\n" RESET_COLOR);
-                    continue;
-                case PARSE_NEGATIVE_DELAY:
-                    fprintf(stderr, RED_TEXT "Error: delay amount cannot be less than 0.\n" RESET_COLOR);
-                    continue;
-                default:
-                    break;
-            }
+    // Run a script from its compiled form if the script cache is enabled
+    if(script != NULL) {
+        cached = script_cache_open(&cache, script, &source) == 0;
+        profile_mark(&profile, "cache");
+    }
 
-            // Scan cmd before it is passed off to pipeline for built-in commands
-            for(int j = 0; cmd.args[j] != NULL; j++) {
-                if(strcmp(cmd.args[j], "cd") == 0 || strcmp(cmd.args[j], "exit") == 0) {
-                    if(j != 0) { // short-circuit to the next loop iteration if built-in not in the first index
-                        fprintf(stderr, RED_TEXT "Error: the built-in commands 'cd' and 'exit' must be the first token of a given command.\n" RESET_COLOR);
-                        continue;
-                    }
-                    cmd.has_builtin = 1; // true
-                }
-            }
+    arena_init(&state.arena, ARENA_BLOCK_SIZE);
 
-            // Parse cmd for pipes
-            parsecode = check_piping(&cmd, &pipeline);
+    // Reap children through the job table instead of a SIGCHLD handler, taking control of
+    // the terminal when interactive
+    jobs_init(&state, source.interactive);
+    events_init(&state.events);
+    profile_mark(&profile, "jobs");
 
-            if(parsecode == PARSE_INVALID_PIPE) {
-                fprintf(stderr, RED_TEXT "Pipe error: A pipe cannot begin or end a line\n" RESET_COLOR);
-                continue;
-            } else if(parsecode == PARSE_CMD_OUT_OF_RANGE) {
-                // Should probably be removed and replaced with dynamic buffer size using realloc()
-                fprintf(stderr, RED_TEXT "Error: Too many commands\n" RESET_COLOR);
-            }
+    // Init shell state
+    state.spawn_engine = SPAWN_POSIX;
 
-            // Check for redirection for each command in the pipeline
-            check_redirection(&pipeline);
-
-            // Execute the built-in commands cd or exit here if there are no pipes or redirection characters
-            // If there are pipes or redirection, print an error message and continue to the next loop iteration
-            if(pipeline.has_builtin == 1) {
-                if(pipeline.has_pipe || pipeline.has_redirect) {
-                    fprintf(stderr, RED_TEXT "Error: cannot contain pipes or redirection alongside a built-in command\n" RESET_COLOR);
-                    continue;
-                }
-
-                // Check if the built-in is cd and call cd() if so. Otherwise exit
-                if(strcmp(pipeline.commands[0]->args[0], "cd") == 0) {
-                    cd(pipeline.commands[0]->args);
-                    continue;
-                } else {
-                    exit(0); // will exit if a line is "exit 1 2 3", needs addressed
-                }
-            }
-            
-            // Execute the full command pipeline
-            exec_pipeline(&pipeline, &state); 
+    // Allow the spawn engine to be selected through the environment, e.g. SHRIMP_SPAWN=fork
+    char *engine = getenv("SHRIMP_SPAWN");
+    if(engine != NULL) {
+        state.spawn_engine = spawn_engine_from_name(engine);
+        if(state.spawn_engine == SPAWN_INVALID) {
+            fprintf(stderr, RED_TEXT "Error: unknown spawn engine '%s', using posix_spawn\n" RESET_COLOR, engine);
+            state.spawn_engine = SPAWN_POSIX;
         }
     }
-    
-    // Free allocated heap memory
-    free(cmd.args);
-    for(int i = 0; i < MAX_ARGS; i++) {
-        free(pipeline.commands[i]);
+
+    // Start the spawn server once the shell has its process group and signal dispositions,
+    // which the server inherits along with the working directory
+    state.server.sock = -1;
+    if(state.spawn_engine == SPAWN_SERVER && spawn_server_start(&state) < 0)
+        state.spawn_engine = SPAWN_POSIX;
+    profile_mark(&profile, "spawn");
+
+    // Allow every pipe to be resized through the environment, e.g. SHRIMP_PIPEBUF=1M
+    char *pipebuf = getenv("SHRIMP_PIPEBUF");
+    if(pipebuf != NULL)
+        set_option(&state, "pipebuf", pipebuf);
+
+    // Allow foreground pipelines to report their pipes through the environment, e.g.
+    // SHRIMP_PIPESTAT=0.5 for a report every half a second
+    char *pipestat = getenv("SHRIMP_PIPESTAT");
+    if(pipestat != NULL)
+        set_option(&state, "pipestat", pipestat);
+
+    // Allow tracing to be enabled through the environment, e.g. SHRIMP_TRACE=1
+    char *trace = getenv("SHRIMP_TRACE");
+    if(trace != NULL && strcmp(trace, "0") != 0) {
+#ifdef SHRIMP_TRACE
+        state.trace.enabled = 1;
+#else
+        fprintf(stderr, RED_TEXT "SHrimp: SHRIMP_TRACE is set, but tracing is not compiled in. Rebuild with make TRACE=1" RESET_COLOR "\n");
+#endif
     }
 
-    return 0;
-}
+    // Allow the job log to be set through the environment, e.g. SHRIMP_JOBLOG=3
+    char *joblog = getenv("SHRIMP_JOBLOG");
+    if(joblog != NULL)
+        set_option(&state, "joblog", joblog);
 
-//======================================================================================
+    // Allow background pipelines to be placed in a cgroup through the environment, e.g.
+    // SHRIMP_CGROUP=shrimp.slice/batch
+    state.cgroup_fd = -1;
+    char *cgroup = getenv("SHRIMP_CGROUP");
+    if(cgroup != NULL)
+        set_option(&state, "cgroup", cgroup);
+    profile_mark(&profile, "options");
 
-/**
- * @brief Resets the values of all variables when starting a new iteration in the main
- * shell loop.
- *
- * @param cmd Pointer to the SHrimpCommand struct variable to reset named cmd.
- */
-void reset_vars(SHrimpCommand *cmd, Pipeline *pipeline) {
-    cmd->index = -1;
-    cmd->outdex = -1;
-    cmd->appenddex = -1;
-    cmd->background = 0;
-    cmd->input_redirect = 0;
-    cmd->output_redirect = 0;
-    cmd->append_redirect = 0;
-    cmd->has_builtin = 0;
-    errno = 0;
-
-    for(int i = 0; i < MAX_ARGS; i++) {
-        cmd->args[i] = NULL;
+    // Record every line of an interactive session in the command history, which is only
+    // opened once the first prompt is due
+    state.history.fd = -1;
+    if(source.interactive)
+        source.history = &state.history;
+
+    // Edit the lines of an interactive session with the line editor, completing from the
+    // command hash table's view of $PATH
+    if(source.interactive && editor_supported()) {
+        state.editor.history = source.history;
+        state.editor.hash = &state.hash;
+        state.editor.events = &state.events;
+        state.editor.state = &state;
+        source.editor = &state.editor;
     }
+    profile_mark(&profile, "terminal");
 
-    pipeline->has_builtin = 0;
-    pipeline->background = 0;
-    pipeline->has_redirect = 0;
-    pipeline->has_pipe = 0;
-    pipeline->command_amt = 0;
-}
+    if(profile.enabled)
+        profile_dump(&profile, stderr);
 
-//======================================================================================
+    // Main loop of SHrimp
+    while(1) {
+        // Reset for new loop iteration, releasing everything parsed from the previous line
+        arena_reset(&state.arena);
 
-/**
- * @brief Prevents zombie process buildup.
- *
- * @param signo SIGCHLD
- */
-void sig_handler(int signo) {
-    signal(SIGCHLD, sig_handler);
+        // Collect background jobs that finished since the last line
+        jobs_notify(&state);
+        
+        // A script from the script cache skips reading and parsing its lines altogether
+        if(cached) {
+            Commands commands;
+            ParseCode parsecode;
+            TRACE_DECLARE(load_start);
+            TRACE_START(&state, load_start);
+            int loaded = script_cache_next(&cache, &commands, &state.arena, &parsecode);
+            TRACE_STOP(&state, TRACE_PARSE, load_start);
+            if(!loaded)
+                break;
+
+            if(parsecode != PARSE_OK) {
+                print_parse_error(parsecode);
+                state.last_status = 2;
+            } else {
+                run_commands(&commands, &state);
+            }
+            continue;
+        }
+
+        // Obtain the next line of input
+        TRACE_DECLARE(input_start);
+        TRACE_START(&state, input_start);
+        input = input_next_line(&source);
+        TRACE_STOP(&state, TRACE_INPUT, input_start);
+        if(input == NULL)
+            break;
+
+        run_line(input, &source, &state);
+    }
+    
+#ifdef SHRIMP_TRACE
+    // Dump the latency histograms of the session
+    if(state.trace.enabled)
+        trace_dump(&state.trace, stderr);
+#endif
 
-    // Suppress compilation warning message
-    (void)signo; 
+    // Free allocated heap memory
+    editor_free(&state.editor);
+    hash_clear(&state.hash);
+    spawn_server_stop(&state);
+    cgroup_close(&state);
+    numa_free(&state.numa);
+    events_free(&state.events);
+    jobs_free(&state);
+    arena_free(&state.arena);
+    input_close(&source);
+    if(cached)
+        script_cache_close(&cache);
+    free_input();
+    prompt_free(&state.prompt);
+    history_close(&state.history);
 
-    // Prevent zombie process buildup
-    while(waitpid(-1, NULL, WNOHANG) > 0);
+    return state.last_status;
 }
 
-//======================================================================================
\ No newline at end of file
+//======================================================================================
@@ -0,0 +1,696 @@
+/* cache.c
+ *
+ * Contains the compiled script cache of SHrimp, which stores the parsed pipelines of a
+ * script in a file that later runs of the same script map instead of parsing it again.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/types.h>     // size_t, ssize_t
+#include <sys/stat.h>      // struct stat, stat(), fstat(), mkdir()
+#include <sys/mman.h>      // mmap(), munmap()
+#include <fcntl.h>         // open(), O_RDONLY, O_RDWR, O_WRONLY, O_CREAT, O_EXCL, O_CLOEXEC
+#include <unistd.h>        // write(), close(), ftruncate(), unlink(), getpid()
+#include <stdio.h>         // printf(), snprintf(), fprintf(), rename(), stderr
+#include <stdlib.h>        // getenv(), realpath(), free()
+#include <string.h>        // strcmp(), strlen(), memcpy(), memset()
+#include <stdint.h>        // uint32_t, uint64_t
+#include "config/macros.h" // ARENA_BLOCK_SIZE, SCRIPT_CACHE_*, CACHE_*, BENCH_MAX_RUNS, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // ScriptCache, CacheHeader, CacheLine, CachePipeline, CacheCommand, CacheStats, ListCondition
+#include "utils/utils.h"   // safe_malloc()
+#include "utils/arena.h"   // arena_init(), arena_alloc(), arena_reset(), arena_free()
+#include "exec/builtins.h" // builtin_at()
+#include "parse/parse.h"   // parse_line(), parse_heredocs()
+#include "parse/input.h"   // input_next_line()
+#include "parse/cache.h"
+
+// A growable section of a script being compiled, see script_compile()
+typedef struct {
+    char *data;   // bytes of the section
+    size_t len;   // bytes in use
+    size_t cap;   // size of data
+} CacheSection;
+
+//======================================================================================
+
+/**
+ * @brief Hashes a block of memory, such as the contents of a script.
+ *
+ * @param data the memory to hash.
+ * @param len the length of data in bytes.
+ *
+ * @return The 64 bit hash of data.
+ *
+ * @details Eight bytes are mixed in per multiplication, so hashing a script costs far less
+ * than parsing it.
+ */
+static uint64_t hash_bytes(const void *data, size_t len) {
+    const unsigned char *p = data;
+    uint64_t hash = 0x9e3779b97f4a7c15ULL ^ len;
+
+    for(; len >= 8; p += 8, len -= 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        hash = (hash ^ word) * 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 32;
+    }
+    for(; len > 0; p++, len--)
+        hash = (hash ^ *p) * 0x100000001b3ULL;
+
+    return hash ^ (hash >> 33);
+}
+
+//======================================================================================
+
+/**
+ * @brief Computes a fingerprint of the names of the built-in dispatch table, which the
+ * built-in indexes of a compiled script refer to.
+ *
+ * @return The fingerprint of the table.
+ */
+static uint32_t builtins_fingerprint(void) {
+    uint32_t hash = 2166136261u;
+    const Builtin *builtin;
+
+    for(size_t i = 0; (builtin = builtin_at(i)) != NULL; i++) {
+        for(const char *c = builtin->name; ; c++) {
+            hash = (hash ^ (unsigned char)*c) * 16777619u;
+            if(*c == '\0')
+                break;
+        }
+    }
+
+    return hash;
+}
+
+//======================================================================================
+
+/**
+ * @brief Returns the directory of the script cache.
+ *
+ * @return $SHRIMP_SCRIPT_CACHE, or NULL if it is unset or empty and the cache is disabled.
+ */
+static const char *cache_dir(void) {
+    const char *dir = getenv("SHRIMP_SCRIPT_CACHE");
+    return dir != NULL && dir[0] != '\0' ? dir : NULL;
+}
+
+//======================================================================================
+
+/**
+ * @brief Maps the stats file of a cache directory, creating it if needed.
+ *
+ * @param dir the cache directory.
+ *
+ * @return The shared mapping of the counters, to be released with munmap(), or NULL if the
+ * stats file cannot be used.
+ */
+static CacheStats *stats_map(const char *dir) {
+    char path[4096];
+    if((size_t)snprintf(path, sizeof(path), "%s/%s", dir, SCRIPT_CACHE_STATS) >= sizeof(path))
+        return NULL;
+
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if(fd < 0)
+        return NULL;
+
+    // Growing a file only ever appends zeros, so shells racing to create it agree
+    struct stat sb;
+    if(fstat(fd, &sb) < 0 || (sb.st_size < (off_t)sizeof(CacheStats) && ftruncate(fd, sizeof(CacheStats)) < 0)) {
+        close(fd);
+        return NULL;
+    }
+
+    CacheStats *stats = mmap(NULL, sizeof(CacheStats), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    return stats == MAP_FAILED ? NULL : stats;
+}
+
+//======================================================================================
+
+/**
+ * @brief Counts a hit or a miss in the stats file of a cache directory.
+ *
+ * @param dir the cache directory.
+ * @param hit 1 to count a hit, 0 to count a miss.
+ *
+ * @details The counters are shared by every shell using the directory, so they are updated
+ * atomically within the shared mapping rather than rewritten.
+ */
+static void stats_count(const char *dir, int hit) {
+    CacheStats *stats = stats_map(dir);
+    if(stats == NULL)
+        return;
+
+    __atomic_add_fetch(hit ? &stats->hits : &stats->misses, 1, __ATOMIC_RELAXED);
+    munmap(stats, sizeof(CacheStats));
+}
+
+//======================================================================================
+
+/**
+ * @brief Points every section of a compiled script into its image.
+ *
+ * @param cache ScriptCache object whose image and len are set.
+ *
+ * @return 0 on success, -1 if the image is too short for its header or its sections do not
+ * add up to its length.
+ */
+static int cache_layout(ScriptCache *cache) {
+    if(cache->len < sizeof(CacheHeader))
+        return -1;
+
+    const CacheHeader *header = (const CacheHeader *)cache->image;
+    size_t expected = sizeof(CacheHeader) + (size_t)header->line_amt * sizeof(CacheLine) +
+                      (size_t)header->pipeline_amt * sizeof(CachePipeline) +
+                      (size_t)header->command_amt * sizeof(CacheCommand) +
+                      (size_t)header->arg_amt * sizeof(uint32_t) + header->string_len;
+    if(expected != cache->len)
+        return -1;
+
+    char *p = cache->image + sizeof(CacheHeader);
+    cache->header = header;
+    cache->lines = (const CacheLine *)p;
+    p += (size_t)header->line_amt * sizeof(CacheLine);
+    cache->pipelines = (const CachePipeline *)p;
+    p += (size_t)header->pipeline_amt * sizeof(CachePipeline);
+    cache->commands = (const CacheCommand *)p;
+    p += (size_t)header->command_amt * sizeof(CacheCommand);
+    cache->args = (const uint32_t *)p;
+    p += (size_t)header->arg_amt * sizeof(uint32_t);
+    cache->strings = p;
+    cache->next = 0;
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Checks that every index and offset of a compiled script stays within its image.
+ *
+ * @param cache ScriptCache object to check, already laid out by cache_layout().
+ *
+ * @return 0 if the compiled script is sound, -1 if it is damaged.
+ *
+ * @details A cache file may be truncated or written by anything, so it is checked once as a
+ * whole before any of it is used. Every string offset is within the strings, which end in a
+ * null character, so every string is terminated.
+ */
+static int cache_check(const ScriptCache *cache) {
+    const CacheHeader *header = cache->header;
+
+    if(header->string_len == 0 || cache->strings[header->string_len - 1] != '\0' || header->path >= header->string_len)
+        return -1;
+
+    for(uint32_t i = 0; i < header->line_amt; i++) {
+        const CacheLine *line = &cache->lines[i];
+        if((uint64_t)line->first_pipeline + line->pipeline_amt > header->pipeline_amt)
+            return -1;
+        if(line->code != PARSE_OK && line->pipeline_amt != 0)
+            return -1;
+    }
+
+    for(uint32_t i = 0; i < header->pipeline_amt; i++) {
+        const CachePipeline *pipeline = &cache->pipelines[i];
+        if(pipeline->command_amt == 0 || (uint64_t)pipeline->first_command + pipeline->command_amt > header->command_amt)
+            return -1;
+        if(pipeline->condition < LIST_ALWAYS || pipeline->condition > LIST_OR)
+            return -1;
+        if((pipeline->flags & CACHE_BENCH) && (pipeline->bench_runs < 1 || pipeline->bench_runs > BENCH_MAX_RUNS ||
+           pipeline->bench_warmup < 0 || pipeline->bench_warmup > BENCH_MAX_RUNS))
+            return -1;
+    }
+
+    for(uint32_t i = 0; i < header->command_amt; i++) {
+        const CacheCommand *cmd = &cache->commands[i];
+        if(cmd->arg_amt == 0 || (uint64_t)cmd->first_arg + cmd->arg_amt > header->arg_amt)
+            return -1;
+        if((cmd->infile != CACHE_NONE && cmd->infile >= header->string_len) ||
+           (cmd->outfile != CACHE_NONE && cmd->outfile >= header->string_len) ||
+           (cmd->here != CACHE_NONE && (uint64_t)cmd->here + cmd->here_len >= header->string_len))
+            return -1;
+        if(cmd->builtin != -1 && (cmd->builtin < 0 || builtin_at(cmd->builtin) == NULL))
+            return -1;
+    }
+
+    for(uint32_t i = 0; i < header->arg_amt; i++) {
+        if(cache->args[i] >= header->string_len)
+            return -1;
+    }
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Maps the compiled form of a script from its cache file.
+ *
+ * @param cache ScriptCache object to load into.
+ * @param file the cache file of the script.
+ * @param key header the compiled script has to match, holding the size, modification time
+ * and hash of the script as it is now.
+ * @param path the absolute path of the script.
+ *
+ * @return 0 on a hit, -1 if there is no usable cache file for the script as it is now.
+ *
+ * @details The file is mapped privately and used in place, so no record or string is
+ * copied or parsed. The args of every loaded command point straight into the mapping.
+ */
+static int cache_load(ScriptCache *cache, const char *file, const CacheHeader *key, const char *path) {
+    int fd = open(file, O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+        return -1;
+
+    struct stat sb;
+    if(fstat(fd, &sb) < 0 || sb.st_size < (off_t)sizeof(CacheHeader)) {
+        close(fd);
+        return -1;
+    }
+
+    char *image = mmap(NULL, sb.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(image == MAP_FAILED)
+        return -1;
+
+    cache->image = image;
+    cache->len = sb.st_size;
+    cache->mapped = 1;
+
+    const CacheHeader *header = (const CacheHeader *)image;
+    if(memcmp(header->magic, key->magic, sizeof(header->magic)) != 0 || header->version != key->version ||
+       header->builtins != key->builtins || header->script_size != key->script_size ||
+       header->mtime_sec != key->mtime_sec || header->mtime_nsec != key->mtime_nsec ||
+       header->script_hash != key->script_hash || cache_layout(cache) < 0 || cache_check(cache) < 0 ||
+       strcmp(cache->strings + header->path, path) != 0) {
+        script_cache_close(cache);
+        return -1;
+    }
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Appends bytes to a section of a script being compiled.
+ *
+ * @param section CacheSection object to append to.
+ * @param data the bytes to append.
+ * @param len the amount of bytes to append.
+ *
+ * @return The offset of the appended bytes within the section.
+ */
+static uint32_t section_append(CacheSection *section, const void *data, size_t len) {
+    if(section->len + len > section->cap) {
+        size_t cap = section->cap ? section->cap : ARENA_BLOCK_SIZE;
+        while(cap < section->len + len)
+            cap *= 2;
+        char *grown = safe_malloc(cap, "script cache: section");
+        if(section->len > 0)
+            memcpy(grown, section->data, section->len);
+        free(section->data);
+        section->data = grown;
+        section->cap = cap;
+    }
+
+    memcpy(section->data + section->len, data, len);
+    section->len += len;
+
+    return (uint32_t)(section->len - len);
+}
+
+//======================================================================================
+
+/**
+ * @brief Appends a null terminated string to the strings of a script being compiled.
+ *
+ * @param strings CacheSection object holding the strings.
+ * @param str the string to append, NULL for none.
+ *
+ * @return The offset of the string, or CACHE_NONE if str is NULL.
+ */
+static uint32_t section_string(CacheSection *strings, const char *str) {
+    return str == NULL ? CACHE_NONE : section_append(strings, str, strlen(str) + 1);
+}
+
+//======================================================================================
+
+/**
+ * @brief Parses every line of a script into the image of its cache file.
+ *
+ * @param cache ScriptCache object the image is stored in.
+ * @param source InputSource object of the script, read until it is exhausted.
+ * @param key header of the image, holding the size, modification time and hash of the
+ * script.
+ * @param path the absolute path of the script.
+ *
+ * @details Every line is parsed exactly as running it would, into an arena reset after each
+ * line, and its pipelines are appended to the sections of the image. Lines without any
+ * pipeline, such as comments, are left out, while a malformed line keeps its ParseCode so
+ * its error is still reported once it is reached. The body of a here-doc is compiled into
+ * the strings along with its command, so its lines never become lines of their own.
+ */
+static void script_compile(ScriptCache *cache, InputSource *source, const CacheHeader *key, const char *path) {
+    CacheSection sections[5] = {0};  // lines, pipelines, commands, args and strings
+    CacheHeader header = *key;
+    Arena scratch;
+    char *line;
+
+    arena_init(&scratch, ARENA_BLOCK_SIZE);
+    header.path = section_string(&sections[4], path);
+
+    for(; (line = input_next_line(source)) != NULL; arena_reset(&scratch)) {
+        Commands cmds;
+        ParseCode code = parse_line(line, &cmds, &scratch);
+        if(code == PARSE_OK && cmds.heredoc_amt > 0)
+            code = parse_heredocs(&cmds, source, &scratch);
+        if(code == PARSE_OK && cmds.command_amt == 0)
+            continue;
+
+        CacheLine record = { code, header.pipeline_amt, code == PARSE_OK ? cmds.command_amt : 0 };
+        section_append(&sections[0], &record, sizeof(record));
+        header.line_amt++;
+
+        for(uint32_t i = 0; i < record.pipeline_amt; i++) {
+            Pipeline *pipeline = cmds.commands[i];
+            CachePipeline pipeline_record = { header.command_amt, pipeline->command_amt,
+                (pipeline->background ? CACHE_BACKGROUND : 0) | (pipeline->has_pipe ? CACHE_PIPE : 0) |
+                (pipeline->has_redirect ? CACHE_REDIRECT : 0) | (pipeline->has_builtin ? CACHE_BUILTIN : 0) |
+                (pipeline->timed ? CACHE_TIMED : 0) | (pipeline->parallel ? CACHE_PARALLEL : 0) |
+                (pipeline->prio ? CACHE_PRIO : 0) | (pipeline->pin ? CACHE_PIN : 0) |
+                (pipeline->has_status ? CACHE_STATUS : 0) | (pipeline->bench ? CACHE_BENCH : 0) |
+                (pipeline->bench_json ? CACHE_BENCH_JSON : 0), pipeline->nice, pipeline->ioprio, pipeline->pin_node,
+                pipeline->condition, pipeline->bench_runs, pipeline->bench_warmup };
+            section_append(&sections[1], &pipeline_record, sizeof(pipeline_record));
+            header.pipeline_amt++;
+
+            for(int j = 0; j < pipeline->command_amt; j++) {
+                SHrimpCommand *cmd = pipeline->commands[j];
+                CacheCommand cmd_record = { header.arg_amt, cmd->arg_amt,
+                    section_string(&sections[4], cmd->infile), section_string(&sections[4], cmd->outfile),
+                    section_string(&sections[4], cmd->here), (uint32_t)cmd->here_len,
+                    (cmd->input_redirect ? CACHE_INPUT_REDIRECT : 0) | (cmd->output_redirect ? CACHE_OUTPUT_REDIRECT : 0) |
+                    (cmd->append_redirect ? CACHE_APPEND_REDIRECT : 0) | (cmd->has_status ? CACHE_STATUS_ARGS : 0),
+                    cmd->builtin != NULL ? (int32_t)(cmd->builtin - builtin_at(0)) : -1 };
+                section_append(&sections[2], &cmd_record, sizeof(cmd_record));
+                header.command_amt++;
+
+                for(int k = 0; k < cmd->arg_amt; k++) {
+                    uint32_t offset = section_string(&sections[4], cmd->args[k]);
+                    section_append(&sections[3], &offset, sizeof(offset));
+                    header.arg_amt++;
+                }
+            }
+        }
+    }
+    header.string_len = sections[4].len;
+    arena_free(&scratch);
+
+    // Lay the sections out one after another behind the header, exactly as in the file
+    cache->len = sizeof(header);
+    for(int i = 0; i < 5; i++)
+        cache->len += sections[i].len;
+    cache->image = safe_malloc(cache->len, "script cache: image");
+    cache->mapped = 0;
+
+    memcpy(cache->image, &header, sizeof(header));
+    size_t offset = sizeof(header);
+    for(int i = 0; i < 5; i++) {
+        if(sections[i].len > 0)
+            memcpy(cache->image + offset, sections[i].data, sections[i].len);
+        offset += sections[i].len;
+        free(sections[i].data);
+    }
+    cache_layout(cache);
+}
+
+//======================================================================================
+
+/**
+ * @brief Writes the image of a compiled script to its cache file.
+ *
+ * @param cache ScriptCache object holding the image.
+ * @param dir the cache directory, created if it does not exist yet.
+ * @param file the cache file of the script.
+ *
+ * @details The image is written to a temporary file that is then renamed over the cache
+ * file, so a shell mapping the cache file never sees it half written. Failing to write the
+ * cache only costs the next run its hit.
+ */
+static void cache_store(const ScriptCache *cache, const char *dir, const char *file) {
+    char tmp[4096];
+    if((size_t)snprintf(tmp, sizeof(tmp), "%s.%d.tmp", file, (int)getpid()) >= sizeof(tmp))
+        return;
+
+    mkdir(dir, 0700);
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if(fd < 0)
+        return;
+
+    size_t written = 0;
+    while(written < cache->len) {
+        ssize_t n = write(fd, cache->image + written, cache->len - written);
+        if(n <= 0)
+            break;
+        written += n;
+    }
+
+    if(close(fd) < 0 || written < cache->len || rename(tmp, file) < 0)
+        unlink(tmp);
+}
+
+//======================================================================================
+
+/**
+ * @brief Opens the compiled form of a script, from the script cache if it holds the script
+ * as it is now, otherwise by compiling the script and storing it in the cache.
+ *
+ * @param cache ScriptCache object to open.
+ * @param path the path of the script, as given to the shell.
+ * @param source InputSource object of the script, opened by input_open_file(). It is read
+ * to its end when the script has to be compiled.
+ *
+ * @return 0 if the script runs from cache, -1 if the cache is disabled or cannot be used for
+ * this script, in which case the script is run from source as usual.
+ *
+ * @details The cache is enabled by setting $SHRIMP_SCRIPT_CACHE to a directory. The cache
+ * file holding a script is named after the hash of its absolute path and is only used if
+ * its path, size, modification time and content hash all match the script, and it was
+ * compiled by the same parser and built-in table. Every run counts a hit or a miss in the
+ * stats file of the directory, reported by the scriptcache built-in.
+ */
+int script_cache_open(ScriptCache *cache, const char *path, InputSource *source) {
+    *cache = (ScriptCache){0};
+
+    const char *dir = cache_dir();
+    if(dir == NULL || source->len > UINT32_MAX / 2)
+        return -1;
+
+    struct stat sb;
+    char *real = realpath(path, NULL);
+    if(real == NULL || stat(real, &sb) < 0) {
+        free(real);
+        return -1;
+    }
+
+    char file[4096];
+    if((size_t)snprintf(file, sizeof(file), "%s/%016llx.shc", dir, (unsigned long long)hash_bytes(real, strlen(real))) >= sizeof(file)) {
+        free(real);
+        return -1;
+    }
+
+    CacheHeader key = {0};
+    memcpy(key.magic, SCRIPT_CACHE_MAGIC, sizeof(key.magic));
+    key.version = SCRIPT_CACHE_VERSION;
+    key.builtins = builtins_fingerprint();
+    key.script_size = source->len;
+    key.mtime_sec = sb.st_mtim.tv_sec;
+    key.mtime_nsec = sb.st_mtim.tv_nsec;
+    key.script_hash = hash_bytes(source->buf, source->len);
+
+    int hit = cache_load(cache, file, &key, real) == 0;
+    if(!hit) {
+        script_compile(cache, source, &key, real);
+        cache_store(cache, dir, file);
+    }
+    stats_count(dir, hit);
+    free(real);
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Loads the next line of a compiled script.
+ *
+ * @param cache ScriptCache object to read from.
+ * @param cmds Commands object the pipelines of the line are stored in.
+ * @param arena Arena object owning the loaded pipelines, reset before the next line.
+ * @param code where the ParseCode of the line is stored. The line holds no pipeline unless
+ * it is PARSE_OK.
+ *
+ * @return 1 if a line was loaded, 0 once the script is exhausted.
+ *
+ * @details Only the Pipeline and SHrimpCommand structures the executor works on are built,
+ * out of the arena. Every arg and file name points straight into the compiled script.
+ */
+int script_cache_next(ScriptCache *cache, Commands *cmds, Arena *arena, ParseCode *code) {
+    if(cache->next >= cache->header->line_amt)
+        return 0;
+
+    const CacheLine *line = &cache->lines[cache->next++];
+    *code = line->code;
+    cmds->command_amt = line->pipeline_amt;
+    cmds->command_cap = line->pipeline_amt;
+    cmds->commands = NULL;
+    if(line->pipeline_amt == 0)
+        return 1;
+
+    cmds->commands = arena_alloc(arena, line->pipeline_amt * sizeof(Pipeline *));
+    Pipeline *pipelines = arena_alloc(arena, line->pipeline_amt * sizeof(Pipeline));
+    for(uint32_t i = 0; i < line->pipeline_amt; i++) {
+        const CachePipeline *record = &cache->pipelines[line->first_pipeline + i];
+        Pipeline *pipeline = &pipelines[i];
+
+        *pipeline = (Pipeline){0};
+        pipeline->command_amt = record->command_amt;
+        pipeline->command_cap = record->command_amt;
+        pipeline->background = (record->flags & CACHE_BACKGROUND) != 0;
+        pipeline->has_pipe = (record->flags & CACHE_PIPE) != 0;
+        pipeline->has_redirect = (record->flags & CACHE_REDIRECT) != 0;
+        pipeline->has_builtin = (record->flags & CACHE_BUILTIN) != 0;
+        pipeline->timed = (record->flags & CACHE_TIMED) != 0;
+        pipeline->parallel = (record->flags & CACHE_PARALLEL) != 0;
+        pipeline->prio = (record->flags & CACHE_PRIO) != 0;
+        pipeline->nice = record->nice;
+        pipeline->ioprio = record->ioprio;
+        pipeline->pin = (record->flags & CACHE_PIN) != 0;
+        pipeline->pin_node = record->pin_node;
+        pipeline->condition = (ListCondition)record->condition;
+        pipeline->has_status = (record->flags & CACHE_STATUS) != 0;
+        pipeline->bench = (record->flags & CACHE_BENCH) != 0;
+        pipeline->bench_json = (record->flags & CACHE_BENCH_JSON) != 0;
+        pipeline->bench_runs = record->bench_runs;
+        pipeline->bench_warmup = record->bench_warmup;
+        pipeline->commands = arena_alloc(arena, record->command_amt * sizeof(SHrimpCommand *));
+
+        SHrimpCommand *commands = arena_alloc(arena, record->command_amt * sizeof(SHrimpCommand));
+        for(uint32_t j = 0; j < record->command_amt; j++) {
+            const CacheCommand *cmd_record = &cache->commands[record->first_command + j];
+            SHrimpCommand *cmd = &commands[j];
+
+            *cmd = (SHrimpCommand){0};
+            cmd->arg_amt = cmd_record->arg_amt;
+            cmd->arg_cap = cmd_record->arg_amt;
+            cmd->args = arena_alloc(arena, (cmd_record->arg_amt + 1) * sizeof(char *));
+            for(uint32_t k = 0; k < cmd_record->arg_amt; k++)
+                cmd->args[k] = cache->strings + cache->args[cmd_record->first_arg + k];
+            cmd->args[cmd->arg_amt] = NULL;
+
+            cmd->input_redirect = (cmd_record->flags & CACHE_INPUT_REDIRECT) != 0;
+            cmd->output_redirect = (cmd_record->flags & CACHE_OUTPUT_REDIRECT) != 0;
+            cmd->append_redirect = (cmd_record->flags & CACHE_APPEND_REDIRECT) != 0;
+            cmd->has_status = (cmd_record->flags & CACHE_STATUS_ARGS) != 0;
+            cmd->infile = cmd_record->infile != CACHE_NONE ? cache->strings + cmd_record->infile : NULL;
+            cmd->outfile = cmd_record->outfile != CACHE_NONE ? cache->strings + cmd_record->outfile : NULL;
+            cmd->here = cmd_record->here != CACHE_NONE ? cache->strings + cmd_record->here : NULL;
+            cmd->here_len = cmd_record->here_len;
+            cmd->builtin = cmd_record->builtin >= 0 ? builtin_at(cmd_record->builtin) : NULL;
+            pipeline->commands[j] = cmd;
+        }
+        cmds->commands[i] = pipeline;
+    }
+
+    return 1;
+}
+
+//======================================================================================
+
+/**
+ * @brief Releases a compiled script.
+ *
+ * @param cache ScriptCache object to close.
+ */
+void script_cache_close(ScriptCache *cache) {
+    if(cache->mapped)
+        munmap(cache->image, cache->len);
+    else
+        free(cache->image);
+    *cache = (ScriptCache){0};
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command scriptcache, which reports how often scripts ran
+ * from the script cache.
+ *
+ * @param args 2D char array containing the command and all its arguments. With no
+ * arguments the hits, misses and hit rate of the cache directory are printed, and -r
+ * resets them.
+ * @param state SHrimpState object, unused.
+ *
+ * @return 0 on success, 1 if the option is invalid or the cache is disabled.
+ */
+int scriptcache_builtin(char **args, SHrimpState *state) {
+    (void)state;
+
+    if(args[1] != NULL && (strcmp(args[1], "-r") != 0 || args[2] != NULL)) {
+        fprintf(stderr, RED_TEXT "scriptcache: %s: invalid option" RESET_COLOR "\n", args[1]);
+        fprintf(stderr, "Usage: scriptcache [-r]\n");
+        return 1;
+    }
+
+    const char *dir = cache_dir();
+    if(dir == NULL) {
+        fprintf(stderr, RED_TEXT "scriptcache: the script cache is disabled, set SHRIMP_SCRIPT_CACHE to a directory" RESET_COLOR "\n");
+        return 1;
+    }
+
+    // Reading the counters should not leave a directory behind if none exists yet
+    struct stat sb;
+    if(stat(dir, &sb) < 0) {
+        printf("hits: 0\nmisses: 0\nhit rate: 0.0%%\n");
+        return 0;
+    }
+
+    CacheStats *stats = stats_map(dir);
+    if(stats == NULL) {
+        fprintf(stderr, RED_TEXT "scriptcache: %s: cannot open the stats file" RESET_COLOR "\n", dir);
+        return 1;
+    }
+
+    if(args[1] != NULL) {
+        __atomic_store_n(&stats->hits, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&stats->misses, 0, __ATOMIC_RELAXED);
+    } else {
+        uint64_t hits = __atomic_load_n(&stats->hits, __ATOMIC_RELAXED);
+        uint64_t misses = __atomic_load_n(&stats->misses, __ATOMIC_RELAXED);
+        printf("hits: %llu\nmisses: %llu\nhit rate: %.1f%%\n", (unsigned long long)hits, (unsigned long long)misses,
+               hits + misses > 0 ? 100.0 * hits / (hits + misses) : 0.0);
+    }
+    munmap(stats, sizeof(CacheStats));
+
+    return 0;
+}
+
+//======================================================================================
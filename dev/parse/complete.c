@@ -0,0 +1,472 @@
+/* complete.c
+ *
+ * Contains the TAB completion of SHrimp. Command names are completed from a prefix trie of
+ * every executable in $PATH, built in the background and refreshed one directory at a time,
+ * while file names are completed from the directory being typed.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/stat.h>      // struct stat, stat(), fstat(), fstatat(), S_ISREG(), S_ISDIR()
+#include <dirent.h>        // DIR, struct dirent, opendir(), readdir(), closedir(), dirfd(), DT_DIR
+#include <pthread.h>       // pthread_create(), pthread_join()
+#include <limits.h>        // NAME_MAX
+#include <stdlib.h>        // free()
+#include <string.h>        // strchr(), strlen(), strcmp(), strncmp(), memchr(), memcpy()
+#include "config/macros.h" // TRIE_INITIAL_NODES, COMPLETE_MAX_DIRS, COMPLETE_BUILTIN_SOURCE
+#include "types/types.h"   // Completer, Trie, TrieNode, CompleteDir, CommandHash, Builtin
+#include "utils/utils.h"   // safe_malloc(), safe_strdup()
+#include "exec/hash.h"     // hash_path()
+#include "exec/builtins.h" // builtin_at()
+#include "parse/complete.h"
+
+//======================================================================================
+
+/**
+ * @brief Appends a new node to the trie.
+ *
+ * @param trie Trie object to grow.
+ * @param c the character of the node.
+ *
+ * @return The index of the new node.
+ */
+static int trie_node(Trie *trie, char c) {
+    if(trie->node_amt == trie->node_cap) {
+        int cap = trie->node_cap > 0 ? trie->node_cap * 2 : TRIE_INITIAL_NODES;
+        TrieNode *nodes = safe_malloc(cap * sizeof(TrieNode), "complete: trie");
+        if(trie->node_amt > 0)
+            memcpy(nodes, trie->nodes, trie->node_amt * sizeof(TrieNode));
+        free(trie->nodes);
+        trie->nodes = nodes;
+        trie->node_cap = cap;
+    }
+
+    trie->nodes[trie->node_amt] = (TrieNode){ c, -1, -1, 0 };
+    return trie->node_amt++;
+}
+
+//======================================================================================
+
+/**
+ * @brief Adds a name to the trie.
+ *
+ * @param trie Trie object to add to.
+ * @param name the null terminated name to add.
+ * @param source the bit of the source holding the name.
+ *
+ * @details Siblings are kept in character order, so walking the trie visits names in
+ * sorted order.
+ */
+static void trie_insert(Trie *trie, const char *name, unsigned long long source) {
+    int node = 0;
+    for(const char *c = name; *c != '\0'; c++) {
+        int prev = -1;
+        int child = trie->nodes[node].child;
+        while(child >= 0 && (unsigned char)trie->nodes[child].c < (unsigned char)*c) {
+            prev = child;
+            child = trie->nodes[child].sibling;
+        }
+
+        // Nodes are referred to by index, since trie_node() can move them
+        if(child < 0 || trie->nodes[child].c != *c) {
+            int created = trie_node(trie, *c);
+            trie->nodes[created].sibling = child;
+            if(prev < 0)
+                trie->nodes[node].child = created;
+            else
+                trie->nodes[prev].sibling = created;
+            child = created;
+        }
+        node = child;
+    }
+
+    trie->nodes[node].sources |= source;
+}
+
+//======================================================================================
+
+/**
+ * @brief Returns the bit standing for a $PATH directory in the sources of a trie node.
+ *
+ * @param index the index of the directory in $PATH.
+ *
+ * @return The bit of the directory. Directories past COMPLETE_MAX_DIRS share the last bit.
+ */
+static unsigned long long dir_source(int index) {
+    return 1ULL << (index < COMPLETE_MAX_DIRS ? index : COMPLETE_MAX_DIRS - 1);
+}
+
+//======================================================================================
+
+/**
+ * @brief Adds every executable of a $PATH directory to the trie.
+ *
+ * @param completer Completer object holding the trie and the directory.
+ * @param index the index of the directory in $PATH.
+ *
+ * @details The modification time of the directory is taken before it is read, so an
+ * executable added while it is being read changes the time again and is picked up by the
+ * next refresh.
+ */
+static void complete_scan_dir(Completer *completer, int index) {
+    CompleteDir *dir = &completer->dirs[index];
+    dir->mtime = (struct timespec){0, 0};
+
+    DIR *stream = opendir(dir->path);
+    if(stream == NULL)
+        return;
+
+    struct stat sb;
+    if(fstat(dirfd(stream), &sb) == 0)
+        dir->mtime = sb.st_mtim;
+
+    unsigned long long source = dir_source(index);
+    struct dirent *entry;
+    while((entry = readdir(stream)) != NULL) {
+        if(entry->d_name[0] == '.' || entry->d_type == DT_DIR)
+            continue;
+        if(fstatat(dirfd(stream), entry->d_name, &sb, 0) == 0 && S_ISREG(sb.st_mode) && (sb.st_mode & 0111))
+            trie_insert(&completer->trie, entry->d_name, source);
+    }
+    closedir(stream);
+}
+
+//======================================================================================
+
+/**
+ * @brief Builds the trie from scratch out of the built-in commands and every $PATH
+ * directory.
+ *
+ * @param arg Completer object to build, whose path_env is already set.
+ *
+ * @return NULL.
+ *
+ * @details Runs on the background thread for the first build, while the main thread does
+ * not touch the Completer until it has joined the thread. Empty $PATH entries stand for
+ * the working directory and are not completed from.
+ */
+static void *complete_build(void *arg) {
+    Completer *completer = arg;
+
+    completer->trie.node_amt = 0;
+    trie_node(&completer->trie, '\0');
+
+    const Builtin *builtin;
+    for(size_t i = 0; (builtin = builtin_at(i)) != NULL; i++)
+        trie_insert(&completer->trie, builtin->name, COMPLETE_BUILTIN_SOURCE);
+
+    int dir_amt = 1;
+    for(const char *c = completer->path_env; *c != '\0'; c++)
+        dir_amt += *c == ':';
+    completer->dirs = safe_malloc(dir_amt * sizeof(CompleteDir), "complete: dirs");
+    completer->dir_amt = 0;
+
+    for(const char *dir = completer->path_env; dir != NULL;) {
+        const char *end = strchr(dir, ':');
+        size_t len = end != NULL ? (size_t)(end - dir) : strlen(dir);
+        if(len > 0) {
+            char *path = safe_malloc(len + 1, "complete: dir");
+            memcpy(path, dir, len);
+            completer->dirs[completer->dir_amt].path = path;
+            complete_scan_dir(completer, completer->dir_amt++);
+        }
+        dir = end != NULL ? end + 1 : NULL;
+    }
+
+    return NULL;
+}
+
+//======================================================================================
+
+/**
+ * @brief Releases the trie and the directories it was built from.
+ *
+ * @param completer Completer object whose trie is released.
+ */
+static void complete_clear(Completer *completer) {
+    for(int i = 0; i < completer->dir_amt; i++)
+        free(completer->dirs[i].path);
+    free(completer->dirs);
+    free(completer->trie.nodes);
+    free(completer->path_env);
+    completer->dirs = NULL;
+    completer->dir_amt = 0;
+    completer->trie = (Trie){0};
+    completer->path_env = NULL;
+}
+
+//======================================================================================
+
+/**
+ * @brief Starts building the trie on a background thread, unless it was already started.
+ *
+ * @param completer Completer object to build.
+ * @param hash CommandHash object whose $PATH and invalidation the trie shares.
+ *
+ * @details Called once the first prompt is shown rather than at startup, so the shell
+ * starts just as fast, while the build is usually done by the time TAB is first pressed.
+ * If no thread can be created, the trie is built on the first TAB instead.
+ */
+void complete_start(Completer *completer, CommandHash *hash) {
+    if(completer->started)
+        return;
+    completer->started = 1;
+
+    completer->path_env = safe_strdup(hash_path(hash), "complete: path_env");
+    completer->generation = hash->generation;
+    completer->building = pthread_create(&completer->thread, NULL, complete_build, completer) == 0;
+    if(!completer->building)
+        complete_build(completer);
+}
+
+//======================================================================================
+
+/**
+ * @brief Brings the trie up to date before it is searched.
+ *
+ * @param completer Completer object to bring up to date.
+ * @param hash CommandHash object whose $PATH and invalidation the trie shares.
+ *
+ * @details Waits for the background build if it is still running. The trie is rebuilt
+ * whenever the command hash table was cleared since it was built, which happens when $PATH
+ * changes or on hash -r. Otherwise only the directories whose modification time changed
+ * are scanned again, after removing their bit from every node, so an install into a
+ * single directory costs one stat() per $PATH directory and one scan.
+ */
+static void complete_refresh(Completer *completer, CommandHash *hash) {
+    complete_start(completer, hash);
+    if(completer->building) {
+        pthread_join(completer->thread, NULL);
+        completer->building = 0;
+    }
+
+    const char *path_env = hash_path(hash);
+    if(completer->generation != hash->generation) {
+        complete_clear(completer);
+        completer->path_env = safe_strdup(path_env, "complete: path_env");
+        completer->generation = hash->generation;
+        complete_build(completer);
+        return;
+    }
+
+    for(int i = 0; i < completer->dir_amt; i++) {
+        struct stat sb;
+        struct timespec mtime = stat(completer->dirs[i].path, &sb) == 0 ? sb.st_mtim : (struct timespec){0, 0};
+        if(mtime.tv_sec == completer->dirs[i].mtime.tv_sec && mtime.tv_nsec == completer->dirs[i].mtime.tv_nsec)
+            continue;
+
+        unsigned long long source = dir_source(i);
+        for(int n = 0; n < completer->trie.node_amt; n++)
+            completer->trie.nodes[n].sources &= ~source;
+
+        // Directories sharing the last bit are scanned again together
+        complete_scan_dir(completer, i);
+        for(int j = COMPLETE_MAX_DIRS - 1; i >= COMPLETE_MAX_DIRS - 1 && j < completer->dir_amt; j++) {
+            if(j != i)
+                complete_scan_dir(completer, j);
+        }
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Appends a match to the matches of the current completion.
+ *
+ * @param completer Completer object holding the matches.
+ * @param head the first part of the match.
+ * @param head_len the length of head.
+ * @param tail the rest of the match, null terminated.
+ * @param slash flag for if a / is appended to the match, e.g. for a directory.
+ */
+static void match_add(Completer *completer, const char *head, size_t head_len, const char *tail, int slash) {
+    size_t tail_len = strlen(tail);
+    size_t len = head_len + tail_len + (slash ? 1 : 0) + 1;
+    if(completer->match_len + len > completer->match_cap) {
+        size_t cap = completer->match_cap > 0 ? completer->match_cap * 2 : 4096;
+        while(cap < completer->match_len + len)
+            cap *= 2;
+        char *matches = safe_malloc(cap, "complete: matches");
+        if(completer->match_len > 0)
+            memcpy(matches, completer->matches, completer->match_len);
+        free(completer->matches);
+        completer->matches = matches;
+        completer->match_cap = cap;
+    }
+
+    char *out = completer->matches + completer->match_len;
+    memcpy(out, head, head_len);
+    memcpy(out + head_len, tail, tail_len);
+    if(slash)
+        out[head_len + tail_len] = '/';
+    out[len - 1] = '\0';
+    completer->match_len += len;
+    completer->match_amt++;
+}
+
+//======================================================================================
+
+/**
+ * @brief Adds every name below a trie node to the matches.
+ *
+ * @param completer Completer object holding the trie and the matches.
+ * @param node the node to walk.
+ * @param name buffer holding the name up to node.
+ * @param depth the length of the name up to node.
+ */
+static void trie_collect(Completer *completer, int node, char *name, size_t depth) {
+    for(int child = completer->trie.nodes[node].child; child >= 0; child = completer->trie.nodes[child].sibling) {
+        if(depth >= NAME_MAX)
+            return;
+        name[depth] = completer->trie.nodes[child].c;
+        name[depth + 1] = '\0';
+        if(completer->trie.nodes[child].sources != 0)
+            match_add(completer, name, depth + 1, "", 0);
+        trie_collect(completer, child, name, depth + 1);
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Finds every command name starting with a prefix.
+ *
+ * @param completer Completer object to search.
+ * @param hash CommandHash object whose $PATH and invalidation the trie shares.
+ * @param prefix the prefix typed so far.
+ * @param len the length of prefix.
+ */
+static void complete_commands(Completer *completer, CommandHash *hash, const char *prefix, size_t len) {
+    complete_refresh(completer, hash);
+    if(len > NAME_MAX)
+        return;
+
+    int node = 0;
+    for(size_t i = 0; i < len && node >= 0; i++) {
+        int child = completer->trie.nodes[node].child;
+        while(child >= 0 && completer->trie.nodes[child].c != prefix[i])
+            child = completer->trie.nodes[child].sibling;
+        node = child;
+    }
+    if(node < 0)
+        return;
+
+    char name[NAME_MAX + 2];
+    memcpy(name, prefix, len);
+    name[len] = '\0';
+    if(len > 0 && completer->trie.nodes[node].sources != 0)
+        match_add(completer, name, len, "", 0);
+    trie_collect(completer, node, name, len);
+}
+
+//======================================================================================
+
+/**
+ * @brief Finds every file name starting with the word being typed.
+ *
+ * @param completer Completer object holding the matches.
+ * @param word the word typed so far, possibly including directories.
+ * @param len the length of word.
+ *
+ * @details Only the single directory being typed is read. Hidden files are only matched
+ * once the name being typed starts with a dot, and directories are matched with a
+ * trailing /.
+ */
+static void complete_files(Completer *completer, const char *word, size_t len) {
+    const char *slash = NULL;
+    for(size_t i = 0; i < len; i++) {
+        if(word[i] == '/')
+            slash = word + i;
+    }
+
+    size_t dir_len = slash != NULL ? (size_t)(slash - word) + 1 : 0;
+    char dir[4096];
+    if(dir_len >= sizeof(dir))
+        return;
+    memcpy(dir, dir_len > 0 ? word : ".", dir_len > 0 ? dir_len : 1);
+    dir[dir_len > 0 ? dir_len : 1] = '\0';
+
+    const char *base = word + dir_len;
+    size_t base_len = len - dir_len;
+
+    DIR *stream = opendir(dir);
+    if(stream == NULL)
+        return;
+
+    struct dirent *entry;
+    while((entry = readdir(stream)) != NULL) {
+        if(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            continue;
+        if(entry->d_name[0] == '.' && (base_len == 0 || base[0] != '.'))
+            continue;
+        if(strncmp(entry->d_name, base, base_len) != 0)
+            continue;
+
+        int is_dir = entry->d_type == DT_DIR;
+        struct stat sb;
+        if(entry->d_type == DT_LNK || entry->d_type == DT_UNKNOWN)
+            is_dir = fstatat(dirfd(stream), entry->d_name, &sb, 0) == 0 && S_ISDIR(sb.st_mode);
+        match_add(completer, word, dir_len, entry->d_name, is_dir);
+    }
+    closedir(stream);
+}
+
+//======================================================================================
+
+/**
+ * @brief Finds every completion of the word being typed.
+ *
+ * @param completer Completer object to search.
+ * @param hash CommandHash object whose $PATH and invalidation the trie shares.
+ * @param word the word typed so far.
+ * @param len the length of word.
+ * @param command flag for if the word is in the position of a command name.
+ *
+ * @return The amount of matches, which are stored one after another in completer->matches.
+ *
+ * @details A command name is completed from the trie unless it holds a /, in which case it
+ * is completed as a file name like every other word.
+ */
+int complete_word(Completer *completer, CommandHash *hash, const char *word, size_t len, int command) {
+    completer->match_len = 0;
+    completer->match_amt = 0;
+
+    if(command && memchr(word, '/', len) == NULL)
+        complete_commands(completer, hash, word, len);
+    else
+        complete_files(completer, word, len);
+
+    return completer->match_amt;
+}
+
+//======================================================================================
+
+/**
+ * @brief Releases everything held by the completion, waiting for the background build.
+ *
+ * @param completer Completer object to free.
+ */
+void complete_free(Completer *completer) {
+    if(completer->building)
+        pthread_join(completer->thread, NULL);
+    complete_clear(completer);
+    free(completer->matches);
+    *completer = (Completer){0};
+}
+
+//======================================================================================
@@ -0,0 +1,32 @@
+/* complete.h
+ *
+ * Header file for complete.c
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef COMPLETE_H
+#define COMPLETE_H
+
+#include "types/types.h"
+
+void complete_start(Completer *completer, CommandHash *hash);
+int complete_word(Completer *completer, CommandHash *hash, const char *word, size_t len, int command);
+void complete_free(Completer *completer);
+
+#endif
@@ -0,0 +1,699 @@
+/* editor.c
+ *
+ * Contains the line editor of interactive SHrimp sessions, which reads the terminal in raw
+ * mode to support cursor movement, history browsing and search, and TAB completion.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/ioctl.h>     // ioctl(), struct winsize, TIOCGWINSZ
+#include <termios.h>       // tcgetattr(), tcsetattr(), TCSADRAIN
+#include <unistd.h>        // read(), write(), STDIN_FILENO, STDOUT_FILENO
+#include <stdio.h>         // snprintf(), fflush(), stdout
+#include <stdlib.h>        // getenv(), free()
+#include <string.h>        // strcmp(), strchr(), strlen(), memcpy(), memmove()
+#include <errno.h>         // errno, EINTR
+#include "config/macros.h" // COMPLETE_LIST_MAX, EVENT_INPUT, EVENT_CHILD
+#include "types/types.h"   // Editor, Prompt, History, Completer, EventLoop
+#include "utils/utils.h"   // safe_malloc(), safe_strdup()
+#include "parse/prompt.h"  // prompt_update()
+#include "parse/history.h" // history_sync(), history_entry(), history_search()
+#include "parse/complete.h" // complete_start(), complete_word(), complete_free()
+#include "exec/events.h"   // events_wait()
+#include "exec/jobs.h"     // jobs_finished(), jobs_notify()
+#include "parse/editor.h"
+
+// Keys the editor handles, as read from a terminal in raw mode
+#define KEY_CTRL(c) ((c) & 0x1f)
+#define KEY_ESC 27
+#define KEY_BACKSPACE 127
+
+//======================================================================================
+
+/**
+ * @brief Tells whether the terminal supports the line editor.
+ *
+ * @return 1 if the line editor can be used, 0 if lines must be read with getline().
+ *
+ * @details The editor relies on a few ANSI escape sequences, which dumb terminals lack.
+ */
+int editor_supported(void) {
+    const char *term = getenv("TERM");
+    return term != NULL && term[0] != '\0' && strcmp(term, "dumb") != 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Writes a buffer to the terminal in full.
+ *
+ * @param data the bytes to write.
+ * @param len the amount of bytes to write.
+ */
+static void term_write(const char *data, size_t len) {
+    for(size_t written = 0; written < len;) {
+        ssize_t put = write(STDOUT_FILENO, data + written, len - written);
+        if(put < 0 && errno != EINTR)
+            return;
+        if(put > 0)
+            written += put;
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Returns the width of the terminal.
+ *
+ * @return The amount of columns of the terminal, or 80 if it cannot be determined.
+ */
+static size_t term_columns(void) {
+    struct winsize ws;
+    if(ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) < 0 || ws.ws_col == 0)
+        return 80;
+
+    return ws.ws_col;
+}
+
+//======================================================================================
+
+/**
+ * @brief Reads a single byte typed on the terminal.
+ *
+ * @return The byte read, or -1 once the terminal is closed.
+ */
+static int term_read(void) {
+    unsigned char c;
+    while(1) {
+        ssize_t got = read(STDIN_FILENO, &c, 1);
+        if(got == 1)
+            return c;
+        if(got < 0 && errno == EINTR)
+            continue;
+        return -1;
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Grows a buffer of the editor so it holds at least the provided size.
+ *
+ * @param buf the buffer to grow.
+ * @param cap the size of the buffer.
+ * @param size the size the buffer must hold.
+ * @param used the amount of bytes of the buffer to keep.
+ */
+static void editor_grow(char **buf, size_t *cap, size_t size, size_t used) {
+    if(size <= *cap)
+        return;
+
+    size_t new_cap = *cap > 0 ? *cap : 256;
+    while(new_cap < size)
+        new_cap *= 2;
+    char *grown = safe_malloc(new_cap, "editor: buffer");
+    if(used > 0)
+        memcpy(grown, *buf, used);
+    free(*buf);
+    *buf = grown;
+    *cap = new_cap;
+}
+
+//======================================================================================
+
+/**
+ * @brief Appends bytes to the output buffer of the next refresh.
+ *
+ * @param ed Editor object holding the output buffer.
+ * @param used the amount of bytes in the output buffer.
+ * @param data the bytes to append.
+ * @param len the amount of bytes to append.
+ *
+ * @return The amount of bytes in the output buffer afterwards.
+ */
+static size_t out_append(Editor *ed, size_t used, const char *data, size_t len) {
+    editor_grow(&ed->out, &ed->out_cap, used + len, used);
+    memcpy(ed->out + used, data, len);
+
+    return used + len;
+}
+
+//======================================================================================
+
+/**
+ * @brief Draws the prompt and the line being edited, and places the cursor.
+ *
+ * @param ed Editor object to draw.
+ * @param prompt Prompt object displayed before the line.
+ *
+ * @details A line too long for the terminal scrolls sideways to keep the cursor in view.
+ * The whole line is drawn with a single write(), so it never flickers.
+ */
+static void editor_refresh(Editor *ed, Prompt *prompt) {
+    size_t cols = term_columns();
+    size_t avail = cols > prompt->width + 1 ? cols - prompt->width - 1 : 1;
+    size_t start = ed->pos >= avail ? ed->pos - avail + 1 : 0;
+    size_t show = ed->len - start < avail ? ed->len - start : avail;
+
+    char move[32];
+    size_t used = out_append(ed, 0, "\r", 1);
+    used = out_append(ed, used, prompt->text, prompt->len);
+    used = out_append(ed, used, ed->buf + start, show);
+    used = out_append(ed, used, "\033[K\r", 4);
+    int move_len = snprintf(move, sizeof(move), "\033[%zuC", prompt->width + ed->pos - start);
+    if(prompt->width + ed->pos - start > 0)
+        used = out_append(ed, used, move, move_len);
+
+    term_write(ed->out, used);
+}
+
+//======================================================================================
+
+/**
+ * @brief Waits until a key is typed, reporting every background job that finishes while
+ * the line is edited.
+ *
+ * @param ed Editor object waiting for a key.
+ * @param prompt Prompt object displayed before the line.
+ *
+ * @details The terminal and the signalfd are waited on together through the event loop, so
+ * a finished job is reported the moment it exits rather than once the next line is entered.
+ * The report replaces the line on screen, which is drawn again below it. Without an event
+ * loop, or if it fails, the next read() simply blocks.
+ */
+static void editor_wait(Editor *ed, Prompt *prompt) {
+    if(ed->events == NULL)
+        return;
+
+    while(1) {
+        int ready = events_wait(ed->events, STDIN_FILENO, ed->state->jobs.signal_fd);
+        if(ready < 0 || (ready & EVENT_INPUT))
+            return;
+
+        if((ready & EVENT_CHILD) && jobs_finished(ed->state) > 0) {
+            term_write("\r\033[K", 4);
+            jobs_notify(ed->state);
+            editor_refresh(ed, prompt);
+        }
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Replaces the line being edited, placing the cursor at its end.
+ *
+ * @param ed Editor object to modify.
+ * @param text the new line.
+ * @param len the length of text.
+ */
+static void editor_set(Editor *ed, const char *text, size_t len) {
+    editor_grow(&ed->buf, &ed->cap, len + 1, 0);
+    memmove(ed->buf, text, len);
+    ed->buf[len] = '\0';
+    ed->len = len;
+    ed->pos = len;
+}
+
+//======================================================================================
+
+/**
+ * @brief Inserts text at the cursor, moving the cursor past it.
+ *
+ * @param ed Editor object to modify.
+ * @param text the text to insert.
+ * @param len the length of text.
+ */
+static void editor_insert(Editor *ed, const char *text, size_t len) {
+    editor_grow(&ed->buf, &ed->cap, ed->len + len + 1, ed->len + 1);
+    memmove(ed->buf + ed->pos + len, ed->buf + ed->pos, ed->len - ed->pos + 1);
+    memcpy(ed->buf + ed->pos, text, len);
+    ed->len += len;
+    ed->pos += len;
+}
+
+//======================================================================================
+
+/**
+ * @brief Deletes the text between two offsets of the line, leaving the cursor at the first.
+ *
+ * @param ed Editor object to modify.
+ * @param from the offset of the first byte to delete.
+ * @param to the offset past the last byte to delete.
+ */
+static void editor_delete(Editor *ed, size_t from, size_t to) {
+    memmove(ed->buf + from, ed->buf + to, ed->len - to + 1);
+    ed->len -= to - from;
+    ed->pos = from;
+}
+
+//======================================================================================
+
+/**
+ * @brief Shows an older or a newer history entry in place of the line being edited.
+ *
+ * @param ed Editor object to modify.
+ * @param older 1 to show the previous entry, 0 to show the next one.
+ *
+ * @return 0 on success, -1 if there is no such entry.
+ *
+ * @details The line being edited is kept aside when browsing starts and shown again when
+ * browsing past the newest entry. The history is brought up to date when browsing starts,
+ * so entries of other sessions sharing the history file show up as well.
+ */
+static int editor_browse(Editor *ed, int older) {
+    History *hist = ed->history;
+    if(hist == NULL)
+        return -1;
+
+    if(ed->saved == NULL) {
+        if(!older)
+            return -1;
+        history_sync(hist);
+        ed->saved = safe_strdup(ed->buf, "editor: saved line");
+        ed->hist_pos = hist->count;
+    }
+
+    if(older && ed->hist_pos == 0)
+        return -1;
+    ed->hist_pos += older ? -1 : 1;
+
+    if(ed->hist_pos >= hist->count) {
+        editor_set(ed, ed->saved, strlen(ed->saved));
+        free(ed->saved);
+        ed->saved = NULL;
+        return 0;
+    }
+
+    size_t len;
+    const char *entry = history_entry(hist, ed->hist_pos, &len);
+    editor_set(ed, entry, len);
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Runs an incremental reverse search of the history, started by Ctrl-R.
+ *
+ * @param ed Editor object the found entry is placed in.
+ * @param prompt Prompt object displayed again once the search ends.
+ *
+ * @return 1 if the search was ended with Enter, so the found entry must run right away,
+ * otherwise 0.
+ *
+ * @details Typing refines the search, Ctrl-R moves on to an older match and Backspace
+ * shortens the search. Ctrl-C or Ctrl-G cancel the search, leaving the line as it was,
+ * while any other key ends it with the found entry in place of the line.
+ */
+static int editor_search(Editor *ed, Prompt *prompt) {
+    History *hist = ed->history;
+    if(hist == NULL) {
+        term_write("\a", 1);
+        return 0;
+    }
+    history_sync(hist);
+
+    char needle[256];
+    size_t needle_len = 0;
+    long match = -1;
+    needle[0] = '\0';
+
+    while(1) {
+        size_t entry_len = 0;
+        const char *entry = match >= 0 ? history_entry(hist, match, &entry_len) : "";
+        size_t cols = term_columns();
+
+        size_t used = out_append(ed, 0, "\r(reverse-i-search)`", 20);
+        used = out_append(ed, used, needle, needle_len);
+        used = out_append(ed, used, "': ", 3);
+        size_t room = cols > used ? cols - used : 0;
+        used = out_append(ed, used, entry, entry_len < room ? entry_len : room);
+        used = out_append(ed, used, "\033[K", 3);
+        term_write(ed->out, used);
+
+        int c = term_read();
+        if(c == KEY_CTRL('c') || c == KEY_CTRL('g')) {
+            break;
+        } else if(c == KEY_CTRL('r')) {
+            long older = needle_len > 0 && match >= 0 ? history_search(hist, needle, match) : -1;
+            if(older >= 0)
+                match = older;
+            else
+                term_write("\a", 1);
+        } else if(c == KEY_BACKSPACE || c == KEY_CTRL('h')) {
+            if(needle_len > 0)
+                needle[--needle_len] = '\0';
+            match = needle_len > 0 ? history_search(hist, needle, hist->count) : -1;
+        } else if(c >= ' ' && c != KEY_BACKSPACE && needle_len < sizeof(needle) - 1) {
+            needle[needle_len++] = c;
+            needle[needle_len] = '\0';
+            long found = history_search(hist, needle, match >= 0 ? match + 1 : hist->count);
+            if(found >= 0)
+                match = found;
+            else
+                term_write("\a", 1);
+        } else {
+            if(match >= 0)
+                editor_set(ed, entry, entry_len);
+            editor_refresh(ed, prompt);
+            return c == '\r' || c == '\n';
+        }
+    }
+
+    editor_refresh(ed, prompt);
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Lists the matches of a completion below the line being edited.
+ *
+ * @param ed Editor object holding the matches.
+ * @param skip the amount of leading bytes of every match not to show, e.g. its directory.
+ *
+ * @details Matches are laid out in as many columns as the terminal fits, and overly long
+ * listings are cut short.
+ */
+static void editor_list(Editor *ed, size_t skip) {
+    Completer *completer = &ed->completer;
+    size_t widest = 0;
+    int shown = completer->match_amt < COMPLETE_LIST_MAX ? completer->match_amt : COMPLETE_LIST_MAX;
+
+    const char *match = completer->matches;
+    for(int i = 0; i < shown; i++, match += strlen(match) + 1) {
+        if(strlen(match) - skip > widest)
+            widest = strlen(match) - skip;
+    }
+
+    size_t per_row = term_columns() / (widest + 2);
+    if(per_row == 0)
+        per_row = 1;
+
+    size_t used = out_append(ed, 0, "\n", 1);
+    match = completer->matches;
+    for(int i = 0; i < shown; i++, match += strlen(match) + 1) {
+        size_t len = strlen(match) - skip;
+        used = out_append(ed, used, match + skip, len);
+        if((size_t)(i + 1) % per_row == 0 || i == shown - 1) {
+            used = out_append(ed, used, "\n", 1);
+        } else {
+            for(size_t pad = len; pad < widest + 2; pad++)
+                used = out_append(ed, used, " ", 1);
+        }
+    }
+    if(shown < completer->match_amt) {
+        char more[64];
+        int more_len = snprintf(more, sizeof(more), "... and %d more\n", completer->match_amt - shown);
+        used = out_append(ed, used, more, more_len);
+    }
+
+    term_write(ed->out, used);
+}
+
+//======================================================================================
+
+/**
+ * @brief Completes the word before the cursor, as requested by TAB.
+ *
+ * @param ed Editor object to complete in.
+ *
+ * @details The first word of a command is completed as a command name, every other word
+ * as a file name. A single match is inserted in full, followed by a space unless it is a
+ * directory. Several matches are completed as far as they agree, and are listed once they
+ * cannot be completed any further.
+ */
+static void editor_complete(Editor *ed) {
+    static const char separators[] = " \t|;&<>";
+
+    size_t word_start = ed->pos;
+    while(word_start > 0 && strchr(separators, ed->buf[word_start - 1]) == NULL)
+        word_start--;
+    size_t before = word_start;
+    while(before > 0 && (ed->buf[before - 1] == ' ' || ed->buf[before - 1] == '\t'))
+        before--;
+    int command = before == 0 || strchr("|;&", ed->buf[before - 1]) != NULL;
+
+    const char *word = ed->buf + word_start;
+    size_t word_len = ed->pos - word_start;
+    int amount = complete_word(&ed->completer, ed->hash, word, word_len, command);
+    const char *matches = ed->completer.matches;
+
+    if(amount == 0) {
+        term_write("\a", 1);
+        return;
+    }
+
+    if(amount == 1) {
+        size_t len = strlen(matches);
+        editor_insert(ed, matches + word_len, len - word_len);
+        if(matches[len - 1] != '/')
+            editor_insert(ed, " ", 1);
+        return;
+    }
+
+    // Find how far every match agrees
+    size_t common = strlen(matches);
+    for(const char *match = matches + common + 1; match < matches + ed->completer.match_len; match += strlen(match) + 1) {
+        size_t i = 0;
+        while(i < common && match[i] == matches[i])
+            i++;
+        common = i;
+    }
+
+    if(common > word_len) {
+        char *prefix = safe_malloc(common - word_len, "editor: completion");
+        memcpy(prefix, matches + word_len, common - word_len);
+        editor_insert(ed, prefix, common - word_len);
+        free(prefix);
+        return;
+    }
+
+    // Only show the part of each file name after the directory typed
+    int files = !command || memchr(word, '/', word_len) != NULL;
+    size_t skip = 0;
+    for(size_t i = 0; files && i < word_len; i++) {
+        if(word[i] == '/')
+            skip = i + 1;
+    }
+    editor_list(ed, skip);
+}
+
+//======================================================================================
+
+/**
+ * @brief Reads the remainder of an escape sequence and turns it into the matching key.
+ *
+ * @return The control key with the same meaning, e.g. KEY_CTRL('b') for the left arrow, or 0
+ * for sequences the editor does not handle.
+ */
+static int editor_escape(void) {
+    int c = term_read();
+    if(c != '[' && c != 'O')
+        return 0;
+
+    int key = term_read();
+    if(key >= '0' && key <= '9') {
+        int end = term_read();
+        while(end >= '0' && end <= '9')
+            end = term_read();
+        if(end != '~')
+            return 0;
+        if(key == '1' || key == '7')
+            return KEY_CTRL('a');
+        if(key == '4' || key == '8')
+            return KEY_CTRL('e');
+        if(key == '3')
+            return KEY_CTRL('d');
+        return 0;
+    }
+
+    switch(key) {
+        case 'A': return KEY_CTRL('p');
+        case 'B': return KEY_CTRL('n');
+        case 'C': return KEY_CTRL('f');
+        case 'D': return KEY_CTRL('b');
+        case 'H': return KEY_CTRL('a');
+        case 'F': return KEY_CTRL('e');
+        default:  return 0;
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Reads a line from the terminal, letting the user edit it first.
+ *
+ * @param ed Editor object to read with.
+ * @param prompt Prompt object displayed before the line.
+ *
+ * @return The null terminated line, owned by the editor and only valid until the next
+ * call, or NULL once the terminal is closed or Ctrl-D is typed on an empty line.
+ *
+ * @details The terminal is in raw mode only while the line is edited and is handed back in
+ * its previous modes before the line runs. Supported keys are the arrows, Home, End,
+ * Delete and Backspace, Ctrl-A, Ctrl-E, Ctrl-B, Ctrl-F, Ctrl-K, Ctrl-U, Ctrl-W and Ctrl-L
+ * for editing, Up, Down, Ctrl-P, Ctrl-N and Ctrl-R for the history, TAB for completion and
+ * Ctrl-C to discard the line. Background jobs finishing meanwhile are reported right away,
+ * above the line. Once the first prompt is on screen, the completion trie
+ * starts building in the background, so it never delays the prompt and is ready by the
+ * first TAB.
+ */
+char *editor_read_line(Editor *ed, Prompt *prompt) {
+    prompt_update(prompt);
+    fflush(stdout);
+
+    editor_set(ed, "", 0);
+    free(ed->saved);
+    ed->saved = NULL;
+
+    int raw_mode = tcgetattr(STDIN_FILENO, &ed->cooked) == 0;
+    if(raw_mode) {
+        struct termios raw = ed->cooked;
+        raw.c_iflag &= ~(ICRNL | IXON | BRKINT | INPCK | ISTRIP);
+        raw.c_lflag &= ~(ECHO | ICANON | ISIG | IEXTEN);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        raw_mode = tcsetattr(STDIN_FILENO, TCSADRAIN, &raw) == 0;
+    }
+    editor_refresh(ed, prompt);
+    complete_start(&ed->completer, ed->hash);
+
+    char *line = ed->buf;
+    while(1) {
+        editor_wait(ed, prompt);
+        int c = term_read();
+        if(c == KEY_ESC)
+            c = editor_escape();
+
+        if(c < 0) {
+            line = NULL;
+            break;
+        }
+
+        if(c == '\r' || c == '\n') {
+            ed->pos = ed->len;
+            editor_refresh(ed, prompt);
+            term_write("\n", 1);
+            break;
+        }
+
+        switch(c) {
+            case KEY_CTRL('d'):
+                if(ed->len == 0) {
+                    term_write("\n", 1);
+                    line = NULL;
+                    goto done;
+                }
+                if(ed->pos < ed->len)
+                    editor_delete(ed, ed->pos, ed->pos + 1);
+                break;
+            case KEY_CTRL('c'):
+                term_write("^C\n", 3);
+                editor_set(ed, "", 0);
+                free(ed->saved);
+                ed->saved = NULL;
+                break;
+            case KEY_BACKSPACE:
+            case KEY_CTRL('h'):
+                if(ed->pos > 0)
+                    editor_delete(ed, ed->pos - 1, ed->pos);
+                break;
+            case KEY_CTRL('a'):
+                ed->pos = 0;
+                break;
+            case KEY_CTRL('e'):
+                ed->pos = ed->len;
+                break;
+            case KEY_CTRL('b'):
+                if(ed->pos > 0)
+                    ed->pos--;
+                break;
+            case KEY_CTRL('f'):
+                if(ed->pos < ed->len)
+                    ed->pos++;
+                break;
+            case KEY_CTRL('k'):
+                editor_delete(ed, ed->pos, ed->len);
+                break;
+            case KEY_CTRL('u'):
+                editor_delete(ed, 0, ed->pos);
+                break;
+            case KEY_CTRL('w'): {
+                size_t from = ed->pos;
+                while(from > 0 && ed->buf[from - 1] == ' ')
+                    from--;
+                while(from > 0 && ed->buf[from - 1] != ' ')
+                    from--;
+                editor_delete(ed, from, ed->pos);
+                break;
+            }
+            case KEY_CTRL('l'):
+                term_write("\033[H\033[2J", 7);
+                break;
+            case KEY_CTRL('p'):
+            case KEY_CTRL('n'):
+                if(editor_browse(ed, c == KEY_CTRL('p')) < 0)
+                    term_write("\a", 1);
+                break;
+            case KEY_CTRL('r'):
+                if(editor_search(ed, prompt)) {
+                    ed->pos = ed->len;
+                    editor_refresh(ed, prompt);
+                    term_write("\n", 1);
+                    goto done;
+                }
+                break;
+            case '\t':
+                editor_complete(ed);
+                break;
+            default:
+                if(c >= ' ') {
+                    char byte = c;
+                    editor_insert(ed, &byte, 1);
+                }
+                break;
+        }
+        editor_refresh(ed, prompt);
+    }
+
+done:
+    if(raw_mode)
+        tcsetattr(STDIN_FILENO, TCSADRAIN, &ed->cooked);
+
+    return line;
+}
+
+//======================================================================================
+
+/**
+ * @brief Releases everything held by the editor.
+ *
+ * @param ed Editor object to free.
+ */
+void editor_free(Editor *ed) {
+    complete_free(&ed->completer);
+    free(ed->buf);
+    free(ed->saved);
+    free(ed->out);
+    *ed = (Editor){0};
+}
+
+//======================================================================================
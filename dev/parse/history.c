@@ -0,0 +1,353 @@
+/* history.c
+ *
+ * Contains the command history of SHrimp, an append-only file shared by every session that
+ * is mapped into memory and indexed only once it is first searched or listed.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/types.h>     // size_t
+#include <sys/stat.h>      // struct stat, fstat()
+#include <sys/mman.h>      // mmap(), mremap(), munmap(), MREMAP_MAYMOVE
+#include <sys/uio.h>       // writev(), struct iovec
+#include <fcntl.h>         // open(), O_RDWR, O_APPEND, O_CREAT, O_CLOEXEC
+#include <unistd.h>        // close()
+#include <stdio.h>         // printf(), snprintf(), fprintf(), stderr
+#include <stdlib.h>        // getenv(), strtol(), free()
+#include <string.h>        // strlen(), strcmp(), strspn(), memchr(), memcpy(), memmem()
+#include "config/macros.h" // HISTORY_FILE, HISTORY_BLOCK_ENTRIES, HISTORY_BLOOM_BYTES, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // History, SHrimpState
+#include "utils/utils.h"   // safe_malloc()
+#include "utils/arena.h"   // arena_alloc()
+#include "parse/history.h"
+
+//======================================================================================
+
+/**
+ * @brief Hashes the three characters starting at p into a bit of a trigram filter.
+ *
+ * @param p pointer to the first of the three characters.
+ *
+ * @return The index of the bit within a filter of HISTORY_BLOOM_BYTES bytes.
+ */
+static unsigned int trigram_bit(const char *p) {
+    unsigned int trigram = (unsigned char)p[0] << 16 | (unsigned char)p[1] << 8 | (unsigned char)p[2];
+    return (trigram * 2654435761u) % (HISTORY_BLOOM_BYTES * 8);
+}
+
+//======================================================================================
+
+/**
+ * @brief Opens the history file and maps it into memory.
+ *
+ * @param hist History object to open.
+ *
+ * @return 0 on success, -1 if there is no history file to use, in which case the session
+ * runs without history.
+ *
+ * @details The file is $SHRIMP_HISTFILE, or ~/.shrimp_history if that is unset, and an
+ * empty $SHRIMP_HISTFILE disables history. Opening only maps the file, without reading it,
+ * so startup takes the same time however long the history grows.
+ */
+int history_open(History *hist) {
+    char path[4096];
+    const char *file = getenv("SHRIMP_HISTFILE");
+    if(file == NULL) {
+        const char *home = getenv("HOME");
+        if(home == NULL || (size_t)snprintf(path, sizeof(path), "%s/%s", home, HISTORY_FILE) >= sizeof(path))
+            return -1;
+        file = path;
+    }
+    if(file[0] == '\0')
+        return -1;
+
+    hist->fd = open(file, O_RDWR | O_APPEND | O_CREAT | O_CLOEXEC, 0600);
+    if(hist->fd < 0)
+        return -1;
+
+    struct stat sb;
+    if(fstat(hist->fd, &sb) == 0 && sb.st_size > 0) {
+        void *map = mmap(NULL, sb.st_size, PROT_READ, MAP_SHARED, hist->fd, 0);
+        if(map != MAP_FAILED) {
+            hist->map = map;
+            hist->map_len = sb.st_size;
+        }
+    }
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Adds a single entry to the index.
+ *
+ * @param hist History object to add the entry to.
+ * @param offset the offset of the entry within the mapping.
+ * @param len the length of the entry, without its newline.
+ */
+static void history_index(History *hist, size_t offset, size_t len) {
+    if(hist->count == hist->cap) {
+        long cap = hist->cap > 0 ? hist->cap * 2 : HISTORY_BLOCK_ENTRIES * 32;
+        size_t *offsets = safe_malloc(cap * sizeof(size_t), "history: offsets");
+        unsigned char *blooms = safe_malloc(cap / HISTORY_BLOCK_ENTRIES * HISTORY_BLOOM_BYTES, "history: blooms");
+        if(hist->count > 0) {
+            memcpy(offsets, hist->offsets, hist->count * sizeof(size_t));
+            memcpy(blooms, hist->blooms, hist->count / HISTORY_BLOCK_ENTRIES * HISTORY_BLOOM_BYTES);
+        }
+        free(hist->offsets);
+        free(hist->blooms);
+        hist->offsets = offsets;
+        hist->blooms = blooms;
+        hist->cap = cap;
+    }
+
+    unsigned char *bloom = hist->blooms + hist->count / HISTORY_BLOCK_ENTRIES * HISTORY_BLOOM_BYTES;
+    const char *entry = hist->map + offset;
+    for(size_t i = 0; i + 2 < len; i++) {
+        unsigned int bit = trigram_bit(entry + i);
+        bloom[bit / 8] |= 1 << (bit % 8);
+    }
+
+    hist->offsets[hist->count++] = offset;
+}
+
+//======================================================================================
+
+/**
+ * @brief Brings the mapping and the index up to date with the history file.
+ *
+ * @param hist History object to update.
+ *
+ * @details Entries appended since the file was mapped, by this session or any other one
+ * sharing the file, are picked up by growing the mapping. Only the bytes past the end of
+ * the index are scanned, and a last line a concurrent session is still writing is left
+ * for the next update.
+ */
+void history_sync(History *hist) {
+    struct stat sb;
+    if(hist->fd < 0 || fstat(hist->fd, &sb) < 0)
+        return;
+
+    if((size_t)sb.st_size > hist->map_len) {
+        void *map = hist->map == NULL ? mmap(NULL, sb.st_size, PROT_READ, MAP_SHARED, hist->fd, 0)
+                                      : mremap((void *)hist->map, hist->map_len, sb.st_size, MREMAP_MAYMOVE);
+        if(map == MAP_FAILED)
+            return;
+        hist->map = map;
+        hist->map_len = sb.st_size;
+    }
+
+    while(hist->indexed < hist->map_len) {
+        const char *entry = hist->map + hist->indexed;
+        const char *newline = memchr(entry, '\n', hist->map_len - hist->indexed);
+        if(newline == NULL)
+            break;
+        if(newline > entry)
+            history_index(hist, hist->indexed, newline - entry);
+        hist->indexed += newline - entry + 1;
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Returns an entry of the history.
+ *
+ * @param hist History object holding the entry.
+ * @param index the index of the entry, 0 being the oldest.
+ * @param len where the length of the entry is stored.
+ *
+ * @return A pointer to the entry within the mapping. It is not null terminated.
+ */
+const char *history_entry(const History *hist, long index, size_t *len) {
+    size_t end = index + 1 < hist->count ? hist->offsets[index + 1] : hist->indexed;
+    const char *entry = hist->map + hist->offsets[index];
+
+    // Entries never include their newline, nor the empty lines skipped while indexing
+    while(end > hist->offsets[index] && hist->map[end - 1] == '\n')
+        end--;
+    *len = end - hist->offsets[index];
+
+    return entry;
+}
+
+//======================================================================================
+
+/**
+ * @brief Appends a line to the history.
+ *
+ * @param hist History object to append to.
+ * @param line the line to append.
+ *
+ * @details The line and its newline are appended with a single writev() to a file opened
+ * with O_APPEND, so each entry costs one system call and entries of concurrent sessions
+ * never interleave. Blank lines are not recorded.
+ */
+void history_add(History *hist, const char *line) {
+    if(hist->fd < 0 || line[strspn(line, " \t")] == '\0')
+        return;
+
+    struct iovec iov[2] = {
+        { (void *)line, strlen(line) },
+        { "\n", 1 }
+    };
+    if(writev(hist->fd, iov, 2) < 0)
+        return;
+}
+
+//======================================================================================
+
+/**
+ * @brief Finds the most recent entry containing a string.
+ *
+ * @param hist History object to search.
+ * @param needle the string to search for.
+ * @param before only entries older than this index are searched, e.g. the count of entries
+ * for a new search, or the previous match to continue one.
+ *
+ * @return The index of the matching entry, or -1 if none was found.
+ *
+ * @details Every block of entries keeps a filter of the trigrams within it, so for a needle
+ * of three or more characters, blocks that cannot hold a match are skipped without looking
+ * at their entries. Only the remaining blocks are searched with memmem(). Entries appended
+ * since the last history_sync() are not searched.
+ */
+long history_search(History *hist, const char *needle, long before) {
+    size_t needle_len = strlen(needle);
+    if(before > hist->count)
+        before = hist->count;
+
+    for(long block = (before - 1) / HISTORY_BLOCK_ENTRIES; before > 0 && block >= 0; block--) {
+        const unsigned char *bloom = hist->blooms + block * HISTORY_BLOOM_BYTES;
+        int candidate = 1;
+        for(size_t i = 0; candidate && i + 2 < needle_len; i++) {
+            unsigned int bit = trigram_bit(needle + i);
+            candidate = bloom[bit / 8] & (1 << (bit % 8));
+        }
+        if(!candidate)
+            continue;
+
+        long first = block * HISTORY_BLOCK_ENTRIES;
+        long last = before - 1 < first + HISTORY_BLOCK_ENTRIES - 1 ? before - 1 : first + HISTORY_BLOCK_ENTRIES - 1;
+        for(long i = last; i >= first; i--) {
+            size_t len;
+            const char *entry = history_entry(hist, i, &len);
+            if(memmem(entry, len, needle, needle_len) != NULL)
+                return i;
+        }
+    }
+
+    return -1;
+}
+
+//======================================================================================
+
+/**
+ * @brief Releases the mapping and the index of the history, and closes the history file.
+ *
+ * @param hist History object to close.
+ */
+void history_close(History *hist) {
+    if(hist->map != NULL)
+        munmap((void *)hist->map, hist->map_len);
+    if(hist->fd >= 0)
+        close(hist->fd);
+    free(hist->offsets);
+    free(hist->blooms);
+    *hist = (History){0};
+    hist->fd = -1;
+}
+
+//======================================================================================
+
+/**
+ * @brief Executes the built-in command history.
+ *
+ * @param args 2D char array containing the command and all its arguments. With no arguments
+ * every entry is listed, a number limits the listing to that many of the latest entries,
+ * and -s text... lists the entries containing the args joined by spaces, most recent first.
+ * @param state SHrimpState object holding the history.
+ *
+ * @return 0 on success, 1 if the arguments are invalid or there is no history, or 1 if -s
+ * found no entry.
+ *
+ * @details Non-interactive sessions never record history, but still open the history file
+ * on the first use of this built-in so scripts can search it.
+ */
+int history_builtin(char **args, SHrimpState *state) {
+    History *hist = &state->history;
+    if(hist->fd < 0 && history_open(hist) < 0) {
+        fprintf(stderr, RED_TEXT "history: no history file" RESET_COLOR "\n");
+        return 1;
+    }
+    history_sync(hist);
+
+    if(args[1] != NULL && strcmp(args[1], "-s") == 0) {
+        if(args[2] == NULL) {
+            fprintf(stderr, RED_TEXT "history: usage: history -s text..." RESET_COLOR "\n");
+            return 1;
+        }
+
+        // Search for every arg joined by single spaces, since args cannot be quoted
+        size_t needle_len = 0;
+        for(int i = 2; args[i] != NULL; i++)
+            needle_len += strlen(args[i]) + 1;
+        char *needle = arena_alloc(&state->arena, needle_len);
+        char *out = needle;
+        for(int i = 2; args[i] != NULL; i++) {
+            if(i > 2)
+                *out++ = ' ';
+            size_t len = strlen(args[i]);
+            memcpy(out, args[i], len);
+            out += len;
+        }
+        *out = '\0';
+
+        int found = 0;
+        for(long i = history_search(hist, needle, hist->count); i >= 0; i = history_search(hist, needle, i)) {
+            size_t len;
+            const char *entry = history_entry(hist, i, &len);
+            printf("%7ld  %.*s\n", i + 1, (int)len, entry);
+            found = 1;
+        }
+        return found ? 0 : 1;
+    }
+
+    long first = 0;
+    if(args[1] != NULL) {
+        char *end;
+        long amount = strtol(args[1], &end, 10);
+        if(*end != '\0' || amount < 0 || args[2] != NULL) {
+            fprintf(stderr, RED_TEXT "history: usage: history [n | -s text...]" RESET_COLOR "\n");
+            return 1;
+        }
+        if(amount < hist->count)
+            first = hist->count - amount;
+    }
+
+    for(long i = first; i < hist->count; i++) {
+        size_t len;
+        const char *entry = history_entry(hist, i, &len);
+        printf("%7ld  %.*s\n", i + 1, (int)len, entry);
+    }
+
+    return 0;
+}
+
+//======================================================================================
@@ -0,0 +1,36 @@
+/* history.h
+ *
+ * Header file for history.c
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include "types/types.h"
+
+int history_open(History *hist);
+void history_sync(History *hist);
+void history_add(History *hist, const char *line);
+const char *history_entry(const History *hist, long index, size_t *len);
+long history_search(History *hist, const char *needle, long before);
+void history_close(History *hist);
+int history_builtin(char **args, SHrimpState *state);
+
+#endif
@@ -0,0 +1,215 @@
+/* input.c
+ *
+ * Contains the logic for reading lines of input from the terminal, a script file or a
+ * string passed with -c.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/types.h>     // size_t, off_t
+#include <sys/stat.h>      // fstat()
+#include <sys/mman.h>      // mmap(), munmap()
+#include <fcntl.h>         // open(), O_RDONLY
+#include <unistd.h>        // isatty(), close(), sysconf()
+#include <stdio.h>         // clearerr(), stdin
+#include <stdlib.h>        // free()
+#include <string.h>        // memchr(), memcpy()
+#include <errno.h>         // errno, EINTR
+#include "types/types.h"   // InputSource, Prompt, History, Editor
+#include "utils/utils.h"   // safe_malloc()
+#include "parse/parse.h"   // get_input()
+#include "parse/history.h" // history_open(), history_add()
+#include "parse/editor.h"  // editor_read_line()
+#include "parse/input.h"
+
+//======================================================================================
+
+// Prompt displayed before every line continuing the previous one, such as a here-doc body
+static Prompt continued_prompt = { .text = "> ", .len = 2, .width = 2, .fixed = 1 };
+
+//======================================================================================
+
+/**
+ * @brief Sets up an input source that reads stdin one line at a time through get_input().
+ *
+ * @param source InputSource object to set up.
+ * @param prompt Prompt object displayed before every line.
+ *
+ * @details Whether stdin is a terminal is checked once here rather than before every prompt,
+ * and the prompt is never rendered when it is not.
+ */
+void input_open_stdin(InputSource *source, Prompt *prompt) {
+    *source = (InputSource){0};
+    source->prompt = prompt;
+    source->kind = INPUT_STDIN;
+    source->interactive = isatty(STDIN_FILENO);
+    source->display = 1;
+}
+
+//======================================================================================
+
+/**
+ * @brief Sets up an input source that reads the lines of a string, e.g. the argument of -c.
+ *
+ * @param source InputSource object to set up.
+ * @param str the null terminated string to read. It is modified in place.
+ */
+void input_open_string(InputSource *source, char *str) {
+    *source = (InputSource){0};
+    source->kind = INPUT_BUFFER;
+    source->buf = str;
+    source->len = strlen(str);
+}
+
+//======================================================================================
+
+/**
+ * @brief Sets up an input source that reads every line of a script file.
+ *
+ * @param source InputSource object to set up.
+ * @param path the script file to read.
+ *
+ * @return 0 on success, -1 if the file could not be opened or mapped, with errno set.
+ *
+ * @details The whole file is mapped once with a private, writable mapping, so each line can
+ * be null terminated in place by input_next_line() and by the lexer. Only the pages that
+ * are written to are ever copied, and no memory is allocated per line.
+ */
+int input_open_file(InputSource *source, const char *path) {
+    *source = (InputSource){0};
+    source->kind = INPUT_BUFFER;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+        return -1;
+
+    struct stat sb;
+    if(fstat(fd, &sb) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    // Nothing to map for an empty script
+    if(sb.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+
+    char *buf = mmap(NULL, sb.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(buf == MAP_FAILED)
+        return -1;
+
+    source->buf = buf;
+    source->len = sb.st_size;
+    source->mapped = 1;
+
+    return 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Returns the next line of an input source.
+ *
+ * @param source InputSource object to read from.
+ *
+ * @return A pointer to the null terminated line, without its newline, or NULL once the input
+ * is exhausted. The line is only valid until the next call.
+ *
+ * @details While source->continued is set, an interactive source displays a "> " prompt
+ * instead of the SHrimp prompt and leaves the line out of the history, which only holds the
+ * lines commands were typed on.
+ *
+ * Buffered sources are split in place by replacing each newline with the null
+ * character. The only exception is a mapped file whose last line has no trailing newline
+ * and ends exactly on a page boundary, where there is no byte left in the mapping to hold
+ * the terminator, so that single line is copied out.
+ */
+char *input_next_line(InputSource *source) {
+    if(source->kind == INPUT_STDIN) {
+        Prompt *prompt = source->continued ? &continued_prompt : source->prompt;
+        char *line;
+
+        // The history is opened when the first prompt is due rather than at startup
+        if(source->history != NULL && source->history->fd < 0 && history_open(source->history) < 0)
+            source->history = NULL;
+
+        while(1) {
+            errno = 0;
+            if(source->editor != NULL) {
+                line = editor_read_line(source->editor, prompt);
+                break;
+            }
+            line = get_input(source->interactive && source->display ? prompt : NULL);
+            source->display = 1;
+
+            // Interrupted by a signal, read again without re-rendering the prompt
+            if(line == NULL && errno == EINTR) {
+                source->display = 0;
+                clearerr(stdin);
+                continue;
+            }
+            break;
+        }
+
+        if(line != NULL && source->history != NULL && source->continued == 0)
+            history_add(source->history, line);
+        return line;
+    }
+
+    if(source->pos >= source->len)
+        return NULL;
+
+    char *line = source->buf + source->pos;
+    size_t remaining = source->len - source->pos;
+    char *newline = memchr(line, '\n', remaining);
+
+    if(newline != NULL) {
+        *newline = '\0';
+        source->pos += newline - line + 1;
+        return line;
+    }
+
+    source->pos = source->len;
+    if(source->mapped && source->len % sysconf(_SC_PAGESIZE) == 0) {
+        source->tail = safe_malloc(remaining + 1, "input: tail");
+        memcpy(source->tail, line, remaining);
+        return source->tail;
+    }
+
+    // The byte past the end of a string or a partial page is always available
+    line[remaining] = '\0';
+    return line;
+}
+
+//======================================================================================
+
+/**
+ * @brief Releases the resources held by an input source.
+ *
+ * @param source InputSource object to close.
+ */
+void input_close(InputSource *source) {
+    if(source->mapped)
+        munmap(source->buf, source->len);
+    free(source->tail);
+    *source = (InputSource){0};
+}
+
+//======================================================================================
@@ -0,0 +1,34 @@
+/* input.h
+ *
+ * Header file for input.c
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "types/types.h"
+
+void input_open_stdin(InputSource *source, Prompt *prompt);
+void input_open_string(InputSource *source, char *str);
+int input_open_file(InputSource *source, const char *path);
+char *input_next_line(InputSource *source);
+void input_close(InputSource *source);
+
+#endif
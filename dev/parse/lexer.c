@@ -0,0 +1,194 @@
+/* lexer.c
+ *
+ * Contains the table-driven tokenizer that splits a line of input into typed tokens in a
+ * single scan.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <stddef.h>        // NULL
+#include "types/types.h"   // Lexer, Token, TokenType
+#include "parse/lexer.h"
+
+// Character classes used by the tokenizer. Every byte not listed is part of a word
+enum {
+    CLASS_WORD = 0,
+    CLASS_END,
+    CLASS_SPACE,
+    CLASS_PIPE,
+    CLASS_SEMI,
+    CLASS_AMP,
+    CLASS_LT,
+    CLASS_GT
+};
+
+static const unsigned char char_class[256] = {
+    ['\0'] = CLASS_END,
+    [' ']  = CLASS_SPACE,
+    ['\t'] = CLASS_SPACE,
+    ['\n'] = CLASS_SPACE,
+    ['\r'] = CLASS_SPACE,
+    ['|']  = CLASS_PIPE,
+    [';']  = CLASS_SEMI,
+    ['&']  = CLASS_AMP,
+    ['<']  = CLASS_LT,
+    ['>']  = CLASS_GT
+};
+
+//======================================================================================
+
+/**
+ * @brief Initializes a lexer to scan a line of input.
+ *
+ * @param lexer Lexer object to initialize.
+ * @param input the line of input to tokenize. It is modified in place.
+ */
+void lexer_init(Lexer *lexer, char *input) {
+    lexer->cursor = input;
+    lexer->held = '\0';
+}
+
+//======================================================================================
+
+/**
+ * @brief Returns the byte at the lexer's cursor, including one held back by the last word.
+ *
+ * @param lexer Lexer object to peek into.
+ */
+static unsigned char lexer_peek(Lexer *lexer) {
+    return lexer->held != '\0' ? (unsigned char)lexer->held : (unsigned char)*lexer->cursor;
+}
+
+//======================================================================================
+
+/**
+ * @brief Moves the lexer's cursor past the byte returned by lexer_peek().
+ *
+ * @param lexer Lexer object to advance.
+ */
+static void lexer_advance(Lexer *lexer) {
+    lexer->held = '\0';
+    lexer->cursor++;
+}
+
+//======================================================================================
+
+/**
+ * @brief Scans the next token of the input.
+ *
+ * @param lexer Lexer object holding the position within the input.
+ * @param token Token object used to store the type of the token, and its text if it is a
+ * word.
+ *
+ * @return The type of the scanned token, TOKEN_END once the input is exhausted.
+ *
+ * @details Every byte is classified through a lookup table and visited exactly once. Words
+ * are null terminated in place, so token->text points into the input buffer and no memory
+ * is allocated. When a word is directly followed by an operator, e.g. "one|two", the
+ * operator byte is overwritten by the terminator and held in the lexer until the next call.
+ * All state lives in the Lexer object, so unlike strtok() any amount of lines can be
+ * tokenized at once from any thread. A # at the start of a word ends the line, which lets
+ * scripts contain comments and a #! line.
+ */
+TokenType lexer_next(Lexer *lexer, Token *token) {
+    token->text = NULL;
+
+    // Skip leading whitespace
+    while(char_class[lexer_peek(lexer)] == CLASS_SPACE)
+        lexer_advance(lexer);
+
+    // A # at the start of a word comments out the rest of the line
+    unsigned char c = lexer_peek(lexer);
+    if(c == '#') {
+        token->type = TOKEN_END;
+        return token->type;
+    }
+
+    switch(char_class[c]) {
+        case CLASS_END:
+            token->type = TOKEN_END;
+            return token->type;
+        case CLASS_PIPE:
+            lexer_advance(lexer);
+            if(lexer_peek(lexer) == '|') {
+                lexer_advance(lexer);
+                token->type = TOKEN_OR;
+            } else {
+                token->type = TOKEN_PIPE;
+            }
+            return token->type;
+        case CLASS_SEMI:
+            lexer_advance(lexer);
+            token->type = TOKEN_SEMI;
+            return token->type;
+        case CLASS_AMP:
+            lexer_advance(lexer);
+            if(lexer_peek(lexer) == '|') {
+                lexer_advance(lexer);
+                token->type = TOKEN_PAR;
+            } else if(lexer_peek(lexer) == '&') {
+                lexer_advance(lexer);
+                token->type = TOKEN_AND;
+            } else {
+                token->type = TOKEN_AMP;
+            }
+            return token->type;
+        case CLASS_LT:
+            lexer_advance(lexer);
+            token->type = TOKEN_LT;
+            if(lexer_peek(lexer) == '<') {
+                lexer_advance(lexer);
+                token->type = TOKEN_DLT;
+                if(lexer_peek(lexer) == '<') {
+                    lexer_advance(lexer);
+                    token->type = TOKEN_TLT;
+                }
+            }
+            return token->type;
+        case CLASS_GT:
+            lexer_advance(lexer);
+            if(lexer_peek(lexer) == '>') {
+                lexer_advance(lexer);
+                token->type = TOKEN_DGT;
+            } else {
+                token->type = TOKEN_GT;
+            }
+            return token->type;
+        default:
+            break;
+    }
+
+    // Scan a word up to the next operator, whitespace or the end of the input
+    token->type = TOKEN_WORD;
+    token->text = lexer->cursor;
+    while(char_class[(unsigned char)*lexer->cursor] == CLASS_WORD)
+        lexer->cursor++;
+
+    // Terminate the word in place, holding back the byte it replaced if it is an operator
+    if(*lexer->cursor != '\0') {
+        if(char_class[(unsigned char)*lexer->cursor] != CLASS_SPACE)
+            lexer->held = *lexer->cursor;
+        *lexer->cursor = '\0';
+        if(lexer->held == '\0')
+            lexer->cursor++;
+    }
+
+    return token->type;
+}
+
+//======================================================================================
@@ -17,64 +17,65 @@
  *
  * Author: Ryan McHenry
  * Created: January 23, 2026
- * Last Modified: February 14, 2026
+ * Last Modified: October 14, 2026
  */
 
 #include <sys/types.h>     // ssize_t, size_t
-#include <stdio.h>         // printf(), fflush(), feof(), perror()
-#include <string.h>        // strtok(), strcmp()
-#include <stdlib.h>        // atoi()
-#include <unistd.h>        // isatty(), getcwd()
+#include <stdio.h>         // feof(), perror()
+#include <string.h>        // strcmp(), strncmp(), strlen(), strstr(), memcpy()
+#include <stdlib.h>        // atoi(), strtol(), free()
+#include <unistd.h>        // sysconf()
 #include <pthread.h>       // pthread_mutex_lock(), pthread_mutex_unlock()
 #include <errno.h>         // errno, EINTR
 #include <time.h>          // time()
-#include "config/macros.h" // ORANGE_TEXT, BLUE_TEXT, RED_TEXT, RESET_COLOR
-#include "types/types.h"   // SHrimpCommand, SHrimpState
+#include <sched.h>         // CPU_SETSIZE
+#include <linux/ioprio.h>  // IOPRIO_PRIO_VALUE(), IOPRIO_CLASS_IDLE, IOPRIO_CLASS_BE
+#include "config/macros.h" // INITIAL_ARGS, INITIAL_COMMANDS, ARG_MAX_FLOOR, PRIO_DEFAULT_NICE, PIN_NODE_AUTO, BENCH_*, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // SHrimpCommand, Pipeline, Commands, Lexer, Token, Prompt
+#include "utils/arena.h"   // arena_alloc(), arena_grow()
+#include "parse/lexer.h"   // lexer_init(), lexer_next()
+#include "parse/prompt.h"  // prompt_show()
+#include "parse/input.h"   // input_next_line()
+#include "exec/builtins.h" // find_command_builtin()
 #include "parse/parse.h"
 
 ssize_t getline(char **restrict lineptr, size_t *restrict n, FILE *restrict stream);
 
 //======================================================================================
 
+// Line buffer reused by every call to get_input(), grown by getline() as needed
+static char *input_buffer = NULL;
+static size_t input_buf_size = 0;
+
+//======================================================================================
+
 /**
  * @brief Gets and returns the user input.
  *
- * @param display Integer flag to determine whether the SHrimp prompt is displayed or not.
+ * @param prompt Prompt object to display before reading, or NULL to read without a prompt.
+ * The caller only passes one when stdin is a terminal.
  *
  * @return A pointer to a char array consisting of the user input.
  *
- * @details Displays the user prompt for the shell if display is set to 1. The function then
- * reads the user input using getline(), and then trims off the newline character if present
- * by setting it to the null character.
+ * @details Displays the cached SHrimp prompt if one is provided. The function then reads
+ * the user input using getline(), and then trims off the newline character if present by
+ * setting it to the null character.
+ *
+ * The returned buffer is owned by get_input() and is reused by the next call, so it is only
+ * valid until then and must not be freed by the caller. It only ever grows to the length of
+ * the longest line read, and is released by free_input() when the shell exits.
  */
-char *get_input(int display) {
-    size_t buf_size = 0;    // size of buffer (dynamically resized)
+char *get_input(Prompt *prompt) {
     ssize_t nread;          // number of bytes read by getline()
-    char *buffer = NULL;    // buffer to store read values and cwd
+    char *buffer;           // line read by getline()
 
     // Display user prompt
-    if(isatty(STDIN_FILENO) && display) {
-        char *usr_home = getenv("HOME");
-        char cwd_sub[MAX_ARGS] = "";
-        cwd_sub[0] = '\0';
-        char *cwd = getcwd(buffer, buf_size);
-        strncat(cwd_sub, cwd, strlen(usr_home));
-
-        // See if the user's cwd starts with $HOME
-        if(strcmp(usr_home, cwd_sub) == 0) { // user's cwd is within $HOME, replace $HOME with ~
-            char dir[MAX_ARGS] = "~";
-            int home_len = strlen(usr_home);
-            strncat(dir, cwd + home_len, strlen(cwd) - home_len);
-            printf(ORANGE_TEXT "SHrimp" RESET_COLOR ":" BLUE_TEXT "%s" RESET_COLOR "> ", dir);
-        } else { // print whole cwd
-            printf( ORANGE_TEXT "SHrimp" RESET_COLOR ":" BLUE_TEXT "%s" RESET_COLOR "> ", getcwd(buffer, buf_size));
-        }
-        
-        fflush(stdout);
-    }
+    if(prompt != NULL)
+        prompt_show(prompt);
 
     // Read the user input and trim the newline off if present
-    nread = getline(&buffer, &buf_size,stdin);
+    nread = getline(&input_buffer, &input_buf_size, stdin);
+    buffer = input_buffer;
     if(nread == -1) {
         if(feof(stdin)) {
             return NULL; 
@@ -95,24 +96,148 @@ char *get_input(int display) {
 //======================================================================================
 
 /**
- * @brief Splits up the raw input obtained in get_input() into separate commands, delimited by ;
+ * @brief Frees the line buffer reused by get_input().
+ */
+void free_input(void) {
+    free(input_buffer);
+    input_buffer = NULL;
+    input_buf_size = 0;
+}
+
+//======================================================================================
+
+/**
+ * @brief Allocates an empty SHrimpCommand from the arena.
+ *
+ * @param arena Arena object owning the memory of the current line of input.
+ */
+static SHrimpCommand *new_command(Arena *arena) {
+    SHrimpCommand *cmd = arena_alloc(arena, sizeof(SHrimpCommand));
+    *cmd = (SHrimpCommand){0};
+    cmd->arg_cap = INITIAL_ARGS;
+    cmd->args = arena_alloc(arena, (cmd->arg_cap + 1) * sizeof(char *));
+    cmd->args[0] = NULL;
+
+    return cmd;
+}
+
+//======================================================================================
+
+/**
+ * @brief Appends a token to the args of a command, doubling the capacity of args when full.
+ *
+ * @param cmd SHrimpCommand object to append to.
+ * @param text the token to append.
+ * @param arena Arena object owning the memory of the current line of input.
  *
- * @param input the raw text input obtained in get_input()
- * @param cmds Commands object used to store the list of commands
+ * @return PARSE_OK, or PARSE_CMD_OUT_OF_RANGE if the args of the command would no longer
+ * fit within the system's ARG_MAX limit.
  *
- * @details Splits up the raw input obtained in get_input() into separate commands, delimited by ;.
- * If a line of input does not posses any semi-colons, Commands only stores a single command to
- * execute.
+ * @details Querying ARG_MAX costs a system call, so it is only done once a command's args
+ * grow past ARG_MAX_FLOOR, which Linux guarantees ARG_MAX is never smaller than.
  */
-ParseCode parse_commands(char *input, Commands *cmds) {
-    char *command;  // string to store commands
+static ParseCode push_arg(SHrimpCommand *cmd, char *text, Arena *arena) {
+    cmd->arg_bytes += strlen(text) + 1 + sizeof(char *);
+    if(cmd->arg_bytes > ARG_MAX_FLOOR) {
+        long arg_max = sysconf(_SC_ARG_MAX);
+        if(arg_max > 0 && cmd->arg_bytes > (size_t)arg_max)
+            return PARSE_CMD_OUT_OF_RANGE;
+    }
 
-    command = strtok(input, ";");
+    if(cmd->arg_amt == cmd->arg_cap) {
+        cmd->args = arena_grow(arena, cmd->args, (cmd->arg_cap + 1) * sizeof(char *), (cmd->arg_cap * 2 + 1) * sizeof(char *));
+        cmd->arg_cap *= 2;
+    }
+    cmd->args[cmd->arg_amt++] = text;
+    cmd->args[cmd->arg_amt] = NULL;
 
-    while(command != NULL) {
-        cmds->commands[cmds->command_amt++] = command;
-        command = strtok(NULL, ";");
-    }    
+    return PARSE_OK;
+}
+
+//======================================================================================
+
+/**
+ * @brief Appends a command to a pipeline, doubling the capacity of its array when full.
+ *
+ * @param pipeline Pipeline object to append to.
+ * @param cmd SHrimpCommand object to append.
+ * @param arena Arena object owning the memory of the current line of input.
+ */
+static void push_command(Pipeline *pipeline, SHrimpCommand *cmd, Arena *arena) {
+    if(pipeline->command_amt == pipeline->command_cap) {
+        int new_cap = pipeline->command_cap ? pipeline->command_cap * 2 : INITIAL_COMMANDS;
+        pipeline->commands = arena_grow(arena, pipeline->commands, pipeline->command_cap * sizeof(SHrimpCommand *), new_cap * sizeof(SHrimpCommand *));
+        pipeline->command_cap = new_cap;
+    }
+    pipeline->commands[pipeline->command_amt++] = cmd;
+}
+
+//======================================================================================
+
+/**
+ * @brief Appends a pipeline to the commands of a line, doubling the capacity of its array
+ * when full.
+ *
+ * @param cmds Commands object to append to.
+ * @param pipeline Pipeline object to append.
+ * @param arena Arena object owning the memory of the current line of input.
+ */
+static void push_pipeline(Commands *cmds, Pipeline *pipeline, Arena *arena) {
+    if(cmds->command_amt == cmds->command_cap) {
+        int new_cap = cmds->command_cap ? cmds->command_cap * 2 : INITIAL_COMMANDS;
+        cmds->commands = arena_grow(arena, cmds->commands, cmds->command_cap * sizeof(Pipeline *), new_cap * sizeof(Pipeline *));
+        cmds->command_cap = new_cap;
+    }
+    cmds->commands[cmds->command_amt++] = pipeline;
+}
+
+//======================================================================================
+
+/**
+ * @brief Allocates an empty Pipeline from the arena.
+ *
+ * @param arena Arena object owning the memory of the current line of input.
+ */
+static Pipeline *new_pipeline(Arena *arena) {
+    Pipeline *pipeline = arena_alloc(arena, sizeof(Pipeline));
+    *pipeline = (Pipeline){0};
+
+    return pipeline;
+}
+
+//======================================================================================
+
+/**
+ * @brief Applies an option of the prio prefix to a pipeline.
+ *
+ * @param pipeline Pipeline object prefixed with prio.
+ * @param flag the option, either -n or -i.
+ * @param value the WORD following the option.
+ *
+ * @return PARSE_OK on success, or PARSE_INVALID_PRIO if the value is out of range.
+ *
+ * @details -n takes the niceness every stage adds, from -20 to 19, like nice -n. -i takes
+ * the I/O scheduling of every stage, like ionice: idle, a best-effort level from 0 (highest)
+ * to 7 (lowest), or none to keep the shell's.
+ */
+static ParseCode parse_prio_option(Pipeline *pipeline, const char *flag, const char *value) {
+    char *end;
+    long number = strtol(value, &end, 10);
+    int is_number = end != value && *end == '\0';
+
+    if(strcmp(flag, "-n") == 0) {
+        if(!is_number || number < -20 || number > 19)
+            return PARSE_INVALID_PRIO;
+        pipeline->nice = (int)number;
+    } else if(strcmp(value, "idle") == 0) {
+        pipeline->ioprio = IOPRIO_PRIO_VALUE(IOPRIO_CLASS_IDLE, 0);
+    } else if(strcmp(value, "none") == 0) {
+        pipeline->ioprio = 0;
+    } else {
+        if(!is_number || number < 0 || number > 7)
+            return PARSE_INVALID_PRIO;
+        pipeline->ioprio = IOPRIO_PRIO_VALUE(IOPRIO_CLASS_BE, number);
+    }
 
     return PARSE_OK;
 }
@@ -120,45 +245,373 @@ ParseCode parse_commands(char *input, Commands *cmds) {
 //======================================================================================
 
 /**
- * @brief Parses the raw user input obtained in get_input() and stores it in a SHrimpCommand
- * object.
+ * @brief Applies the node=VALUE option of the pin prefix to a pipeline.
  *
- * @param input raw input string of the entered user command.
- * @param cmd SHrimpCommand object used to pass the obtained user input, and then
- * save the args of the command, whether the command runs in the background, and whether the
- * command is delayed.
+ * @param pipeline Pipeline object prefixed with pin.
+ * @param value the text after node=, either auto or the number of a NUMA node.
  *
- * @details Parses the raw user input using strtok() and strcmp(). The function first
- * parses the command itself as args[0], and then parses all arguments if they exist.
+ * @return PARSE_OK on success, or PARSE_INVALID_PIN if the value is neither.
  *
- * The function then checks if the user designates the command to run in the 
- * background using &. If yes, remove the & character from args, set the value of
- * the integer flag named background to be 1, and subtract 1 from token_counter.
+ * @details Whether the node exists is only known once the pipeline is launched, so a node
+ * missing from the system is reported by numa_place() instead.
  */
-ParseCode parse_input(char *input, SHrimpCommand *cmd) {
-    char *token = NULL;      // string to store tokens
-    int token_counter = 0;   // indexer for args
-
-    // Parse the command as args[0]
-    token = strtok(input, " \t\n");
-    if(token == NULL)
-        return PARSE_INVALID_CMD;
-    cmd->args[token_counter++] = token;
-
-    // Parse arguments if they exist
-    while(token != NULL) {
-        token = strtok(NULL, " \t\n");
-        cmd->args[token_counter++] = token;
-    }     
-
-    // Remove & char from args and set command to run in background
-    if(strcmp(cmd->args[token_counter - 2], "&") == 0) {
-        cmd->background = 1;
-        cmd->args[token_counter - 2] = NULL;
-        token_counter--;
-    } 
+static ParseCode parse_pin_option(Pipeline *pipeline, const char *value) {
+    if(strcmp(value, "auto") == 0) {
+        pipeline->pin_node = PIN_NODE_AUTO;
+        return PARSE_OK;
+    }
+
+    char *end;
+    long node = strtol(value, &end, 10);
+    if(end == value || *end != '\0' || node < 0 || node >= CPU_SETSIZE)
+        return PARSE_INVALID_PIN;
+
+    pipeline->pin_node = (int)node;
+    return PARSE_OK;
+}
+
+//======================================================================================
+
+/**
+ * @brief Applies an option of the bench prefix that takes a value to a pipeline.
+ *
+ * @param pipeline Pipeline object prefixed with bench.
+ * @param flag the option, either -n or -w.
+ * @param value the WORD following the option.
+ *
+ * @return PARSE_OK on success, or PARSE_INVALID_BENCH if the value is out of range.
+ *
+ * @details -n takes the amount of measured runs, from 1 to BENCH_MAX_RUNS, and -w the amount
+ * of warmup runs before them, from 0 to BENCH_MAX_RUNS.
+ */
+static ParseCode parse_bench_option(Pipeline *pipeline, const char *flag, const char *value) {
+    char *end;
+    long runs = strtol(value, &end, 10);
+    int minimum = strcmp(flag, "-n") == 0 ? 1 : 0;
+
+    if(end == value || *end != '\0' || runs < minimum || runs > BENCH_MAX_RUNS)
+        return PARSE_INVALID_BENCH;
+
+    if(minimum)
+        pipeline->bench_runs = (int)runs;
+    else
+        pipeline->bench_warmup = (int)runs;
+    return PARSE_OK;
+}
+
+//======================================================================================
+
+/**
+ * @brief Parses a line of input obtained in get_input() into the pipelines to execute.
+ *
+ * @param input the raw text input obtained in get_input(). It is modified in place.
+ * @param cmds Commands object used to store every pipeline of the line.
+ * @param arena Arena object owning the memory of the current line of input.
+ *
+ * @return PARSE_OK on success. PARSE_INVALID_PIPE, PARSE_INVALID_REDIRECT,
+ * PARSE_INVALID_PARALLEL, PARSE_INVALID_LIST, PARSE_INVALID_PRIO, PARSE_INVALID_PIN,
+ * PARSE_INVALID_BENCH or PARSE_INVALID_CMD if the line is malformed, or
+ * PARSE_CMD_OUT_OF_RANGE if a command's args exceed ARG_MAX, in which case no pipeline of
+ * the line should be executed.
+ *
+ * @details Replaces the previous strtok() passes over ; and whitespace followed by separate
+ * scans for pipe and redirection tokens. The lexer emits typed tokens in a single scan and
+ * each token is consumed as it arrives:
+ *
+ *   - WORD tokens are appended to the args of the current command. A WORD holding $? marks
+ *     its command, and the command's args are expanded each time it runs.
+ *   - <, > and >> consume the following WORD as the command's file name, so redirection
+ *     tokens never appear in args.
+ *   - <<< consumes the following WORD as a here-string fed to the command's stdin, and <<
+ *     consumes it as the delimiter of a here-doc, whose body parse_heredocs() reads from
+ *     the lines after this one. The last of <, << and <<< on a command wins.
+ *   - | ends the current command and starts the next stage of the pipeline.
+ *   - ; and & end the current pipeline, with & marking it to run in the background.
+ *   - &| ends the current pipeline and marks it to run at once with the next pipeline, so
+ *     "a &| b &| c" forms a group of three pipelines launched together. A group must not end
+ *     in & and every &| must be followed by a pipeline.
+ *   - && and || end the current pipeline and make the next one conditional on its status,
+ *     so the next pipeline only runs if it succeeded or failed respectively. A pipeline is
+ *     skipped before anything of it is launched, and a skipped pipeline leaves the status
+ *     as it was, so "a && b || c" runs c if either a or b fails. The condition of the first
+ *     pipeline of a &| group applies to the whole group, while & and &| only ever apply to
+ *     the single pipeline before them.
+ *   - A WORD of time at the very start of a pipeline marks the whole pipeline as timed.
+ *   - A WORD of prio at the very start of a pipeline lowers the CPU and I/O priority of
+ *     every stage, by PRIO_DEFAULT_NICE and to the idle I/O class unless -n N or -i CLASS
+ *     follow it. Each option consumes the following WORD as its value.
+ *   - A WORD of pin at the very start of a pipeline pins every stage to the CPUs of one
+ *     NUMA node, picked automatically unless a node=N WORD follows it.
+ *   - A WORD of bench at the very start of a pipeline runs the whole pipeline
+ *     BENCH_DEFAULT_RUNS times and reports its wall time and resource use. -n RUNS,
+ *     -w WARMUP and -j may follow it, until a -- WORD or any other WORD. -n and -w consume
+ *     the following WORD as their value. A benchmarked pipeline cannot run in the
+ *     background or in a &| group.
+ *
+ * Every SHrimpCommand and Pipeline is allocated from the arena and each arg points into the
+ * input buffer, so nothing needs to be freed individually. The args of a command, the
+ * commands of a pipeline and the pipelines of a line are all growable arrays that double in
+ * capacity when full, so the only limit on a command is the system's ARG_MAX. Empty
+ * commands between separators, e.g. "echo one;; echo two", are skipped.
+ */
+ParseCode parse_line(char *input, Commands *cmds, Arena *arena) {
+    Lexer lexer;
+    Token token;
+    Pipeline *pipeline = new_pipeline(arena);  // pipeline currently being parsed
+    SHrimpCommand *cmd = new_command(arena);   // command currently being parsed
+    int bench_options = 0;                     // flag for if the next WORD may be an option of bench
+
+    cmds->commands = NULL;
+    cmds->command_amt = 0;
+    cmds->command_cap = 0;
+    cmds->heredoc_amt = 0;
+    lexer_init(&lexer, input);
+
+    while(1) {
+        switch(lexer_next(&lexer, &token)) {
+            case TOKEN_WORD:
+                // A leading bench is a prefix of the whole pipeline, as are the options
+                // that follow it. Any other WORD ends them, including another prefix
+                if(pipeline->command_amt == 0 && cmd->arg_amt == 0 && pipeline->bench == 0 &&
+                   strcmp(token.text, "bench") == 0) {
+                    pipeline->bench = 1;
+                    pipeline->bench_runs = BENCH_DEFAULT_RUNS;
+                    bench_options = 1;
+                    break;
+                }
+                if(bench_options) {
+                    bench_options = strcmp(token.text, "-j") == 0 || strcmp(token.text, "-n") == 0 ||
+                                    strcmp(token.text, "-w") == 0;
+                    if(strcmp(token.text, "--") == 0)
+                        break;
+                    if(strcmp(token.text, "-j") == 0) {
+                        pipeline->bench_json = 1;
+                        break;
+                    }
+                    if(bench_options) {
+                        char *flag = token.text;
+                        if(lexer_next(&lexer, &token) != TOKEN_WORD || parse_bench_option(pipeline, flag, token.text) != PARSE_OK)
+                            return PARSE_INVALID_BENCH;
+                        break;
+                    }
+                }
+                // So is a leading time
+                if(pipeline->command_amt == 0 && cmd->arg_amt == 0 && pipeline->timed == 0 &&
+                   strcmp(token.text, "time") == 0) {
+                    pipeline->timed = 1;
+                    break;
+                }
+                // And a leading prio, along with the options that follow it
+                if(pipeline->command_amt == 0 && cmd->arg_amt == 0 && pipeline->prio == 0 &&
+                   strcmp(token.text, "prio") == 0) {
+                    pipeline->prio = 1;
+                    pipeline->nice = PRIO_DEFAULT_NICE;
+                    pipeline->ioprio = IOPRIO_PRIO_VALUE(IOPRIO_CLASS_IDLE, 0);
+                    break;
+                }
+                if(pipeline->command_amt == 0 && cmd->arg_amt == 0 && pipeline->prio &&
+                   (strcmp(token.text, "-n") == 0 || strcmp(token.text, "-i") == 0)) {
+                    char *flag = token.text;
+                    if(lexer_next(&lexer, &token) != TOKEN_WORD || parse_prio_option(pipeline, flag, token.text) != PARSE_OK)
+                        return PARSE_INVALID_PRIO;
+                    break;
+                }
+                // And a leading pin, along with its node
+                if(pipeline->command_amt == 0 && cmd->arg_amt == 0 && pipeline->pin == 0 &&
+                   strcmp(token.text, "pin") == 0) {
+                    pipeline->pin = 1;
+                    pipeline->pin_node = PIN_NODE_AUTO;
+                    break;
+                }
+                if(pipeline->command_amt == 0 && cmd->arg_amt == 0 && pipeline->pin &&
+                   strncmp(token.text, "node=", 5) == 0) {
+                    if(parse_pin_option(pipeline, token.text + 5) != PARSE_OK)
+                        return PARSE_INVALID_PIN;
+                    break;
+                }
+                if(push_arg(cmd, token.text, arena) != PARSE_OK)
+                    return PARSE_CMD_OUT_OF_RANGE;
+                if(strstr(token.text, "$?") != NULL) {
+                    cmd->has_status = 1;
+                    pipeline->has_status = 1;
+                }
+                break;
+
+            case TOKEN_LT:
+            case TOKEN_GT:
+            case TOKEN_DGT: {
+                TokenType redirect_type = token.type;
+                if(lexer_next(&lexer, &token) != TOKEN_WORD)
+                    return PARSE_INVALID_REDIRECT;
+
+                if(redirect_type == TOKEN_LT) {
+                    cmd->input_redirect = 1;
+                    cmd->infile = token.text;
+                    if(cmd->here_delim != NULL)
+                        cmds->heredoc_amt--;
+                    cmd->here = NULL;
+                    cmd->here_delim = NULL;
+                } else {
+                    cmd->output_redirect = redirect_type == TOKEN_GT;
+                    cmd->append_redirect = redirect_type == TOKEN_DGT;
+                    cmd->outfile = token.text;
+                }
+                pipeline->has_redirect = 1; // true
+                break;
+            }
+
+            case TOKEN_DLT:
+            case TOKEN_TLT: {
+                TokenType redirect_type = token.type;
+                if(lexer_next(&lexer, &token) != TOKEN_WORD)
+                    return PARSE_INVALID_REDIRECT;
+
+                // A here-string is its word followed by a newline, copied out of the line
+                cmd->input_redirect = 0;
+                cmd->infile = NULL;
+                if(cmd->here_delim != NULL)
+                    cmds->heredoc_amt--;
+                cmd->here_delim = NULL;
+                if(redirect_type == TOKEN_TLT) {
+                    cmd->here_len = strlen(token.text) + 1;
+                    cmd->here = arena_alloc(arena, cmd->here_len + 1);
+                    memcpy(cmd->here, token.text, cmd->here_len - 1);
+                    cmd->here[cmd->here_len - 1] = '\n';
+                    cmd->here[cmd->here_len] = '\0';
+                } else {
+                    cmd->here = NULL;
+                    cmd->here_delim = token.text;
+                    cmds->heredoc_amt++;
+                }
+                pipeline->has_redirect = 1; // true
+                break;
+            }
+
+            case TOKEN_PIPE:
+                // Catch edge cases such as "| echo hi" and "echo one | | wc"
+                if(cmd->arg_amt == 0)
+                    return PARSE_INVALID_PIPE;
+
+                cmd->builtin = find_command_builtin(cmd->args);
+                pipeline->has_builtin |= cmd->builtin != NULL;
+                push_command(pipeline, cmd, arena);
+                pipeline->has_pipe = 1; // true
+                cmd = new_command(arena);
+                break;
+
+            case TOKEN_SEMI:
+            case TOKEN_AMP:
+            case TOKEN_PAR:
+            case TOKEN_AND:
+            case TOKEN_OR:
+            case TOKEN_END: {
+                TokenType end_type = token.type;
+                int after_par = cmds->command_amt > 0 && cmds->commands[cmds->command_amt - 1]->parallel;
+
+                if(cmd->arg_amt == 0) {
+                    // Catch edge cases such as "echo one two three |"
+                    if(pipeline->command_amt > 0)
+                        return PARSE_INVALID_PIPE;
+                    // A &| with nothing on one side of it, e.g. "&| echo" or "echo &|"
+                    if(end_type == TOKEN_PAR || after_par)
+                        return PARSE_INVALID_PARALLEL;
+                    // A && or || with nothing on one side of it, e.g. "&& echo" or "echo ||"
+                    if(end_type == TOKEN_AND || end_type == TOKEN_OR || pipeline->condition != LIST_ALWAYS)
+                        return PARSE_INVALID_LIST;
+                    // A redirection, &, time, prio, pin or bench without any command, e.g. "> out.txt"
+                    if(cmd->input_redirect || cmd->output_redirect || cmd->append_redirect || cmd->here != NULL ||
+                       cmd->here_delim != NULL || end_type == TOKEN_AMP || pipeline->timed || pipeline->prio ||
+                       pipeline->pin || pipeline->bench)
+                        return PARSE_INVALID_CMD;
+                } else {
+                    // The pipelines of a group are waited for together, e.g. "a &| b &"
+                    if(end_type == TOKEN_AMP && after_par)
+                        return PARSE_INVALID_PARALLEL;
+                    // Every run of a benchmark is waited for before the next one starts
+                    if(pipeline->bench && (end_type == TOKEN_AMP || end_type == TOKEN_PAR || after_par))
+                        return PARSE_INVALID_BENCH;
+
+                    cmd->builtin = find_command_builtin(cmd->args);
+                    pipeline->has_builtin |= cmd->builtin != NULL;
+                    push_command(pipeline, cmd, arena);
+                    pipeline->background = end_type == TOKEN_AMP;
+                    pipeline->parallel = end_type == TOKEN_PAR;
+                    push_pipeline(cmds, pipeline, arena);
+
+                    pipeline = new_pipeline(arena);
+                    cmd = new_command(arena);
+                    bench_options = 0;
+                    if(end_type == TOKEN_AND)
+                        pipeline->condition = LIST_AND;
+                    else if(end_type == TOKEN_OR)
+                        pipeline->condition = LIST_OR;
+                }
+
+                if(end_type == TOKEN_END)
+                    return PARSE_OK;
+                break;
+            }
+        }
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Reads the body of every << here-doc of a parsed line from the lines that follow it.
+ *
+ * @param cmds Commands object holding the pipelines of the line, as parsed by parse_line().
+ * @param source InputSource object the line was read from.
+ * @param arena Arena object owning the memory of the current line of input.
+ *
+ * @return PARSE_OK on success, or PARSE_UNTERMINATED_HEREDOC if the input ends before the
+ * delimiter of a here-doc, in which case no pipeline of the line should be executed.
+ *
+ * @details The bodies are read in the order their here-docs appear on the line, each one
+ * up to the line holding just its delimiter. Every body line is copied into a single arena
+ * buffer, so the body outlives the lines of the source, which an INPUT_STDIN source reads
+ * into a single reused buffer.
+ */
+ParseCode parse_heredocs(Commands *cmds, InputSource *source, Arena *arena) {
+    for(int i = 0; i < cmds->command_amt && cmds->heredoc_amt > 0; i++) {
+        Pipeline *pipeline = cmds->commands[i];
+        for(int j = 0; j < pipeline->command_amt && cmds->heredoc_amt > 0; j++) {
+            SHrimpCommand *cmd = pipeline->commands[j];
+            size_t len = 0, cap = 0;
+            char *body = NULL;
+
+            if(cmd->here_delim == NULL)
+                continue;
+
+            source->continued = 1;
+            char *line;
+            while((line = input_next_line(source)) != NULL && strcmp(line, cmd->here_delim) != 0) {
+                size_t line_len = strlen(line);
+                if(len + line_len + 2 > cap) {
+                    size_t new_cap = cap ? cap * 2 : INITIAL_HEREDOC;
+                    while(new_cap < len + line_len + 2)
+                        new_cap *= 2;
+                    body = arena_grow(arena, body, cap, new_cap);
+                    cap = new_cap;
+                }
+                memcpy(body + len, line, line_len);
+                len += line_len;
+                body[len++] = '\n';
+            }
+            source->continued = 0;
+            if(line == NULL)
+                return PARSE_UNTERMINATED_HEREDOC;
+
+            if(body == NULL)
+                body = arena_alloc(arena, 1);
+            body[len] = '\0';
+            cmd->here = body;
+            cmd->here_len = len;
+            cmds->heredoc_amt--;
+        }
+    }
 
     return PARSE_OK;
 }
 
-//======================================================================================
\ No newline at end of file
+//======================================================================================
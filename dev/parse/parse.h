@@ -17,7 +17,7 @@
  *
  * Author: Ryan McHenry
  * Created: January 23, 2026
- * Last Modified: February 10, 2026
+ * Last Modified: October 14, 2026
  */
 
 #ifndef PARSE_H
@@ -25,8 +25,9 @@
 
 #include "types/types.h"
 
-char *get_input(int display);
-ParseCode parse_commands(char *input, Commands *cmds);
-ParseCode parse_input(char *input, SHrimpCommand *cmd);
+char *get_input(Prompt *prompt);
+void free_input(void);
+ParseCode parse_line(char *input, Commands *cmds, Arena *arena);
+ParseCode parse_heredocs(Commands *cmds, InputSource *source, Arena *arena);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,154 @@
+/* prompt.c
+ *
+ * Contains the prompt of SHrimp, which is rendered once and cached until the working
+ * directory or $HOME changes.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <unistd.h>        // getcwd(), write(), STDOUT_FILENO
+#include <stdio.h>         // fflush(), stdout
+#include <stdlib.h>        // getenv(), free()
+#include <string.h>        // strcmp(), strncmp(), strlen(), memcpy()
+#include <errno.h>         // errno, EINTR
+#include "config/macros.h" // ORANGE_TEXT, BLUE_TEXT, RESET_COLOR
+#include "types/types.h"   // Prompt
+#include "utils/utils.h"   // safe_malloc(), safe_strdup()
+#include "parse/prompt.h"
+
+// Text of the prompt around the working directory
+static const char prompt_prefix[] = ORANGE_TEXT "SHrimp" RESET_COLOR ":" BLUE_TEXT;
+static const char prompt_suffix[] = RESET_COLOR "> ";
+
+//======================================================================================
+
+/**
+ * @brief Renders the prompt for the current working directory into the prompt's buffer.
+ *
+ * @param prompt Prompt object to render.
+ * @param home the current value of $HOME, or NULL if it is unset.
+ *
+ * @details A working directory within $HOME is shown relative to ~. The directory is only
+ * shortened at a path component boundary, so /home/user2 is not shown as ~2 for a $HOME of
+ * /home/user. The buffer grows to fit the deepest directory rendered so far.
+ */
+static void prompt_render(Prompt *prompt, const char *home) {
+    char *cwd = getcwd(NULL, 0);
+    const char *dir = cwd != NULL ? cwd : "?";
+    const char *tilde = "";
+
+    size_t home_len = home != NULL ? strlen(home) : 0;
+    if(home_len > 0 && strncmp(dir, home, home_len) == 0 && (dir[home_len] == '\0' || dir[home_len] == '/')) {
+        tilde = "~";
+        dir += home_len;
+    }
+
+    size_t tilde_len = strlen(tilde);
+    size_t dir_len = strlen(dir);
+    size_t len = sizeof(prompt_prefix) - 1 + tilde_len + dir_len + sizeof(prompt_suffix) - 1;
+    if(len > prompt->cap) {
+        free(prompt->text);
+        prompt->text = safe_malloc(len, "prompt: text");
+        prompt->cap = len;
+    }
+
+    char *out = prompt->text;
+    memcpy(out, prompt_prefix, sizeof(prompt_prefix) - 1);
+    out += sizeof(prompt_prefix) - 1;
+    memcpy(out, tilde, tilde_len);
+    out += tilde_len;
+    memcpy(out, dir, dir_len);
+    out += dir_len;
+    memcpy(out, prompt_suffix, sizeof(prompt_suffix) - 1);
+    prompt->len = len;
+
+    // Every byte outside of the color escape sequences takes up a column
+    prompt->width = 0;
+    for(size_t i = 0; i < len; i++) {
+        if(prompt->text[i] == '\033') {
+            while(i < len && prompt->text[i] != 'm')
+                i++;
+            continue;
+        }
+        prompt->width++;
+    }
+
+    free(prompt->home);
+    prompt->home = home != NULL ? safe_strdup(home, "prompt: home") : NULL;
+    prompt->stale = 0;
+    free(cwd);
+}
+
+//======================================================================================
+
+/**
+ * @brief Renders the prompt again if it is out of date.
+ *
+ * @param prompt Prompt object to bring up to date.
+ *
+ * @details The prompt is out of date once cd changed the working directory or $HOME no
+ * longer matches the value it was rendered against, so checking an up to date prompt
+ * costs a single getenv(), with no allocation and no getcwd(). A fixed prompt is never
+ * rendered.
+ */
+void prompt_update(Prompt *prompt) {
+    if(prompt->fixed)
+        return;
+
+    const char *home = getenv("HOME");
+    int home_changed = (home == NULL) != (prompt->home == NULL) || (home != NULL && strcmp(home, prompt->home) != 0);
+    if(prompt->text == NULL || prompt->stale || home_changed)
+        prompt_render(prompt, home);
+}
+
+//======================================================================================
+
+/**
+ * @brief Displays the prompt with a single write(), rendering it again first if it is out
+ * of date.
+ *
+ * @param prompt Prompt object to display.
+ */
+void prompt_show(Prompt *prompt) {
+    prompt_update(prompt);
+
+    // Anything printed through stdio must reach the terminal before the prompt
+    fflush(stdout);
+    for(size_t written = 0; written < prompt->len;) {
+        ssize_t put = write(STDOUT_FILENO, prompt->text + written, prompt->len - written);
+        if(put < 0 && errno != EINTR)
+            return;
+        if(put > 0)
+            written += put;
+    }
+}
+
+//======================================================================================
+
+/**
+ * @brief Releases the memory held by the prompt.
+ *
+ * @param prompt Prompt object to free.
+ */
+void prompt_free(Prompt *prompt) {
+    free(prompt->text);
+    free(prompt->home);
+    *prompt = (Prompt){0};
+}
+
+//======================================================================================
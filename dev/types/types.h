@@ -17,14 +17,22 @@
  *
  * Author: Ryan McHenry
  * Created: January 23, 2026
- * Last Modified: February 10, 2026
+ * Last Modified: October 14, 2026
  */
 
 #ifndef TYPES_H
 #define TYPES_H
 
-#include "config/macros.h" // MAX_ARGS
-#include <pthread.h>       // pthread_mutex_t
+#include "config/macros.h" // HASH_BUCKETS
+#include <pthread.h>       // pthread_mutex_t, pthread_t
+#include <stddef.h>        // size_t
+#include <stdint.h>        // uint32_t, uint64_t, int64_t
+#include <signal.h>        // sigset_t
+#include <sched.h>         // cpu_set_t
+#include <sys/types.h>     // pid_t
+#include <termios.h>       // struct termios
+#include <sys/resource.h>  // struct rusage
+#include <time.h>          // struct timespec
 
 // Enums for function return codes, codes are handled in the main SHrimp loop
 typedef enum {
@@ -35,41 +43,511 @@ typedef enum {
     PARSE_INVALID_DELAY,
     PARSE_NEGATIVE_DELAY,
     PARSE_DELAY_OUT_OF_RANGE,
-    PARSE_CMD_OUT_OF_RANGE
+    PARSE_CMD_OUT_OF_RANGE,
+    PARSE_INVALID_REDIRECT,
+    PARSE_INVALID_PARALLEL,
+    PARSE_UNTERMINATED_HEREDOC,
+    PARSE_INVALID_PRIO,
+    PARSE_INVALID_PIN,
+    PARSE_INVALID_LIST,
+    PARSE_INVALID_BENCH
 } ParseCode;
 
+// Enum for the types of tokens emitted by the lexer
+typedef enum {
+    TOKEN_END,   // end of the input
+    TOKEN_WORD,  // command name, argument or file name
+    TOKEN_PIPE,  // |
+    TOKEN_SEMI,  // ;
+    TOKEN_AMP,   // &
+    TOKEN_PAR,   // &|
+    TOKEN_AND,   // &&
+    TOKEN_OR,    // ||
+    TOKEN_LT,    // <
+    TOKEN_DLT,   // <<
+    TOKEN_TLT,   // <<<
+    TOKEN_GT,    // >
+    TOKEN_DGT    // >>
+} TokenType;
+
+// struct for a single token of a line of input
+typedef struct {
+    TokenType type;  // type of the token
+    char *text;      // null terminated text of the token if it is a word, NULL otherwise
+} Token;
+
+// struct holding the position of the lexer within a line of input
+typedef struct {
+    char *cursor;  // next byte of the input to scan
+    char held;     // operator byte overwritten by the terminator of the previous word
+} Lexer;
+
+// Enum for the states a job can be in
+typedef enum {
+    JOB_RUNNING,
+    JOB_STOPPED,
+    JOB_DONE
+} JobState;
+
+// struct for a single sample of one stage of a job, as taken by the pipe monitor
+typedef struct {
+    int valid;                 // flag for if the stage was still running when it was sampled
+    unsigned long long rchar;  // bytes the stage had read so far, from /proc/<pid>/io
+    unsigned long long wchar;  // bytes the stage had written so far
+    int queued;                // bytes waiting in the pipe the stage writes to, -1 if none
+    int pipe_size;             // capacity of that pipe
+} PipeSample;
+
+// struct for a single run of a pipeline benchmarked with the bench prefix
+typedef struct {
+    double real;           // wall time of the run in seconds, launch and wait included
+    struct rusage usage;   // resources used by every process of the run, summed up
+    int status;            // exit status of the run
+} BenchSample;
+
+// struct for a single pipeline launched by the shell
+typedef struct {
+    int id;           // job number shown as [id]
+    pid_t pgid;       // process group of the job, which is the pid of its first process
+    pid_t *pids;      // pid of every process of the job, -1 for a stage that failed to launch
+    int *statuses;    // exit status of every process of the job, valid once it is reaped
+    int proc_amt;     // amount of processes in the job
+    int live;         // amount of processes that have not exited yet
+    JobState state;   // whether the job is running, stopped or done
+    int stop_status;  // 128 plus the signal that most recently stopped the job
+    int background;   // flag for if the job was started or continued in the background
+    char *cmdline;    // text of the pipeline, as shown by the jobs built-in
+    char **stages;    // text of every stage of the pipeline
+    struct rusage *usage;      // resources used by every process of the job, valid once it is reaped
+    struct timespec started;   // when the job was launched
+    struct timespec *ended;    // when every process of the job was reaped
+    int timed;                 // flag for if the resource use of the job is reported once it is done
+    PipeSample *samples;       // last sample of every stage taken by set pipestat, NULL until the first
+    struct timespec sampled;   // when samples was taken
+    int node;                  // NUMA node every stage of the job is pinned to, -1 if not pinned
+    int pipefail;              // flag for if the status of the job is that of its last failing stage
+    BenchSample *sample;       // where the resource use of the job is stored once it is done, NULL if not benchmarked
+} Job;
+
+// A process of a job, found by its pid through the pid hash of the job table
+typedef struct {
+    pid_t pid;   // pid of the process, 0 if the slot is empty
+    Job *job;    // job the process belongs to
+    int stage;   // index of the process within the job
+} PidSlot;
+
+// struct for the job table, tracking every job until its status has been collected
+typedef struct {
+    Job **jobs;             // jobs in the order they were started
+    int job_amt;            // amount of jobs in the table
+    int job_cap;            // capacity of jobs
+    int current;            // id of the job fg and bg act on by default, 0 if none
+    int signal_fd;          // signalfd reporting SIGCHLD, polled instead of a signal handler
+    sigset_t child_mask;    // signal mask children are launched with, as the shell started
+    int job_control;        // flag for if jobs get their own process group and the terminal
+    pid_t shell_pgid;       // process group of the shell itself
+    struct termios tmodes;  // terminal modes restored whenever the shell takes the terminal back
+    int log_fd;             // fd a record of every finished job is written to, -1 if disabled
+    int log_owned;          // flag for if log_fd was opened by the shell and must be closed
+    PidSlot *slots;         // open addressing hash of every live process of the table's jobs
+    int slot_cap;           // capacity of slots, always a power of two
+    int slot_amt;           // amount of occupied slots
+} JobTable;
+
+// struct for the event loop, an epoll instance waiting on the terminal, the signalfd and a
+// periodic timer at once
+typedef struct {
+    int epoll_fd;   // epoll instance, -1 until the first wait
+    int input_fd;   // fd registered for EVENT_INPUT, -1 if none
+    int child_fd;   // signalfd registered for EVENT_CHILD, -1 if none
+    int timer_fd;   // timerfd registered for EVENT_TIMER, -1 until a timer is first armed
+    int timer_ms;   // period the timer is armed with, 0 if disarmed
+} EventLoop;
+
+// Enum for the hot paths of the shell timed by the tracing layer
+typedef enum {
+    TRACE_INPUT,    // reading the next line of input, including prompt rendering
+    TRACE_PARSE,    // lexing and parsing a line into its pipelines
+    TRACE_LOOKUP,   // resolving a command through the command hash table
+    TRACE_SPAWN,    // launching a single stage of a pipeline
+    TRACE_WAIT,     // waiting for a foreground job to finish or stop
+    TRACE_BUILTIN,  // running a lone built-in command in the shell process
+    TRACE_PHASES    // amount of traced phases
+} TracePhase;
+
+// struct for a log2 latency histogram of a single traced phase
+typedef struct {
+    unsigned long long buckets[TRACE_BUCKETS];  // bucket i counts latencies in [2^(i-1), 2^i) ns
+    unsigned long long count;                   // amount of recorded latencies
+    unsigned long long total_ns;                // sum of every recorded latency
+    unsigned long long min_ns;                  // smallest recorded latency
+    unsigned long long max_ns;                  // largest recorded latency
+} TraceHistogram;
+
+// struct for every histogram of the tracing layer
+typedef struct {
+    int enabled;                           // flag for if latencies are currently recorded
+    TraceHistogram phases[TRACE_PHASES];   // one histogram per traced phase
+} TraceStats;
+
+// struct for the time spent in every phase of startup, as printed by --startup-profile
+typedef struct {
+    int enabled;                             // flag for if phases are timed
+    struct timespec start;                   // when main() started
+    struct timespec last;                    // when the previous phase ended
+    int phase_amt;                           // amount of timed phases
+    const char *names[STARTUP_PHASES_MAX];   // name of every timed phase
+    long long ns[STARTUP_PHASES_MAX];        // time spent in every timed phase
+} StartupProfile;
+
+// struct to hold the current state of the shell, declared below
+typedef struct SHrimpState SHrimpState;
+
+// function implementing a built-in command, returning its exit status
+typedef int (*BuiltinFunc)(char **args, SHrimpState *state);
+
+// struct for a single entry of the built-in command dispatch table
+typedef struct {
+    const char *name;  // name of the built-in command
+    BuiltinFunc func;  // function implementing the built-in command
+    int flags;         // BUILTIN_SPECIAL if the command changes the state of the shell itself
+} Builtin;
+
 // struct for handling a shell command
 typedef struct {
-    char **args;               // array to store parsed tokens
-    int background;            // flag for if this command runs in the background
+    char **args;               // NULL terminated array to store parsed tokens, without any redirection tokens
+    int arg_amt;               // amount of tokens in args
+    int arg_cap;               // amount of tokens args can hold before growing, excluding the NULL
+    size_t arg_bytes;          // combined size of every token in args, checked against ARG_MAX
     int input_redirect;        // flag for if this command uses input redirection 
     int output_redirect;       // flag for if this command uses output redirection 
     int append_redirect;       // flag for if this command uses append redirection  
-    int has_builtin;           // flag for if this command has a built-in command
-    int index;                 // index of < token in args if it is present
-    int outdex;                // index of > token in args if it is present
-    int appenddex;             // index of >> token in args if it is present
+    const Builtin *builtin;    // built-in command to run instead of an executable, NULL if none
+    char *infile;              // file named by the < token if it is present
+    char *outfile;             // file named by the > or >> token if it is present
+    char *here;                // text fed to stdin by a <<< here-string or << here-doc, NULL if none
+    size_t here_len;           // length of here in bytes
+    char *here_delim;          // delimiter of a << here-doc, whose body is read after the line
+    int has_status;            // flag for if an arg of this command holds $?, expanded every time it runs
+    char **words;              // args as parsed, before $? was expanded into them, NULL until first expanded
 } SHrimpCommand; 
 
-// struct for holding all shell commands in a line of input, separated by semi colons
-typedef struct {
-    char *commands[MAX_COMMANDS];   // array of all commands in a line of input
-    int command_amt;                // amount of commands in a line of input
-} Commands;
+// Enum for the condition on the status of the previous pipeline a pipeline only runs under
+typedef enum {
+    LIST_ALWAYS,  // separated by ;, & or &|, or first on the line
+    LIST_AND,     // joined by &&, runs if the previous pipeline succeeded
+    LIST_OR       // joined by ||, runs if the previous pipeline failed
+} ListCondition;
 
 // struct for holding the parsed command pipeline to execute
 typedef struct {    
-    SHrimpCommand *commands[MAX_COMMANDS];  // array of SHrimpCommand objects to execute sequentially
+    SHrimpCommand **commands;               // array of SHrimpCommand objects to execute sequentially
     int command_amt;                        // amount of commands in this pipeline
+    int command_cap;                        // amount of commands the array can hold before growing
     int background;                         // flag for if this pipeline runs in the background
     int has_pipe;                           // flag for if this pipeline has at least one pipe
     int has_redirect;                       // flag for if this pipeline has at least one redirect token
     int has_builtin;                        // flag for if this pipeline has a built-in command
+    int timed;                              // flag for if this pipeline is prefixed with time
+    int parallel;                           // flag for if this pipeline runs at once with the next one, joined by &|
+    int prio;                               // flag for if this pipeline is prefixed with prio
+    int nice;                               // niceness every stage adds before executing, set by prio
+    int ioprio;                             // I/O priority every stage sets before executing, 0 to keep the shell's
+    int pin;                                // flag for if this pipeline is prefixed with pin
+    int pin_node;                           // NUMA node the stages are pinned to, PIN_NODE_AUTO to pick one
+    ListCondition condition;                // condition on the status of the previous pipeline, set by && and ||
+    int has_status;                         // flag for if an arg of this pipeline holds $?
+    int bench;                              // flag for if this pipeline is prefixed with bench
+    int bench_runs;                         // amount of measured runs, set by bench -n
+    int bench_warmup;                       // amount of runs before them that are not measured, set by bench -w
+    int bench_json;                         // flag for if bench reports in JSON rather than as a table, set by bench -j
+    BenchSample *sample;                    // where the job of the current run stores its resource use, NULL if none
 } Pipeline;
 
-// struct to hold the current state of the shell
+// struct for holding all shell commands in a line of input, separated by semi colons, &,
+// &|, && or ||
+typedef struct {
+    Pipeline **commands;               // array of all parsed commands in a line of input
+    int command_amt;                   // amount of commands in a line of input
+    int command_cap;                   // amount of commands the array can hold before growing
+    int heredoc_amt;                   // amount of << here-docs whose body follows the line
+} Commands;
+
+// struct for a single block of memory owned by an Arena
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;  // previously filled block, NULL for the first block
+    size_t size;              // amount of usable bytes in data
+    size_t used;              // amount of bytes already handed out from data
+    char data[];              // the memory handed out by arena_alloc()
+} ArenaBlock;
+
+// struct for a bump allocator owning all memory parsed from a line of input
+typedef struct {
+    ArenaBlock *head;  // block currently being allocated from
+    size_t total;      // combined size of every block in the arena
+} Arena;
+
+// struct for a single remembered command in the command hash table
+typedef struct HashEntry {
+    char *name;              // command name as typed by the user
+    char *path;              // resolved absolute path of the command's executable
+    int hits;                // amount of times this entry has been looked up
+    struct HashEntry *next;  // next entry in the same bucket
+} HashEntry;
+
+// struct for the command hash table, caching $PATH lookups between commands
 typedef struct {
-    int job_number;  // job number counter
-} SHrimpState;
+    HashEntry *buckets[HASH_BUCKETS];  // chained buckets of remembered commands
+    char *path_env;                    // copy of the $PATH value the table was filled against
+    int count;                         // amount of remembered commands
+    unsigned long generation;          // incremented whenever the table is cleared
+} CommandHash;
+
+// Enum for the engines available to launch the commands of a pipeline
+typedef enum {
+    SPAWN_INVALID = -1,
+    SPAWN_FORK,
+    SPAWN_POSIX,
+    SPAWN_SERVER
+} SpawnEngine;
+
+// struct for the spawn server, a small helper process that launches commands for the shell
+typedef struct {
+    pid_t pid;       // pid of the spawn server, 0 if it is not running
+    int sock;        // the shell's end of the socket to the spawn server
+    int cwd_stale;   // flag for if the shell changed directory since the server last followed
+} SpawnServer;
+
+// Header of a request to the spawn server, followed by the NUL terminated path, args and
+// redirection files of the command. The fds named by flags travel along as SCM_RIGHTS
+typedef struct {
+    int flags;         // SERVER_* flags of the request
+    pid_t pgid;        // process group to join if SERVER_SETPGID is set, 0 to start a new one
+    sigset_t sigmask;  // signal mask the child executes its command with
+    int arg_amt;       // amount of args following the path
+} SpawnRequest;
+
+// struct describing how to launch a single command of a pipeline
+typedef struct {
+    SHrimpCommand *cmd;  // command to launch
+    const char *path;    // resolved path of the command's executable, NULL if not found
+    int in_fd;           // fd to use as the command's stdin, -1 to inherit the shell's
+    int out_fd;          // fd to use as the command's stdout, -1 to inherit the shell's
+    int unused_fd;       // read end of the pipe the command writes to, -1 if none
+    const sigset_t *sigmask;  // signal mask the child executes its command with
+    pid_t pgid;          // process group to join, 0 to start a new one, -1 to stay in the shell's
+    int foreground;      // flag for if the child's process group takes over the terminal
+    int job_control;     // flag for if job control signals must be reset to their defaults
+    int cgroup_fd;       // cgroup v2 directory the child is created in, -1 for the shell's cgroup
+    int nice;            // niceness the child adds before executing, 0 to keep the shell's
+    int ioprio;          // I/O priority the child sets before executing, 0 to keep the shell's
+    const cpu_set_t *affinity;  // CPUs the child is pinned to before executing, NULL to keep the shell's
+    SHrimpState *state;  // shell state passed on to a built-in command
+    int status;          // status of the command if it could not be launched, 127 unless an engine sets another
+} SpawnSpec;
+
+// struct for the cached prompt, rendered again only once the directory or $HOME changed
+typedef struct {
+    char *text;    // fully rendered prompt, colors included
+    size_t len;    // length of text in bytes
+    size_t cap;    // size of the text buffer
+    size_t width;  // amount of columns the prompt takes up on the terminal
+    char *home;    // copy of the $HOME value the prompt was rendered against
+    int stale;     // flag set by cd to render the prompt again before it is next shown
+    int fixed;     // flag for a prompt whose text never changes, such as the here-doc prompt
+} Prompt;
+
+// struct for the command history, an append-only file mapped into memory and indexed lazily
+typedef struct {
+    int fd;                 // history file opened with O_APPEND, -1 if history is unavailable
+    const char *map;        // read-only mapping of the history file, NULL while it is empty
+    size_t map_len;         // length of the mapping in bytes
+    size_t indexed;         // bytes of the mapping covered by the index, always ending after a newline
+    size_t *offsets;        // offset of every indexed entry within the mapping
+    long count;             // amount of indexed entries
+    long cap;               // amount of entries offsets can hold before growing
+    unsigned char *blooms;  // trigram filter of every block of HISTORY_BLOCK_ENTRIES entries
+} History;
+
+// struct for a single node of the completion trie
+typedef struct {
+    char c;                       // character of the node
+    int child;                    // index of the first child, -1 if none
+    int sibling;                  // index of the next sibling in character order, -1 if none
+    unsigned long long sources;   // bit of every source holding the name ending here, 0 if none does
+} TrieNode;
+
+// struct for a prefix trie of command names, node 0 being the root
+typedef struct {
+    TrieNode *nodes;  // every node of the trie
+    int node_amt;     // amount of nodes in use
+    int node_cap;     // amount of nodes nodes can hold before growing
+} Trie;
+
+// struct for a $PATH directory scanned into the completion trie
+typedef struct {
+    char *path;              // path of the directory
+    struct timespec mtime;   // modification time of the directory when it was scanned
+} CompleteDir;
+
+// struct for the completion of command and file names
+typedef struct {
+    Trie trie;                 // executables of every $PATH directory and built-in commands
+    CompleteDir *dirs;         // the $PATH directories the trie was built from, in $PATH order
+    int dir_amt;               // amount of directories in dirs
+    char *path_env;            // copy of the $PATH value the trie is built from
+    unsigned long generation;  // generation of the command hash table the trie was built for
+    int started;               // flag for if the trie has been built or is being built
+    int building;              // flag for if the background build still has to be joined
+    pthread_t thread;          // thread running the background build
+    char *matches;             // every match of the last completion, each null terminated
+    size_t match_len;          // bytes of matches in use
+    size_t match_cap;          // size of the matches buffer
+    int match_amt;             // amount of matches of the last completion
+} Completer;
+
+// struct for the interactive line editor
+typedef struct {
+    char *buf;                // line being edited, null terminated
+    size_t len;               // length of the line in bytes
+    size_t cap;               // size of buf
+    size_t pos;               // offset of the cursor within the line
+    char *saved;              // line being edited before browsing the history, NULL if not browsing
+    long hist_pos;            // index of the history entry being shown while browsing
+    char *out;                // output buffer every refresh of the line is written from
+    size_t out_cap;           // size of out
+    struct termios cooked;    // terminal modes outside of the editor
+    History *history;         // history browsed with the arrow keys and Ctrl-R
+    CommandHash *hash;        // command hash table whose invalidation the completion shares
+    Completer completer;      // completion of command and file names
+    EventLoop *events;        // event loop waiting for keys and child exits, NULL to block in read()
+    SHrimpState *state;       // shell state whose finished background jobs are reported while editing
+} Editor;
+
+// Enum for the kinds of sources lines of input can be read from
+typedef enum {
+    INPUT_STDIN,   // read one line at a time from stdin, rendering the prompt on a terminal
+    INPUT_BUFFER   // split a script file or -c string that is already fully in memory
+} InputKind;
+
+// struct for a source of lines of input
+typedef struct {
+    InputKind kind;   // where lines are read from
+    int interactive;  // flag for if stdin is a terminal, checked once when opened
+    int display;      // flag to display the SHrimp prompt before the next line or not
+    char *buf;        // whole input of a INPUT_BUFFER source
+    size_t len;       // length of buf in bytes
+    size_t pos;       // offset of the next line within buf
+    int mapped;       // flag for if buf is a mapped script file that must be unmapped
+    char *tail;       // copy of an unterminated last line that could not be terminated in place
+    Prompt *prompt;   // prompt displayed before each line of an interactive INPUT_STDIN source
+    History *history; // history every line of an interactive INPUT_STDIN source is added to
+    Editor *editor;   // line editor of an interactive INPUT_STDIN source, NULL to read lines with getline()
+    int continued;    // flag for if the next line continues the last one, e.g. the body of a here-doc
+} InputSource;
+
+// Header of a compiled script cache file, followed by its lines, pipelines, commands, args
+// and strings in that order. Every record only holds 32 bit indexes and offsets, so the file
+// is used exactly as it was mapped
+typedef struct {
+    char magic[8];            // SCRIPT_CACHE_MAGIC
+    uint32_t version;         // SCRIPT_CACHE_VERSION of the parser that compiled the script
+    uint32_t builtins;        // fingerprint of the built-in table that builtin indexes refer to
+    uint64_t script_size;     // size of the script in bytes when it was compiled
+    int64_t mtime_sec;        // modification time of the script when it was compiled
+    int64_t mtime_nsec;
+    uint64_t script_hash;     // hash of the contents of the script
+    uint32_t path;            // offset of the absolute path of the script within the strings
+    uint32_t line_amt;        // amount of CacheLine records, one per line holding a pipeline or an error
+    uint32_t pipeline_amt;    // amount of CachePipeline records
+    uint32_t command_amt;     // amount of CacheCommand records
+    uint32_t arg_amt;         // amount of arg offsets
+    uint32_t string_len;      // bytes of null terminated strings
+} CacheHeader;
+
+// A single line of a compiled script
+typedef struct {
+    uint32_t code;            // ParseCode of the line, its pipelines are only valid for PARSE_OK
+    uint32_t first_pipeline;  // index of the first CachePipeline of the line
+    uint32_t pipeline_amt;    // amount of pipelines of the line
+} CacheLine;
+
+// struct for the NUMA nodes pinned pipelines are placed on, read once by the first of them
+typedef struct {
+    int loaded;        // flag for if the nodes have been read
+    int node_amt;      // amount of nodes holding a CPU the shell may run on
+    int *ids;          // number of every such node
+    cpu_set_t *cpus;   // CPUs of every such node that the shell may run on
+    int next;          // node automatic placement tries first, advanced by every placement
+} NumaTopology;
+
+// A single pipeline of a compiled script
+typedef struct {
+    uint32_t first_command;   // index of the first CacheCommand of the pipeline
+    uint32_t command_amt;     // amount of commands of the pipeline
+    uint32_t flags;           // CACHE_* flags of the pipeline
+    int32_t nice;             // niceness set by the prio prefix
+    int32_t ioprio;           // I/O priority set by the prio prefix
+    int32_t pin_node;         // NUMA node set by the pin prefix
+    int32_t condition;        // ListCondition set by && and ||
+    int32_t bench_runs;       // measured runs set by the bench prefix
+    int32_t bench_warmup;     // warmup runs set by the bench prefix
+} CachePipeline;
+
+// A single command of a compiled script
+typedef struct {
+    uint32_t first_arg;       // index of the offset of the first arg
+    uint32_t arg_amt;         // amount of args
+    uint32_t infile;          // offset of the file named by <, CACHE_NONE if there is none
+    uint32_t outfile;         // offset of the file named by > or >>, CACHE_NONE if there is none
+    uint32_t here;            // offset of the text of a here-string or here-doc, CACHE_NONE if there is none
+    uint32_t here_len;        // length of that text
+    uint32_t flags;           // CACHE_* flags of the command
+    int32_t builtin;          // index of the built-in command within the dispatch table, -1 if none
+} CacheCommand;
+
+// Counters of the stats file of a script cache directory, shared by every shell using it
+typedef struct {
+    uint64_t hits;    // runs that used a compiled script from the cache
+    uint64_t misses;  // runs that had to compile their script first
+} CacheStats;
+
+// struct for a compiled script, either mapped from the cache or compiled by this run
+typedef struct {
+    char *image;                   // the whole compiled script, laid out as a cache file
+    size_t len;                    // length of image in bytes
+    int mapped;                    // flag for if image is a mapping rather than allocated
+    const CacheHeader *header;     // header at the start of image
+    const CacheLine *lines;        // every line of the script
+    const CachePipeline *pipelines;
+    const CacheCommand *commands;
+    const uint32_t *args;          // offset of every arg within strings
+    char *strings;                 // every arg and file name, null terminated
+    uint32_t next;                 // index of the next line to run
+} ScriptCache;
+
+// struct to hold the current state of the shell
+struct SHrimpState {
+    JobTable jobs;     // every job launched by the shell that has not been collected yet
+    int last_status;   // exit status of the most recently executed command
+    Arena arena;       // owns all memory parsed from the current line of input
+    CommandHash hash;  // command hash table used to resolve commands without rescanning $PATH
+    SpawnEngine spawn_engine;  // engine used to launch the commands of a pipeline
+    int pipe_size;             // size applied to every pipe with F_SETPIPE_SZ, 0 for the kernel default
+    SpawnServer server;        // spawn server used by the server spawn engine
+    int parallel_limit;        // most pipelines of a &| group running at once, 0 for no limit
+    int pipestat_ms;           // interval of the pipe reports of foreground pipelines, 0 if disabled
+    int pipefail;              // flag for if a pipeline fails when any stage fails, not just the last
+    int cgroup_fd;             // cgroup v2 directory background pipelines run in, -1 if none
+    char *cgroup_path;         // path of that cgroup, NULL if none
+    NumaTopology numa;         // NUMA nodes the stages of pinned pipelines are placed on
+    EventLoop events;          // event loop of the prompt and of foreground waits with timers
+    Prompt prompt;             // cached prompt of interactive sessions
+    History history;           // command history shared by every session using the same file
+    Editor editor;             // line editor of interactive sessions
+#ifdef SHRIMP_TRACE
+    TraceStats trace;          // latency histograms of the shell's hot paths
+#endif
+};
 
 #endif
\ No newline at end of file
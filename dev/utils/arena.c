@@ -0,0 +1,162 @@
+/* arena.c
+ *
+ * Contains the logic for the bump allocator that owns all memory parsed from a single line
+ * of input, allowing it to be released in one step.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <stdlib.h>        // malloc(), free(), exit()
+#include <stdio.h>         // fprintf()
+#include <string.h>        // memcpy()
+#include "config/macros.h" // ARENA_ALIGN, RED_TEXT, RESET_COLOR
+#include "types/types.h"   // Arena, ArenaBlock
+#include "utils/arena.h"
+
+//======================================================================================
+
+/**
+ * @brief Allocates a new block able to hold at least size bytes and pushes it onto the
+ * front of the arena's block list.
+ *
+ * @param arena Arena object to add the block to.
+ * @param size the minimum amount of usable bytes in the block.
+ */
+static void arena_push_block(Arena *arena, size_t size) {
+    ArenaBlock *block = malloc(sizeof(ArenaBlock) + size);
+    if(!block) { // malloc failure
+        fprintf(stderr, RED_TEXT "Fatal Error: malloc() failed to allocate memory for %s. Terminating SHrimp now.\n" RESET_COLOR, "arena block");
+        exit(1);
+    }
+
+    block->next = arena->head;
+    block->size = size;
+    block->used = 0;
+    arena->head = block;
+    arena->total += size;
+}
+
+//======================================================================================
+
+/**
+ * @brief Initializes an arena with a single block of size bytes.
+ *
+ * @param arena Arena object to initialize.
+ * @param size the size of the first block in bytes.
+ */
+void arena_init(Arena *arena, size_t size) {
+    arena->head = NULL;
+    arena->total = 0;
+    arena_push_block(arena, size);
+}
+
+//======================================================================================
+
+/**
+ * @brief Allocates size bytes from the arena. The memory is not initialized.
+ *
+ * @param arena Arena object to allocate from.
+ * @param size the amount of memory to allocate in bytes.
+ *
+ * @return A pointer to the allocated memory, aligned to ARENA_ALIGN bytes.
+ *
+ * @details Allocation is a pointer bump within the current block. When the current block
+ * cannot fit the request, a new block at least twice the size of the previous one is
+ * chained on. Memory is never released individually, only all at once by arena_reset().
+ */
+void *arena_alloc(Arena *arena, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    ArenaBlock *block = arena->head;
+    if(block->used + size > block->size) {
+        size_t new_size = block->size * 2;
+        while(new_size < size)
+            new_size *= 2;
+        arena_push_block(arena, new_size);
+        block = arena->head;
+    }
+
+    void *ptr = block->data + block->used;
+    block->used += size;
+
+    return ptr;
+}
+
+//======================================================================================
+
+/**
+ * @brief Grows an array allocated from the arena, copying its contents into a new array.
+ *
+ * @param arena Arena object the array was allocated from.
+ * @param ptr the array to grow, or NULL to allocate a new one.
+ * @param old_size the size of the array in bytes.
+ * @param new_size the new size of the array in bytes.
+ *
+ * @return A pointer to the grown array. The old array is not reused until the arena is
+ * reset, so callers should grow geometrically to keep the total waste bounded.
+ */
+void *arena_grow(Arena *arena, void *ptr, size_t old_size, size_t new_size) {
+    void *grown = arena_alloc(arena, new_size);
+    if(ptr != NULL && old_size > 0)
+        memcpy(grown, ptr, old_size);
+
+    return grown;
+}
+
+//======================================================================================
+
+/**
+ * @brief Releases every allocation made from the arena in one step.
+ *
+ * @param arena Arena object to reset.
+ *
+ * @details If the previous line needed more than one block, every block is freed and
+ * replaced by a single block large enough to hold all of them, so a long line is only
+ * ever chained once and later lines of the same length are a plain pointer bump.
+ */
+void arena_reset(Arena *arena) {
+    if(arena->head->next == NULL) {
+        arena->head->used = 0;
+        return;
+    }
+
+    size_t total = arena->total;
+    arena_free(arena);
+    arena_init(arena, total);
+}
+
+//======================================================================================
+
+/**
+ * @brief Frees every block owned by the arena.
+ *
+ * @param arena Arena object to free.
+ */
+void arena_free(Arena *arena) {
+    ArenaBlock *block = arena->head;
+    while(block != NULL) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    arena->head = NULL;
+    arena->total = 0;
+}
+
+//======================================================================================
@@ -0,0 +1,35 @@
+/* arena.h
+ *
+ * Contains the bump allocator used for per-line parse memory. Header file for arena.c.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>      // size_t
+#include "types/types.h" // Arena
+
+void arena_init(Arena *arena, size_t size);
+void *arena_alloc(Arena *arena, size_t size);
+void *arena_grow(Arena *arena, void *ptr, size_t old_size, size_t new_size);
+void arena_reset(Arena *arena);
+void arena_free(Arena *arena);
+
+#endif
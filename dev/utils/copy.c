@@ -0,0 +1,168 @@
+/* copy.c
+ *
+ * Contains the data mover of SHrimp, which copies between file descriptors inside the
+ * kernel whenever it can and falls back to read/write otherwise.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <sys/types.h>     // ssize_t
+#include <sys/stat.h>      // struct stat, fstat(), S_ISREG(), S_ISFIFO()
+#include <sys/sendfile.h>  // sendfile()
+#include <unistd.h>        // copy_file_range(), read(), write()
+#include <fcntl.h>         // splice(), fcntl(), F_GETFL, O_APPEND, SPLICE_F_MOVE
+#include <errno.h>         // errno, EINTR
+#include "config/macros.h" // COPY_CHUNK_SIZE, COPY_BUFFER_SIZE, COPY_BUFFER_ALIGN
+#include "utils/copy.h"
+
+// Ways of moving data, from the cheapest to the most general
+typedef enum {
+    COPY_RANGE,
+    COPY_SENDFILE,
+    COPY_SPLICE,
+    COPY_READ_WRITE
+} CopyMode;
+
+//======================================================================================
+
+/**
+ * @brief Picks the cheapest way of moving data between two file descriptors.
+ *
+ * @param in the fstat() of the fd to read from.
+ * @param out the fstat() of the fd to write to.
+ * @param append whether the fd to write to was opened with O_APPEND.
+ * @param from the mode to start searching from, so a mode that failed is not picked again.
+ *
+ * @return The first mode at or after from that the file types allow.
+ *
+ * @details copy_file_range() needs two regular files and sendfile() needs a regular file to
+ * read from, while splice() needs a pipe on either end. None of them write to an O_APPEND
+ * file, so appending always goes through read/write.
+ */
+static CopyMode copy_mode(const struct stat *in, const struct stat *out, int append, CopyMode from) {
+    int out_regular = S_ISREG(out->st_mode);
+
+    if(from <= COPY_RANGE && S_ISREG(in->st_mode) && out_regular && !append)
+        return COPY_RANGE;
+    if(from <= COPY_SENDFILE && S_ISREG(in->st_mode) && !(out_regular && append))
+        return COPY_SENDFILE;
+    if(from <= COPY_SPLICE && (S_ISFIFO(in->st_mode) || S_ISFIFO(out->st_mode)) && !(out_regular && append))
+        return COPY_SPLICE;
+
+    return COPY_READ_WRITE;
+}
+
+//======================================================================================
+
+/**
+ * @brief Moves a single chunk of data with read() and write().
+ *
+ * @param in_fd the fd to read from.
+ * @param out_fd the fd to write to.
+ *
+ * @return The amount of bytes moved, 0 at the end of the input, or -1 on error.
+ *
+ * @details The buffer is page aligned and large enough that each system call moves a
+ * meaningful amount of data. Short writes are retried until the whole chunk is written.
+ */
+static ssize_t copy_read_write(int in_fd, int out_fd) {
+    static _Alignas(COPY_BUFFER_ALIGN) char buf[COPY_BUFFER_SIZE];
+
+    ssize_t got = read(in_fd, buf, sizeof(buf));
+    if(got <= 0)
+        return got;
+
+    for(ssize_t written = 0; written < got;) {
+        ssize_t put = write(out_fd, buf + written, got - written);
+        if(put < 0 && errno != EINTR)
+            return -1;
+        if(put > 0)
+            written += put;
+    }
+
+    return got;
+}
+
+//======================================================================================
+
+/**
+ * @brief Copies everything left to read from one file descriptor to another.
+ *
+ * @param in_fd the fd to read from, starting at its current offset.
+ * @param out_fd the fd to write to, starting at its current offset.
+ * @param interrupted flag set by a signal handler to stop the copy, or NULL.
+ *
+ * @return 0 once the end of the input was reached, -1 on error with errno set, or with
+ * errno set to EINTR if interrupted was set.
+ *
+ * @details Data between two regular files moves with copy_file_range(), which can share
+ * extents on filesystems that support it, data out of a regular file with sendfile() and
+ * data to or from a pipe with splice(), so the bytes never pass through user space. Every
+ * file offset is advanced by the kernel, so whenever a mode is refused the next one picks
+ * up exactly where it stopped. A mode reporting the end of the input is confirmed with a
+ * read(), since pseudo files such as those in /proc can report a size of 0.
+ */
+int fd_copy(int in_fd, int out_fd, const volatile sig_atomic_t *interrupted) {
+    struct stat in_st, out_st;
+    if(fstat(in_fd, &in_st) < 0 || fstat(out_fd, &out_st) < 0)
+        return -1;
+
+    int flags = fcntl(out_fd, F_GETFL);
+    int append = flags >= 0 && (flags & O_APPEND);
+    CopyMode mode = copy_mode(&in_st, &out_st, append, COPY_RANGE);
+
+    while(interrupted == NULL || !*interrupted) {
+        ssize_t moved;
+        switch(mode) {
+            case COPY_RANGE:
+                moved = copy_file_range(in_fd, NULL, out_fd, NULL, COPY_CHUNK_SIZE, 0);
+                break;
+            case COPY_SENDFILE:
+                moved = sendfile(out_fd, in_fd, NULL, COPY_CHUNK_SIZE);
+                break;
+            case COPY_SPLICE:
+                moved = splice(in_fd, NULL, out_fd, NULL, COPY_CHUNK_SIZE, SPLICE_F_MOVE);
+                break;
+            default:
+                moved = copy_read_write(in_fd, out_fd);
+                break;
+        }
+
+        if(moved > 0)
+            continue;
+        if(moved == 0 && mode == COPY_READ_WRITE)
+            return 0;
+        if(moved == 0) {
+            mode = COPY_READ_WRITE;
+            continue;
+        }
+
+        if(errno == EINTR)
+            continue;
+        // Errors of read() and write() are real, while the others may only mean that the
+        // kernel cannot move data between these two files
+        if(mode == COPY_READ_WRITE)
+            return -1;
+        mode = copy_mode(&in_st, &out_st, append, (CopyMode)(mode + 1));
+    }
+
+    errno = EINTR;
+    return -1;
+}
+
+//======================================================================================
@@ -0,0 +1,100 @@
+/* profile.c
+ *
+ * Contains the startup profile of SHrimp, which times every phase of initialization when
+ * the shell is started with --startup-profile.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#include <stdio.h>         // fprintf()
+#include <time.h>          // struct timespec, clock_gettime()
+#include "config/macros.h" // STARTUP_PHASES_MAX
+#include "types/types.h"   // StartupProfile
+#include "utils/profile.h"
+
+//======================================================================================
+
+/**
+ * @brief Computes the nanoseconds elapsed between two points in time.
+ *
+ * @param from the earlier point in time.
+ * @param to the later point in time.
+ *
+ * @return The nanoseconds between from and to.
+ */
+static long long elapsed_ns(const struct timespec *from, const struct timespec *to) {
+    return (long long)(to->tv_sec - from->tv_sec) * 1000000000LL + (to->tv_nsec - from->tv_nsec);
+}
+
+//======================================================================================
+
+/**
+ * @brief Starts timing startup, from the very beginning of main().
+ *
+ * @param profile StartupProfile object to start. Nothing is timed unless it is enabled.
+ */
+void profile_start(StartupProfile *profile) {
+    if(!profile->enabled)
+        return;
+
+    clock_gettime(CLOCK_MONOTONIC, &profile->start);
+    profile->last = profile->start;
+}
+
+//======================================================================================
+
+/**
+ * @brief Records the time spent in the phase of startup that just ended.
+ *
+ * @param profile StartupProfile object to record in.
+ * @param phase name of the phase, running from the previous mark until now.
+ *
+ * @details A disabled profile returns right away without reading the clock, so the marks
+ * cost nothing on a normal start.
+ */
+void profile_mark(StartupProfile *profile, const char *phase) {
+    if(!profile->enabled || profile->phase_amt == STARTUP_PHASES_MAX)
+        return;
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    profile->names[profile->phase_amt] = phase;
+    profile->ns[profile->phase_amt++] = elapsed_ns(&profile->last, &now);
+    profile->last = now;
+}
+
+//======================================================================================
+
+/**
+ * @brief Prints the time spent in every phase of startup, followed by the total.
+ *
+ * @param profile StartupProfile object to print.
+ * @param out the stream to print to.
+ *
+ * @details The total runs from the start of main() until the last mark. The time the
+ * kernel and the dynamic linker spent before main() is not included, which bench/startup.sh
+ * measures from the outside instead.
+ */
+void profile_dump(const StartupProfile *profile, FILE *out) {
+    fprintf(out, "%-10s %10s\n", "phase", "time");
+    for(int i = 0; i < profile->phase_amt; i++)
+        fprintf(out, "%-10s %8.1fus\n", profile->names[i], profile->ns[i] / 1e3);
+    fprintf(out, "%-10s %8.1fus\n", "total", elapsed_ns(&profile->start, &profile->last) / 1e3);
+}
+
+//======================================================================================
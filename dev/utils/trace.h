@@ -0,0 +1,46 @@
+/* trace.h
+ *
+ * Header file for trace.c
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Author: Ryan McHenry
+ * Created: October 14, 2026
+ * Last Modified: October 14, 2026
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>       // FILE
+#include <time.h>        // struct timespec, clock_gettime()
+#include "types/types.h" // TraceStats, TracePhase
+
+// The tracing layer only exists in builds made with make TRACE=1. Otherwise every macro
+// below expands to nothing, so the hot paths carry no timing code at all
+#ifdef SHRIMP_TRACE
+#define TRACE_DECLARE(ts) struct timespec ts = {0, 0}
+#define TRACE_START(state, ts) do { if((state)->trace.enabled) clock_gettime(CLOCK_MONOTONIC, &(ts)); } while(0)
+#define TRACE_STOP(state, phase, ts) do { if((state)->trace.enabled) trace_record(&(state)->trace, (phase), &(ts)); } while(0)
+#else
+#define TRACE_DECLARE(ts)
+#define TRACE_START(state, ts) do { } while(0)
+#define TRACE_STOP(state, phase, ts) do { } while(0)
+#endif
+
+void trace_record(TraceStats *stats, TracePhase phase, const struct timespec *start);
+void trace_reset(TraceStats *stats);
+void trace_dump(const TraceStats *stats, FILE *out);
+
+#endif
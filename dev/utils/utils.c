@@ -17,13 +17,13 @@
  *
  * Author: Ryan McHenry
  * Created: Feberuary 4, 2026
- * Last Modified: February 14, 2026
+ * Last Modified: October 14, 2026
  */
 
 #include <stdio.h>          // fprintf()
 #include <stdlib.h>         // malloc()
 #include "config/macros.h"  // RED_TEXT, RESET_COLOR
-#include <string.h>         // memset()
+#include <string.h>         // memset(), memcpy(), strlen()
 #include "utils/utils.h"
 
 //======================================================================================
@@ -49,4 +49,25 @@ void *safe_malloc(size_t size, const char *context) {
     return ptr;
 }
 
+//======================================================================================
+
+/**
+ * @brief Safely duplicates a string onto the heap. Safely handles malloc failures.
+ *
+ * @param str the null terminated string to duplicate
+ * @param context a string used in the case of malloc failures to print the context of where
+ * the failure occured.
+ */
+char *safe_strdup(const char *str, const char *context) {
+    size_t len = strlen(str) + 1;
+    char *copy = malloc(len);
+    if(!copy){ // malloc failure
+        fprintf(stderr, RED_TEXT "Fatal Error: malloc() failed to allocate memory for %s. Terminating SHrimp now.\n" RESET_COLOR, context);
+        exit(1);
+    }
+    memcpy(copy, str, len);
+
+    return copy;
+}
+
 //======================================================================================
\ No newline at end of file
@@ -17,7 +17,7 @@
  *
  * Author: Ryan McHenry
  * Created: Feberuary 4, 2026
- * Last Modified: February 4, 2026
+ * Last Modified: October 14, 2026
  */
 
 #ifndef UTILS_H
@@ -26,5 +26,6 @@
 #include <stddef.h> // size_t
 
 void *safe_malloc(size_t size, const char *context);
+char *safe_strdup(const char *str, const char *context);
 
 #endif
\ No newline at end of file
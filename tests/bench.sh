@@ -0,0 +1,95 @@
+#!/bin/bash
+#
+# bench.sh
+#
+# Tests benchmarking pipelines with the bench prefix
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# bench runs the warmup runs and then the measured runs, reporting only the latter
+rm -f bench_out.txt
+OUTPUT=$("$SHRIMP_BIN" -c 'bench -n 5 -w 2 -- echo x | cat >> bench_out.txt' | awk 'NR == 1 { print $1, $2, $3, $NF } NR == 2 { print $1, $2, $(NF - 2), $(NF - 1) }')
+OUTPUT="$OUTPUT $(wc -l < bench_out.txt)"
+EXPECTED=$'runs failed min command\n5 0 cat >> 7'
+rm -f bench_out.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "bench.sh: RUNS TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# -j reports a single JSON object, failed runs are counted and the status is that of the last run
+OUTPUT=$("$SHRIMP_BIN" -c 'bench -j -n 3 false; echo $?' | sed 's/"real".*/REPORT/')
+EXPECTED=$'{"command":"false","runs":3,"warmup":0,"failed":3,REPORT\n1'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "bench.sh: JSON TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# A lone built-in runs in the shell itself, and $? is expanded again before every run
+rm -f bench_out.txt
+OUTPUT=$("$SHRIMP_BIN" -c 'false; bench -n 3 -- echo $? >> bench_out.txt; bench -n 2 cd /; pwd; false; bench -j -n 3 -- echo $?' | grep '^[/{]' | sed 's/,"real".*//')
+OUTPUT="$OUTPUT $(cat bench_out.txt | tr '\n' ' ')"
+EXPECTED=$'/\n{"command":"echo 0","runs":3,"warmup":0,"failed":0 1 0 0 '
+rm -f bench_out.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "bench.sh: BUILTIN TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# A compiled script runs its benchmark the same way, without parsing it again
+export SHRIMP_SCRIPT_CACHE="$PWD/bench_cache"
+rm -rf bench_cache bench_out.txt
+echo 'bench -n 3 -w 1 -- echo x >> bench_out.txt' > bench_test.sh
+"$SHRIMP_BIN" bench_test.sh > /dev/null
+"$SHRIMP_BIN" bench_test.sh > /dev/null
+OUTPUT="$(wc -l < bench_out.txt) $("$SHRIMP_BIN" -c 'scriptcache' | head -n 1)"
+EXPECTED="8 hits: 1"
+rm -rf bench_cache bench_out.txt bench_test.sh
+unset SHRIMP_SCRIPT_CACHE
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "bench.sh: CACHE TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# The amount of runs must be in range and a benchmark cannot run in the background
+OUTPUT=$(printf '%s\n' 'bench -n 0 true' 'bench -w x true' 'bench -n 2 true &' 'bench -j' | "$SHRIMP_BIN" 2>&1)
+EXPECTED=$(printf '\033[31mBench error: expected -n 1 to 100000, -w 0 to 100000, -j or --, and no & or &|\n\033[0m%.0s' 1 2 3; printf '\033[31mError: missing command\n\033[0m')
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "bench.sh: PARSE ERROR TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
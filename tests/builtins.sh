@@ -0,0 +1,80 @@
+#!/bin/bash
+#
+# builtins.sh
+#
+# Tests the fork-free built-in commands echo, true, false, pwd and printf
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# Built-ins never look up an executable, so the hash table stays empty
+OUTPUT=$(printf 'echo -n sea; echo horse\npwd\ntrue\nhash\n' | "$SHRIMP_BIN")
+EXPECTED=$'seahorse\n'"$PWD"$'\nhash: hash table empty'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "builtins.sh: IN-PROCESS BUILT-IN TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# printf reuses its format until every argument is consumed
+OUTPUT=$(echo 'printf %s=%03d\n crab 7 squid 42' | "$SHRIMP_BIN")
+EXPECTED=$'crab=007\nsquid=042'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "builtins.sh: PRINTF TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Redirecting a built-in leaves the shell's own stdout intact afterwards
+OUTPUT=$(echo 'echo clam > builtin_out.txt; echo mussel >> builtin_out.txt; echo oyster' | "$SHRIMP_BIN")
+FILE=$(cat builtin_out.txt)
+rm -f builtin_out.txt
+
+if [ "$OUTPUT" != "oyster" ] || [ "$FILE" != $'clam\nmussel' ]; then
+    echo "builtins.sh: BUILT-IN REDIRECTION TEST FAILED"
+    echo "Expected: oyster and "$'clam\nmussel'""
+    echo "Output: "$OUTPUT" and "$FILE""
+    exit 1
+fi
+
+# Built-in stages of a pipeline
+OUTPUT=$(echo 'echo one two three | wc -w' | "$SHRIMP_BIN")
+EXPECTED=3
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "builtins.sh: BUILT-IN PIPELINE TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# true and false set the exit status
+STATUS=0
+"$SHRIMP_BIN" -c 'true; false' || STATUS=$?
+if [ "$STATUS" -ne 1 ]; then
+    echo "builtins.sh: FALSE STATUS TEST FAILED"
+    echo "Expected: 1"
+    echo "Output: "$STATUS""
+    exit 1
+fi
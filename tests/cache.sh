@@ -0,0 +1,76 @@
+#!/bin/bash
+#
+# cache.sh
+#
+# Tests the compiled script cache and the scriptcache built-in
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+export SHRIMP_SCRIPT_CACHE="$PWD/cache_dir"
+rm -rf cache_dir
+
+# A script runs the same when it is compiled into the cache and when it runs from it, parse
+# errors included
+printf '# a comment\necho one two | wc -w\nfalse && echo skipped || echo status $?\necho three > cache_out.txt; cat < cache_out.txt\necho |\ntrue &| echo four\nexit 3\necho never\n' > cache_test.sh
+OUTPUT=$("$SHRIMP_BIN" cache_test.sh 2>&1; echo "status $?"; "$SHRIMP_BIN" cache_test.sh 2>&1; echo "status $?")
+UNCACHED=$(SHRIMP_SCRIPT_CACHE= "$SHRIMP_BIN" cache_test.sh 2>&1; echo "status $?")
+EXPECTED="$UNCACHED"$'\n'"$UNCACHED"
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "cache.sh: CACHED RUN TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    rm -rf cache_dir cache_test.sh cache_out.txt
+    exit 1
+fi
+
+OUTPUT=$("$SHRIMP_BIN" -c 'scriptcache')
+EXPECTED=$'hits: 1\nmisses: 1\nhit rate: 50.0%'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "cache.sh: HIT RATE TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    rm -rf cache_dir cache_test.sh cache_out.txt
+    exit 1
+fi
+
+# Changing the script, or damaging its cache file, compiles the script again
+"$SHRIMP_BIN" -c 'scriptcache -r'
+printf 'echo five\n' > cache_test.sh
+OUTPUT=$("$SHRIMP_BIN" cache_test.sh)
+for file in cache_dir/*.shc; do
+    head -c 100 "$file" > cache_damaged.shc
+    mv cache_damaged.shc "$file"
+done
+OUTPUT="$OUTPUT $("$SHRIMP_BIN" cache_test.sh) $("$SHRIMP_BIN" cache_test.sh)"
+OUTPUT="$OUTPUT $("$SHRIMP_BIN" -c 'scriptcache' | tr '\n' ' ')"
+EXPECTED="five five five hits: 1 misses: 2 hit rate: 33.3% "
+rm -rf cache_dir cache_test.sh cache_out.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "cache.sh: INVALIDATION TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
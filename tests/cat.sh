@@ -0,0 +1,79 @@
+#!/bin/bash
+#
+# cat.sh
+#
+# Tests the cat built-in command and its zero-copy data mover
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# File to file, file to pipe, pipe to pipe and appending each take a different path
+head -c 3000000 /dev/urandom > cat_in.bin
+"$SHRIMP_BIN" -c 'cat < cat_in.bin > cat_out1.bin; cat cat_in.bin | cat | cat > cat_out2.bin; cat cat_in.bin >> cat_out3.bin; cat - cat_in.bin < cat_in.bin >> cat_out3.bin'
+cat cat_in.bin cat_in.bin cat_in.bin cat_in.bin cat_in.bin > cat_expected.bin
+OUTPUT=$(cat cat_out1.bin cat_out2.bin cat_out3.bin | cmp - cat_expected.bin && echo same)
+EXPECTED="same"
+rm -f cat_in.bin cat_out1.bin cat_out2.bin cat_out3.bin cat_expected.bin
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "cat.sh: COPY TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Pseudo files report a size of 0 but still have contents
+OUTPUT=$("$SHRIMP_BIN" -c 'cat /proc/self/stat > cat_out.txt; wc -l < cat_out.txt')
+EXPECTED="1"
+rm -f cat_out.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "cat.sh: PSEUDO FILE TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# A missing file is reported and skipped, and fails the command
+OUTPUT=$("$SHRIMP_BIN" -c 'echo one > cat_a.txt; cat cat_missing.txt cat_a.txt' 2>cat_err.txt; echo "status=$?")
+EXPECTED=$'one\nstatus=1'
+ERROR=$(cat cat_err.txt)
+rm -f cat_a.txt cat_err.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ] || [[ "$ERROR" != *"cat: cat_missing.txt: No such file or directory"* ]]; then
+    echo "cat.sh: MISSING FILE TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT" "$ERROR""
+    exit 1
+fi
+
+# Options the built-in does not support run the external cat, alone or as a pipeline stage
+OUTPUT=$("$SHRIMP_BIN" -c 'printf a\nb\n > cat_a.txt; cat -n cat_a.txt; echo one | cat -n; cat cat_a.txt -n' 2>&1; echo "status=$?")
+EXPECTED=$'     1\ta\n     2\tb\n     1\tone\n     1\ta\n     2\tb\nstatus=0'
+rm -f cat_a.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "cat.sh: EXTERNAL CAT TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,99 @@
+#!/bin/bash
+#
+# editor.sh
+#
+# Tests the line editor and TAB completion, run on a pseudo terminal through script
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# The line editor only runs on a terminal
+if ! command -v script > /dev/null; then
+    exit 0
+fi
+
+# Runs an interactive session typing each arg as a line of keys. The lines are typed one at a
+# time, since keys typed ahead while a command runs reach the terminal in cooked mode
+run_keys() {
+    for keys in "$@"; do
+        sleep 0.2
+        printf "$keys"
+    done | TERM=xterm SHRIMP_HISTFILE="$PWD/editor_history.txt" script -qec "$SHRIMP_BIN" /dev/null > /dev/null
+}
+
+# TAB completes built-ins and $PATH commands from the trie, and file names from the directory
+mkdir -p editor_dir
+touch editor_dir/unique_file.txt
+run_keys 'ech\tone > editor_out.txt\r' 'exit\r'
+OUTPUT=$(cat editor_out.txt)
+EXPECTED="one"
+rm -f editor_out.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "editor.sh: COMMAND COMPLETION TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    rm -rf editor_dir editor_history.txt
+    exit 1
+fi
+
+run_keys 'echo editor_dir/uni\t> editor_out.txt\r' 'exit\r'
+OUTPUT=$(cat editor_out.txt)
+EXPECTED="editor_dir/unique_file.txt"
+rm -rf editor_out.txt editor_dir
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "editor.sh: FILE COMPLETION TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    rm -f editor_history.txt
+    exit 1
+fi
+
+# The body of a here-doc is typed after a "> " prompt, and is left out of the history
+rm -f editor_history.txt
+run_keys 'cat <<EOF > editor_out.txt\r' 'body\r' 'EOF\r' 'exit\r'
+OUTPUT=$(cat editor_out.txt; tr '\0' '\n' < editor_history.txt)
+EXPECTED=$(printf "body\ncat <<EOF > editor_out.txt\nexit")
+rm -f editor_out.txt editor_history.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "editor.sh: HERE-DOC TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Up recalls the previous line, which can be edited before it runs, Ctrl-R searches the
+# history, and Ctrl-C discards the line being edited
+rm -f editor_history.txt
+run_keys 'echo first > editor_out.txt\r' 'rm editor_out.txt\r' 'never\003' '\022first\r' '\033[A\033[D\033[D\033[D\033[D\177\177\177new\r' 'exit\r'
+OUTPUT=$(cat editor_out.txt editor_new.txt)
+EXPECTED=$(printf "first\nfirst")
+rm -f editor_out.txt editor_new.txt editor_history.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "editor.sh: HISTORY TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,57 @@
+#!/bin/bash
+#
+# hash.sh
+#
+# Tests the command hash table and the hash built-in command
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# Commands are remembered after their first lookup
+OUTPUT=$(printf 'ls /\nls /\nhash\n' | "$SHRIMP_BIN" | grep '/ls$')
+EXPECTED="   2	$(command -v ls)"
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "hash.sh: HASH FILL TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# hash -r forgets every remembered command
+OUTPUT=$(printf 'ls /\nhash -r\nhash\n' | "$SHRIMP_BIN" | tail -n 1)
+EXPECTED="hash: hash table empty"
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "hash.sh: HASH CLEAR TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Unknown commands are reported and not remembered
+OUTPUT=$(printf 'shrimp_no_such_command\nhash\n' | "$SHRIMP_BIN" 2>&1 | tail -n 1)
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "hash.sh: HASH MISS TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
@@ -0,0 +1,88 @@
+#!/bin/bash
+#
+# heredoc.sh
+#
+# Tests here-strings and here-docs
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+OUTPUT=$($SHRIMP_BIN -c 'cat <<< one
+wc -c <<<two | cat')
+EXPECTED=$(printf "one\n4")
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "heredoc.sh: HERE-STRING TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# The body of a here-doc is every line up to its delimiter, and the last of <, << and <<< wins
+printf 'cat <<EOF\none\n  two three\nEOF\ntr a-z A-Z <<END | cat\nfour\nEND\ncat < /dev/null <<< five\necho six\n' > heredoc_script.sh
+OUTPUT=$($SHRIMP_BIN heredoc_script.sh)
+EXPECTED=$(printf "one\n  two three\nFOUR\nfive\nsix")
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "heredoc.sh: HERE-DOC TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    rm -f heredoc_script.sh
+    exit 1
+fi
+
+# The script cache compiles here-doc bodies along with their commands
+mkdir -p heredoc_cache
+SHRIMP_SCRIPT_CACHE="$PWD/heredoc_cache" $SHRIMP_BIN heredoc_script.sh > /dev/null
+OUTPUT=$(SHRIMP_SCRIPT_CACHE="$PWD/heredoc_cache" $SHRIMP_BIN heredoc_script.sh)
+rm -rf heredoc_cache heredoc_script.sh
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "heredoc.sh: CACHED HERE-DOC TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Small text goes through a pipe, while text too large for one goes through a memfd
+(echo 'readlink /proc/self/fd/0 <<EOF'; head -c 300000 /dev/zero | tr '\0' x; echo; echo 'EOF'; echo 'cat <<EOF | wc -c'; head -c 300000 /dev/zero | tr '\0' x; echo; echo 'EOF') > heredoc_large.sh
+OUTPUT=$($SHRIMP_BIN -c 'readlink /proc/self/fd/0 <<< small' | cut -d: -f1; $SHRIMP_BIN heredoc_large.sh)
+EXPECTED=$(printf "pipe\n/memfd:shrimp-heredoc (deleted)\n300001")
+rm -f heredoc_large.sh
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "heredoc.sh: LARGE HERE-DOC TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# A here-doc missing its delimiter or a word rejects the whole line
+OUTPUT=$(printf 'echo before <<EOF\nbody\n' | $SHRIMP_BIN 2>&1; echo $?; $SHRIMP_BIN -c 'cat <<<' 2>&1)
+EXPECTED=$(printf "\033[31mHere-doc error: the input ended before the delimiter of a here-doc\n\033[0m2\n\033[31mRedirection error: <, > and >> must be followed by a file name, and <<< and << by a word\n\033[0m")
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "heredoc.sh: HERE-DOC ERROR TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
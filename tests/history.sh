@@ -0,0 +1,70 @@
+#!/bin/bash
+#
+# history.sh
+#
+# Tests the command history and the history built-in command
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# history lists every entry, or only the latest n, skipping blank lines of the file
+printf 'ls -l\n\ngit status\nmake check\ngit log\n' > history_file.txt
+OUTPUT=$(SHRIMP_HISTFILE=history_file.txt "$SHRIMP_BIN" -c 'history; history 2')
+EXPECTED=$'      1  ls -l\n      2  git status\n      3  make check\n      4  git log\n      3  make check\n      4  git log'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "history.sh: LIST TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    rm -f history_file.txt
+    exit 1
+fi
+
+# history -s lists matching entries most recent first, and fails if there are none
+for i in $(seq 1000); do echo "filler $i"; done >> history_file.txt
+OUTPUT=$(SHRIMP_HISTFILE=history_file.txt "$SHRIMP_BIN" -c 'history -s git; history -s filler 1000; history -s nothing'; echo "status=$?")
+EXPECTED=$'      4  git log\n      2  git status\n   1004  filler 1000\nstatus=1'
+rm -f history_file.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "history.sh: SEARCH TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Only interactive sessions record history, run on a pseudo terminal through script
+if ! command -v script > /dev/null; then
+    exit 0
+fi
+
+printf 'echo one\n   \necho two\nexit\n' | SHRIMP_HISTFILE=history_file.txt script -qec "$SHRIMP_BIN" /dev/null > /dev/null
+OUTPUT=$(cat history_file.txt)
+EXPECTED=$'echo one\necho two\nexit'
+rm -f history_file.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "history.sh: RECORD TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,127 @@
+#!/bin/bash
+#
+# jobs.sh
+#
+# Tests the job table and the built-in commands jobs and wait
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# Background jobs keep their status until it is collected by wait
+"$SHRIMP_BIN" -c 'true &; false &; sleep 0.1; wait %2' > /dev/null
+STATUS=$?
+EXPECTED=1
+
+if [ "$STATUS" != "$EXPECTED" ]; then
+    echo "jobs.sh: WAIT STATUS TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$STATUS""
+    exit 1
+fi
+
+# jobs lists running and finished jobs, and finished jobs are only reported once
+OUTPUT=$(echo 'sleep 0.3 &; false &; sleep 0.1; jobs; jobs' | "$SHRIMP_BIN" | grep -v '^\[[0-9]*\] [0-9]*$' | tr -s ' ')
+EXPECTED=$'[1] Running sleep 0.3 &\n[2]+ Exit 1 false\n[1] Running sleep 0.3 &'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "jobs.sh: JOBS TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Hundreds of background jobs are reaped without losing the status of any of them
+SCRIPT=jobs_script.sh
+rm -f "$SCRIPT"
+for i in $(seq 1 300); do
+    echo "true &" >> "$SCRIPT"
+done
+echo "false &" >> "$SCRIPT"
+echo "wait %301" >> "$SCRIPT"
+"$SHRIMP_BIN" "$SCRIPT" > /dev/null
+STATUS=$?
+OUTPUT=$(echo 'wait; jobs' >> "$SCRIPT"; "$SHRIMP_BIN" "$SCRIPT" | grep -v '^\[[0-9]*\] [0-9]*$')
+rm -f "$SCRIPT"
+
+if [ "$STATUS" != 1 ] || [ -n "$OUTPUT" ]; then
+    echo "jobs.sh: MANY JOBS TEST FAILED"
+    echo "Expected: 1 and no jobs left"
+    echo "Output: "$STATUS" and "$OUTPUT""
+    exit 1
+fi
+
+# Hundreds of jobs running at once are each matched to their own status
+rm -f "$SCRIPT"
+for i in $(seq 1 200); do
+    echo "sleep 0.3 &" >> "$SCRIPT"
+done
+echo "sleep 0.1 | false &" >> "$SCRIPT"
+echo "wait %201" >> "$SCRIPT"
+"$SHRIMP_BIN" "$SCRIPT" > /dev/null
+STATUS=$?
+rm -f "$SCRIPT"
+
+if [ "$STATUS" != 1 ]; then
+    echo "jobs.sh: CONCURRENT JOBS TEST FAILED"
+    echo "Expected: 1"
+    echo "Output: "$STATUS""
+    exit 1
+fi
+
+# An interactive shell reports a finished background job while the next line is still
+# being waited for, not once it is entered
+if command -v script > /dev/null; then
+    OUTPUT=$( (sleep 0.2; printf 'sleep 0.2 &\r'; sleep 1; printf 'echo typed\r'; sleep 0.2; printf 'exit\r') |
+        TERM=xterm SHRIMP_HISTFILE="$PWD/jobs_history.txt" script -qec "$SHRIMP_BIN" /dev/null | grep -ao 'Done\|echo typed' | head -n 2 | tr '\n' ' ')
+    rm -f jobs_history.txt
+    EXPECTED="Done echo typed "
+
+    if [ "$OUTPUT" != "$EXPECTED" ]; then
+        echo "jobs.sh: IMMEDIATE REPORT TEST FAILED"
+        echo "Expected: "$EXPECTED""
+        echo "Output: "$OUTPUT""
+        exit 1
+    fi
+fi
+
+# A foreground pipeline still gets its own status while background jobs finish around it
+OUTPUT=$(echo 'sleep 0.1 &; sleep 0.2 | false; wait %1' | "$SHRIMP_BIN" 2>&1 | grep -v '^\[[0-9]*\] [0-9]*$')
+"$SHRIMP_BIN" -c 'sleep 0.1 &; sleep 0.2 | false' > /dev/null
+STATUS=$?
+
+if [ "$STATUS" != 1 ] || [ -n "$OUTPUT" ]; then
+    echo "jobs.sh: FOREGROUND STATUS TEST FAILED"
+    echo "Expected: 1 and no output"
+    echo "Output: "$STATUS" and "$OUTPUT""
+    exit 1
+fi
+
+# fg and bg need job control, which only an interactive shell has
+OUTPUT=$(echo 'fg; bg' | "$SHRIMP_BIN" 2>&1 | sed 's/\x1b\[[0-9;]*m//g')
+EXPECTED=$'fg: no job control\nbg: no job control'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "jobs.sh: NO JOB CONTROL TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,93 @@
+#!/bin/bash
+#
+# lists.sh
+#
+# Tests pipelines joined by && and ||, the $? status and set pipefail
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# && runs the next pipeline on success and || on failure, and a skipped pipeline keeps the
+# status of the last one that ran
+OUTPUT=$(printf '%s\n' 'echo a && echo b' 'false && echo no' 'false || echo c' 'true || echo no' \
+                       'false && echo no || echo d' 'true && false || echo e' 'echo f&&echo g||echo no' | "$SHRIMP_BIN" 2>&1)
+EXPECTED=$'a\nb\nc\nd\ne\nf\ng'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "lists.sh: AND OR TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# A skipped pipeline is never launched, not even its redirections
+rm -f lists_out.txt
+OUTPUT=$("$SHRIMP_BIN" -c 'false && echo no > lists_out.txt; true || touch lists_out.txt; echo done' 2>&1)
+if [ -e lists_out.txt ]; then
+    OUTPUT="$OUTPUT created"
+fi
+EXPECTED="done"
+rm -f lists_out.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "lists.sh: SKIP TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# $? expands to the status of the last pipeline, wherever it appears within a word
+OUTPUT=$(printf '%s\n' 'echo $?' 'false; echo $? x$?y$?' 'nosuchcommand' 'echo $?' 'echo |' 'echo $?' \
+                       'false | true; echo $?' | "$SHRIMP_BIN" 2>/dev/null | grep -v 'not found')
+EXPECTED=$'0\n1 x1y1\n127\n2\n0'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "lists.sh: STATUS TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# With set pipefail=on a pipeline fails with its last failing stage, and the condition of
+# the first pipeline of a &| group decides the whole group
+OUTPUT=$(printf '%s\n' 'set pipefail=on' 'false | true && echo no || echo $?' 'true | false | true; echo $?' \
+                       'set pipefail=off' 'false | true && echo $?' 'false && echo no &| echo no; echo $?' \
+                       'true && false &| true; echo $?' | "$SHRIMP_BIN" 2>&1)
+EXPECTED=$'1\n1\n0\n1\n1'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "lists.sh: PIPEFAIL TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# && and || must join two commands, and a malformed line runs none of its pipelines
+OUTPUT=$(printf '%s\n' '&& echo no' 'echo no ||' 'echo no && ; echo no' 'echo no & && echo no' | "$SHRIMP_BIN" 2>&1)
+EXPECTED=$(printf '\033[31mList error: && and || must join two commands\n\033[0m%.0s' 1 2 3 4)
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "lists.sh: PARSE ERROR TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,66 @@
+#!/bin/bash
+#
+# memory.sh
+#
+# Tests that the memory used by SHrimp stays bounded over a long running session
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# Maximum resident set growth allowed between the two samples, in kB
+MAX_GROWTH=256
+
+TMP_DIR=$(mktemp -d)
+mkfifo "$TMP_DIR/in"
+"$SHRIMP_BIN" < "$TMP_DIR/in" > "$TMP_DIR/out" 2>&1 &
+SHRIMP_PID=$!
+exec 3> "$TMP_DIR/in"
+
+# Feed $1 lines through the shell, then wait until it has processed all of them
+feed() {
+    for ((i = 0; i < $1; i++)); do
+        echo 'cd . ; cd . | wc ; cd .'
+    done >&3
+    echo "echo batch$2" >&3
+    until grep -q "batch$2" "$TMP_DIR/out"; do
+        sleep 0.05
+    done
+}
+
+rss() {
+    awk '/^VmRSS/ { print $2 }' "/proc/$SHRIMP_PID/status"
+}
+
+# Warm up so every buffer reaches its steady state size, then sample again
+feed 2000 1
+BEFORE=$(rss)
+feed 50000 2
+AFTER=$(rss)
+
+exec 3>&-
+wait "$SHRIMP_PID"
+rm -rf "$TMP_DIR"
+
+if [ $((AFTER - BEFORE)) -gt "$MAX_GROWTH" ]; then
+    echo "memory.sh: RESIDENT MEMORY GROWTH TEST FAILED"
+    echo "Expected growth of at most: "$MAX_GROWTH" kB"
+    echo "Output: "$((AFTER - BEFORE))" kB ("$BEFORE" kB -> "$AFTER" kB)"
+    exit 1
+fi
@@ -0,0 +1,74 @@
+#!/bin/bash
+#
+# options.sh
+#
+# Tests the set built-in command and the shell options it changes
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# set lists every option, and pipebuf is rounded up by the kernel to whole pages
+OUTPUT=$(echo 'set; set pipebuf=64K spawn=fork; set' | SHRIMP_SPAWN=posix_spawn "$SHRIMP_BIN" 2>&1)
+EXPECTED=$'cgroup=off\njoblog=off\nparallel=unlimited\npipebuf=default\npipefail=off\npipestat=off\nspawn=posix_spawn\ncgroup=off\njoblog=off\nparallel=unlimited\npipebuf=65536\npipefail=off\npipestat=off\nspawn=fork'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "options.sh: SET TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# A pipe size larger than /proc/sys/fs/pipe-max-size is clamped to it and reported
+MAX=$(cat /proc/sys/fs/pipe-max-size)
+OUTPUT=$(echo "set pipebuf=$((MAX * 2)); set" | "$SHRIMP_BIN" 2>&1 | grep pipebuf=)
+EXPECTED="pipebuf=$MAX"
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "options.sh: PIPEBUF CLAMP TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Resized pipes still carry every byte, for SHRIMP_PIPEBUF as well as both spawn engines
+OUTPUT=$(echo 'seq 200000 | cat | cat | wc -l; set spawn=fork; seq 200000 | cat | cat | wc -l' | SHRIMP_PIPEBUF=1M "$SHRIMP_BIN")
+EXPECTED=$'200000\n200000'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "options.sh: PIPEBUF PIPELINE TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Invalid options are rejected without changing anything
+"$SHRIMP_BIN" -c 'set pipebuf=lots' 2> /dev/null
+STATUS=$?
+OUTPUT=$(echo 'set pipebuf=lots; set colour=blue; set' | SHRIMP_SPAWN=posix_spawn "$SHRIMP_BIN" 2> /dev/null)
+EXPECTED=$'cgroup=off\njoblog=off\nparallel=unlimited\npipebuf=default\npipefail=off\npipestat=off\nspawn=posix_spawn'
+
+if [ "$STATUS" != 1 ] || [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "options.sh: INVALID OPTION TEST FAILED"
+    echo "Expected: 1 and "$EXPECTED""
+    echo "Output: "$STATUS" and "$OUTPUT""
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,89 @@
+#!/bin/bash
+#
+# parallel.sh
+#
+# Tests running pipelines in parallel with &| and limiting them with set parallel=N
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# Every pipeline of a group runs at once, so three 0.3s sleeps take well under 0.9s
+START=${EPOCHREALTIME/./}
+"$SHRIMP_BIN" -c 'sleep 0.3 &| sleep 0.3 &| sleep 0.3 | cat'
+ELAPSED=$(( (${EPOCHREALTIME/./} - START) / 1000 ))
+
+if [ "$ELAPSED" -ge 800 ]; then
+    echo "parallel.sh: CONCURRENCY TEST FAILED"
+    echo "Expected: under 800ms"
+    echo "Output: "$ELAPSED"ms"
+    exit 1
+fi
+
+# set parallel=1 runs the same group one pipeline at a time
+START=${EPOCHREALTIME/./}
+"$SHRIMP_BIN" -c 'set parallel=1; sleep 0.3 &| sleep 0.3 &| sleep 0.3 | cat'
+ELAPSED=$(( (${EPOCHREALTIME/./} - START) / 1000 ))
+
+if [ "$ELAPSED" -lt 900 ]; then
+    echo "parallel.sh: LIMIT TEST FAILED"
+    echo "Expected: at least 900ms"
+    echo "Output: "$ELAPSED"ms"
+    exit 1
+fi
+
+# The whole group finishes before the next command, and every pipeline's output arrives
+OUTPUT=$("$SHRIMP_BIN" -c 'sleep 0.2 &| echo two | tr a-z A-Z &| /bin/echo three; echo after' | sort)
+EXPECTED=$'TWO\nafter\nthree'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "parallel.sh: GROUP TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# The status of a group is that of its first failing pipeline, in the order of the line
+echo 'exit 3' > parallel_exit.sh
+OUTPUT=$("$SHRIMP_BIN" -c 'true &| sh parallel_exit.sh &| /bin/false'; echo $?; "$SHRIMP_BIN" -c 'true &| true'; echo $?)
+EXPECTED=$'3\n0'
+rm -f parallel_exit.sh
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "parallel.sh: STATUS TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# &| must join two commands, a group cannot run in the background and cd cannot run in it
+OUTPUT=""
+for LINE in 'true &|' '&| true' 'true &| ; true' 'true &| true &' 'cd &| true'; do
+    OUTPUT="$OUTPUT$("$SHRIMP_BIN" -c "$LINE" 2>/dev/null; echo -n $?)"
+done
+EXPECTED="22221"
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "parallel.sh: INVALID GROUP TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
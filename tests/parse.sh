@@ -0,0 +1,81 @@
+#!/bin/bash
+#
+# parse.sh
+#
+# Tests the single-pass parser, including operators written without surrounding whitespace
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# Operators do not need to be separated from words by whitespace
+OUTPUT=$(echo 'echo one two three|wc -w>parse_out.txt;cat<parse_out.txt' | "$SHRIMP_BIN")
+EXPECTED=3
+rm -f parse_out.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "parse.sh: NO WHITESPACE TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Empty commands between separators are skipped
+OUTPUT=$(echo ';; echo crab ;; ; echo lobster;' | "$SHRIMP_BIN")
+EXPECTED=$'crab\nlobster'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "parse.sh: EMPTY COMMAND TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# A malformed line is rejected as a whole before anything runs
+OUTPUT=$(echo 'echo first; echo second |' | "$SHRIMP_BIN" 2> /dev/null)
+EXPECTED=""
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "parse.sh: SYNTAX ERROR TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Commands are not limited to a fixed amount of arguments
+OUTPUT=$(echo "echo $(seq -s ' ' 1 1000) | wc -w" | "$SHRIMP_BIN")
+EXPECTED=1000
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "parse.sh: MANY ARGUMENTS TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Nor to a fixed amount of commands per line
+OUTPUT=$(echo "$(printf 'echo shrimp;%.0s' $(seq 1 100))" | "$SHRIMP_BIN" | wc -l)
+EXPECTED=100
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "parse.sh: MANY COMMANDS TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
@@ -0,0 +1,75 @@
+#!/bin/bash
+#
+# pin.sh
+#
+# Tests the pin prefix, which pins every stage of a pipeline to the CPUs of one NUMA node
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# Nodes holding at least one CPU, in the order automatic placement uses them. Without NUMA
+# support in sysfs the whole system is node 0
+NODES=""
+for dir in /sys/devices/system/node/node[0-9]*; do
+    [ -s "$dir/cpulist" ] && [ -n "$(tr -d '\n' < "$dir/cpulist")" ] && NODES="$NODES ${dir##*node}"
+done
+NODES=$(echo $NODES | tr ' ' '\n' | sort -n | tr '\n' ' ')
+[ -z "$NODES" ] && NODES="0 "
+FIRST=${NODES%% *}
+
+# Every stage runs on the CPUs of the node, as long as the shell may use all of them
+ALLOWED=$(awk '/^Cpus_allowed_list/ { print $2 }' /proc/self/status)
+if [ -r "/sys/devices/system/node/node$FIRST/cpulist" ] && [ "$ALLOWED" = "$(cat /sys/devices/system/cpu/online)" ]; then
+    OUTPUT=$("$SHRIMP_BIN" -c "pin node=$FIRST grep Cpus_allowed_list /proc/self/status | cat" 2>&1)
+    EXPECTED=$(printf 'Cpus_allowed_list:\t%s' "$(cat "/sys/devices/system/node/node$FIRST/cpulist")")
+
+    if [ "$OUTPUT" != "$EXPECTED" ]; then
+        echo "pin.sh: AFFINITY TEST FAILED"
+        echo "Expected: "$EXPECTED""
+        echo "Output: "$OUTPUT""
+        exit 1
+    fi
+fi
+
+# Concurrent background jobs rotate across the nodes, and jobs -l shows where each runs
+OUTPUT=$(echo 'pin sleep 0.5 &; pin node=auto sleep 0.5 &; sleep 0.5 &; jobs -l; wait' | "$SHRIMP_BIN" 2>&1 | awk '$1 ~ /^\[[0-9]\]/ && NF > 3 { print $3 }' | tr '\n' ' ')
+SET=($NODES)
+EXPECTED="node=${SET[0]} node=${SET[1 % ${#SET[@]}]} Running "
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "pin.sh: PLACEMENT TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# A node that does not exist leaves the pipeline unpinned, while a malformed node or a pin
+# without a command rejects the whole line
+OUTPUT=$("$SHRIMP_BIN" -c 'pin node=1000 /bin/echo ran' 2>&1; "$SHRIMP_BIN" -c 'echo ran; pin node=x true' 2>&1; echo "status $?"; "$SHRIMP_BIN" -c 'pin node=0' 2>&1; echo pin node=0)
+EXPECTED=$'\033[31mpin: node 1000: no such NUMA node\033[0m\nran\n\033[31mPin error: expected node=auto or node=N\n\033[0mstatus 2\n\033[31mError: missing command\n\033[0mpin node=0'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "pin.sh: PIN ERROR TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
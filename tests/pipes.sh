@@ -19,7 +19,7 @@
 # 
 # Author: Ryan McHenry
 # Created: February 1, 2026
-# Last Modified: February 4, 2026
+# Last Modified: October 14, 2026
 
 # Set shell binary to be the first argument
 SHRIMP_BIN=$1
@@ -28,9 +28,7 @@ SHRIMP_BIN=$1
 OUTPUT=$(echo 'echo "cats dogs birds snakes sharks" | wc -w' | "$SHRIMP_BIN")
 EXPECTED=5
 
-if [ "$OUTPUT" = "$EXPECTED" ]; then
-    exit 0
-else
+if [ "$OUTPUT" != "$EXPECTED" ]; then
     echo "pipes.sh: SINGLE PIPE TEST FAILED"
     echo "Expected: "$EXPECTED""
     echo "Output: "$OUTPUT""
@@ -41,11 +39,42 @@ fi
 OUTPUT=$(echo 'echo "one two three" | grep one | wc -w' | "$SHRIMP_BIN")
 EXPECTED=3
 
-if [ "$OUTPUT" = "$EXPECTED" ]; then
-    exit 0
-else
+if [ "$OUTPUT" != "$EXPECTED" ]; then
     echo "pipes.sh: MULTIPLE PIPES TEST FAILED"
     echo "Expected: "$EXPECTED""
     echo "Output: "$OUTPUT""
     exit 1
-fi
\ No newline at end of file
+fi
+
+# Wide pipeline, 30 stages deep, of external commands. Every stage only holds its own two
+# pipe ends, so no stage keeps another stage's write end open and the pipeline finishes
+PIPELINE="echo wide"
+for i in $(seq 1 29); do
+    PIPELINE="$PIPELINE | tr a a"
+done
+OUTPUT=$(echo "$PIPELINE" | "$SHRIMP_BIN")
+EXPECTED=wide
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "pipes.sh: 30 STAGE PIPELINE TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# The last stage of a wide pipeline sees as many fds as a command run on its own
+PIPELINE="echo wide"
+for i in $(seq 1 28); do
+    PIPELINE="$PIPELINE | tr a a"
+done
+EXPECTED=$(echo 'ls /proc/self/fd' | "$SHRIMP_BIN" | wc -l)
+OUTPUT=$(echo "$PIPELINE | ls /proc/self/fd" | "$SHRIMP_BIN" | wc -l)
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "pipes.sh: 30 STAGE PIPELINE FD TEST FAILED"
+    echo "Expected: "$EXPECTED" fds"
+    echo "Output: "$OUTPUT" fds"
+    exit 1
+fi
+
+exit 0
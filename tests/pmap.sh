@@ -0,0 +1,89 @@
+#!/bin/bash
+#
+# pmap.sh
+#
+# Tests the pmap built-in command, which runs a command once per line of input
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# {} is replaced by the item anywhere in an arg, otherwise the item is appended
+seq 3 > pmap_items.txt
+OUTPUT=$("$SHRIMP_BIN" -c 'pmap -j 1 -a pmap_items.txt echo n={}; pmap -j 1 -a pmap_items.txt echo x')
+EXPECTED=$'n=1\nn=2\nn=3\nx 1\nx 2\nx 3'
+rm -f pmap_items.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "pmap.sh: TEMPLATE TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# At most -j commands run at once, so six 0.2s sleeps take three rounds with -j 2
+START=${EPOCHREALTIME/./}
+printf '0.2\n%.0s' 1 2 3 4 5 6 | "$SHRIMP_BIN" -c 'pmap -j 2 sleep'
+ELAPSED=$(( (${EPOCHREALTIME/./} - START) / 1000 ))
+
+if [ "$ELAPSED" -lt 550 ] || [ "$ELAPSED" -ge 1100 ]; then
+    echo "pmap.sh: LIMIT TEST FAILED"
+    echo "Expected: between 550ms and 1100ms"
+    echo "Output: "$ELAPSED"ms"
+    exit 1
+fi
+
+# With -g the lines of each command stay together even though the commands overlap
+printf 'echo a $1\nsleep 0.2\necho b $1\n' > pmap_item.sh
+OUTPUT=$(seq 3 | "$SHRIMP_BIN" -c 'pmap -g -j 3 sh pmap_item.sh' | sed 's/ .*//' | tr -d '\n')
+EXPECTED="ababab"
+rm -f pmap_item.sh
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "pmap.sh: GROUP TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# pmap works as a stage of a pipeline, and its status is that of the first failing item
+echo 'exit $1' > pmap_exit.sh
+OUTPUT=$(printf '0\n4\n0\n5\n' | "$SHRIMP_BIN" -c 'pmap sh pmap_exit.sh'; echo $?; seq 5 | "$SHRIMP_BIN" -c 'pmap echo | wc -l')
+EXPECTED=$'4\n5'
+rm -f pmap_exit.sh
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "pmap.sh: STATUS TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# -j is capped at PMAP_MAX_JOBS, so a huge limit is rejected rather than allocated
+OUTPUT=$(printf 'a\nb\n' | "$SHRIMP_BIN" -c 'pmap -j 2147483647 echo; echo status=$?; pmap -j 4096 echo' 2>&1)
+EXPECTED=$(printf "\033[31mpmap: -j: invalid limit '2147483647'\033[0m\nstatus=1\na\nb")
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "pmap.sh: LIMIT TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,104 @@
+#!/bin/bash
+#
+# prio.sh
+#
+# Tests the prio prefix, the process groups of background pipelines and the cgroup option
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# prio adds 10 to the niceness of every stage unless -n says otherwise, leaving later
+# pipelines alone. Niceness saturates at 19
+BASE=$(nice)
+OUTPUT=$("$SHRIMP_BIN" -c 'prio nice; prio -n 3 nice | cat; nice' 2>&1)
+EXPECTED=$(printf '%d\n%d\n%d' $((BASE + 10 > 19 ? 19 : BASE + 10)) $((BASE + 3 > 19 ? 19 : BASE + 3)) "$BASE")
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "prio.sh: NICENESS TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# prio moves every stage to the idle I/O class unless -i says otherwise
+if command -v ionice > /dev/null 2>&1; then
+    OUTPUT=$("$SHRIMP_BIN" -c 'prio ionice; prio -i 5 ionice; prio -n 1 -i none ionice' 2>&1)
+    EXPECTED=$'idle\nbest-effort: prio 5\nnone: prio 0'
+
+    if [ "$OUTPUT" != "$EXPECTED" ]; then
+        echo "prio.sh: IO PRIORITY TEST FAILED"
+        echo "Expected: "$EXPECTED""
+        echo "Output: "$OUTPUT""
+        exit 1
+    fi
+fi
+
+# Invalid options and a prio without a command reject the whole line
+OUTPUT=$("$SHRIMP_BIN" -c 'echo ran; prio -n 20 nice' 2>&1; echo "status $?"; "$SHRIMP_BIN" -c 'prio -i' 2>&1; "$SHRIMP_BIN" -c 'prio' 2>&1; echo prio -n 1)
+EXPECTED=$'\033[31mPrio error: expected -n -20 to 19 or -i idle, none or 0 to 7\n\033[0mstatus 2\n\033[31mPrio error: expected -n -20 to 19 or -i idle, none or 0 to 7\n\033[0m\033[31mError: missing command\n\033[0mprio -n 1'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "prio.sh: PRIO ERROR TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Without job control, a background pipeline leads a process group of its own while a
+# foreground pipeline stays in the shell's
+OUTPUT=$(printf 'head /proc/self/stat &\nwait\nhead /proc/self/stat\n' | "$SHRIMP_BIN" 2>&1 | awk '$2 == "(head)" { print ($1 == $5) }' | tr '\n' ' ')
+EXPECTED="1 0 "
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "prio.sh: PROCESS GROUP TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Limits need a cgroup to apply to
+OUTPUT=$("$SHRIMP_BIN" -c 'set cgroup_memory=64M' 2>&1; echo "status $?")
+EXPECTED=$'\033[31mset: cgroup_memory: no cgroup is set, set cgroup=NAME first\033[0m\nstatus 1'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "prio.sh: CGROUP LIMIT TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Background pipelines run in the cgroup, foreground pipelines in the shell's. Only run
+# where a cgroup v2 hierarchy is mounted and this user may create cgroups in its root
+CGROOT=$(awk '$3 == "cgroup2" { print $2; exit }' /proc/self/mounts)
+if [ -n "$CGROOT" ] && [ -w "$CGROOT" ]; then
+    NAME=shrimp-test-$$
+    OUTPUT=$(printf 'set cgroup=%s\ngrep -c /%s$ /proc/self/cgroup &\nwait\ngrep -c /%s$ /proc/self/cgroup\n' "$NAME" "$NAME" "$NAME" | "$SHRIMP_BIN" 2>&1 | grep -v '^\[')
+    rmdir "$CGROOT/$NAME" 2> /dev/null
+    EXPECTED=$'1\n0'
+
+    if [ "$OUTPUT" != "$EXPECTED" ]; then
+        echo "prio.sh: CGROUP TEST FAILED"
+        echo "Expected: "$EXPECTED""
+        echo "Output: "$OUTPUT""
+        exit 1
+    fi
+fi
+
+exit 0
@@ -0,0 +1,48 @@
+#!/bin/bash
+#
+# prompt.sh
+#
+# Tests the cached prompt of interactive sessions, run on a pseudo terminal through script
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# The prompt is only rendered on a terminal
+if ! command -v script > /dev/null; then
+    exit 0
+fi
+
+# The prompt follows cd, shows directories within $HOME relative to ~ at a component
+# boundary only, and fits directories far deeper than the old fixed size buffers. A dumb
+# terminal keeps the line editor, which redraws the prompt on every key, out of the way
+DEEP=$(printf 'd%.0s' {1..100})/$(printf 'e%.0s' {1..100})
+mkdir -p prompt_home/"$DEEP" prompt_home2
+OUTPUT=$(printf 'cd prompt_home/%s\ncd ../..\ncd ../prompt_home2\nexit\n' "$DEEP" | TERM=dumb HOME="$PWD/prompt_home" script -qec "$SHRIMP_BIN" /dev/null | sed 's/\x1b\[[0-9;]*m//g' | grep -o 'SHrimp:[^>]*>' | tr '\n' ' ')
+EXPECTED="SHrimp:$PWD> SHrimp:~/$DEEP> SHrimp:~> SHrimp:$PWD/prompt_home2> "
+rm -rf prompt_home prompt_home2
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "prompt.sh: PROMPT TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
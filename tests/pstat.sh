@@ -0,0 +1,83 @@
+#!/bin/bash
+#
+# pstat.sh
+#
+# Tests the pipe monitor, both through the pstat built-in and set pipestat
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# sleep never reads its stdin, so the pipe yes writes to fills up and sleep is the bottleneck
+OUTPUT=$($SHRIMP_BIN -c 'yes | sleep 1 &
+pstat -i 0.2' | grep bottleneck)
+EXPECTED="bottleneck: stage 2 (sleep 1)"
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "pstat.sh: PSTAT TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+OUTPUT=$($SHRIMP_BIN -c 'yes | sleep 1 &
+pstat -i 0.2' | grep -c "64K 100%  yes")
+EXPECTED="1"
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "pstat.sh: PIPE FILL TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# With set pipestat, a foreground pipeline is reported on stderr while it runs
+OUTPUT=$(SHRIMP_PIPESTAT=0.2 $SHRIMP_BIN -c 'yes | sleep 1' 2>&1 | grep bottleneck | head -n 1)
+EXPECTED="bottleneck: stage 2 (sleep 1)"
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "pstat.sh: SHRIMP_PIPESTAT TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# Reports keep their interval while background jobs exit more often than it
+OUTPUT=$(SHRIMP_PIPESTAT=0.25 $SHRIMP_BIN -c 'sleep 0.1 &; sleep 0.2 &; sleep 0.3 &; sleep 0.4 &; sleep 0.5 &; sleep 0.6 &; sleep 0.7 &; sleep 0.8 &; sleep 0.9 &; yes | sleep 1' 2>&1 | grep -c bottleneck)
+
+if [ "$OUTPUT" -lt 2 ]; then
+    echo "pstat.sh: PIPESTAT CHURN TEST FAILED"
+    echo "Expected: at least 2 reports"
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+OUTPUT=$($SHRIMP_BIN -c 'set pipestat=0.5
+set pipestat=fast
+set' 2>&1 | grep pipestat)
+EXPECTED=$(printf "\033[31mset: pipestat: invalid interval 'fast'\033[0m\npipestat=0.5")
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "pstat.sh: OPTION TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
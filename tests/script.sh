@@ -0,0 +1,81 @@
+#!/bin/bash
+#
+# script.sh
+#
+# Tests running script files and -c strings, as well as their exit status
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# Script file with comments and no trailing newline
+printf '#!/usr/bin/env shrimp\n# a comment\necho barnacle # trailing comment\necho krill | wc -c' > script_test.sh
+OUTPUT=$("$SHRIMP_BIN" script_test.sh)
+EXPECTED=$'barnacle\n6'
+rm script_test.sh
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "script.sh: SCRIPT FILE TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# -c runs every line of its argument
+OUTPUT=$("$SHRIMP_BIN" -c $'echo one; echo two\necho three')
+EXPECTED=$'one\ntwo\nthree'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "script.sh: -c TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# The exit status follows the last command
+STATUS=0
+"$SHRIMP_BIN" -c 'true; false' || STATUS=$?
+if [ "$STATUS" -ne 1 ]; then
+    echo "script.sh: EXIT STATUS TEST FAILED"
+    echo "Expected: 1"
+    echo "Output: "$STATUS""
+    exit 1
+fi
+
+STATUS=0
+"$SHRIMP_BIN" -c 'false; exit 42; true' || STATUS=$?
+if [ "$STATUS" -ne 42 ]; then
+    echo "script.sh: EXIT BUILT-IN TEST FAILED"
+    echo "Expected: 42"
+    echo "Output: "$STATUS""
+    exit 1
+fi
+
+# --startup-profile times every phase of startup on stderr, leaving stdout alone
+OUTPUT=$("$SHRIMP_BIN" --startup-profile -c 'echo one' 2> profile_test.txt)
+OUTPUT="$OUTPUT $(awk '{ print $1 }' profile_test.txt | tr '\n' ' ')"
+EXPECTED="one phase source jobs spawn options terminal total "
+rm profile_test.txt
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "script.sh: STARTUP PROFILE TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
@@ -0,0 +1,93 @@
+#!/bin/bash
+#
+# spawn.sh
+#
+# Tests that every spawn engine produces the same results for pipes and redirection
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+for ENGINE in fork posix_spawn server; do
+    rm -f spawn_out.txt
+    OUTPUT=$(printf 'echo shells and claws > spawn_out.txt\ntr a-z A-Z < spawn_out.txt | wc -w >> spawn_out.txt\ncat spawn_out.txt | tail -n 1\n' | SHRIMP_SPAWN=$ENGINE "$SHRIMP_BIN")
+    EXPECTED=3
+    rm -f spawn_out.txt
+
+    if [ "$OUTPUT" != "$EXPECTED" ]; then
+        echo "spawn.sh: $ENGINE ENGINE TEST FAILED"
+        echo "Expected: "$EXPECTED""
+        echo "Output: "$OUTPUT""
+        exit 1
+    fi
+done
+
+# A missing redirection file is blamed on the file, not the command, with status 1
+for ENGINE in fork posix_spawn server; do
+    rm -f spawn_missing.txt
+    OUTPUT=$(SHRIMP_SPAWN=$ENGINE "$SHRIMP_BIN" -c 'wc -l < spawn_missing.txt; echo $?' 2>&1)
+    EXPECTED=$(printf "\033[31mSHrimp: spawn_missing.txt: No such file or directory\033[0m\n1")
+
+    if [ "$OUTPUT" != "$EXPECTED" ]; then
+        echo "spawn.sh: $ENGINE ENGINE MISSING FILE TEST FAILED"
+        echo "Expected: "$EXPECTED""
+        echo "Output: "$OUTPUT""
+        exit 1
+    fi
+done
+
+# Children of the spawn server are children of the shell itself, so the job table reaps them
+echo 'echo $PPID' > spawn_ppid.sh
+OUTPUT=$(SHRIMP_SPAWN=server "$SHRIMP_BIN" -c 'sh spawn_ppid.sh' & echo $!; wait)
+EXPECTED=$(echo "$OUTPUT" | head -n 1)
+OUTPUT=$(echo "$OUTPUT" | tail -n 1)
+rm -f spawn_ppid.sh
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "spawn.sh: SERVER PARENT TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# The spawn server follows cd, and exit statuses work as with the other engines
+mkdir -p spawn_dir
+OUTPUT=$(SHRIMP_SPAWN=server "$SHRIMP_BIN" -c 'cd spawn_dir; /bin/echo claws > claws.txt; ls; /bin/false' 2>&1; echo $?)
+EXPECTED=$'claws.txt\n1'
+rm -rf spawn_dir
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "spawn.sh: SERVER CD TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# set starts the spawn server on demand, and losing it falls back to posix_spawn
+echo 'pkill -P $PPID -f spawn-server' > spawn_kill.sh
+OUTPUT=$(echo 'set spawn=server; sh spawn_kill.sh; /bin/echo after; set' | "$SHRIMP_BIN" 2>/dev/null | tail -n 2)
+EXPECTED=$'pipestat=off\nspawn=posix_spawn'
+rm -f spawn_kill.sh
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "spawn.sh: SERVER FALLBACK TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
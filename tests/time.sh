@@ -0,0 +1,77 @@
+#!/bin/bash
+#
+# time.sh
+#
+# Tests the time prefix and the job log
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# time reports every stage of a pipeline and a total on stderr, leaving stdout alone
+ERRS=$(echo 'time sleep 0.1 | cat' | "$SHRIMP_BIN" 2>&1 >/dev/null)
+LABELS=$(echo "$ERRS" | awk 'NR > 1 { print $NF }' | tr '\n' ' ')
+REAL=$(echo "$ERRS" | awk '$NF == "total" { sub("s", "", $1); print ($1 >= 0.1) }')
+EXPECTED="0.1 cat total "
+
+if [ "$LABELS" != "$EXPECTED" ] || [ "$REAL" != 1 ]; then
+    echo "time.sh: TIME PIPELINE TEST FAILED"
+    echo "Expected: "$EXPECTED" with a total of at least 0.1s"
+    echo "Output: "$ERRS""
+    exit 1
+fi
+
+# time keeps the status of the pipeline, and is only a prefix at the start of a pipeline
+OUTPUT=$(echo 'echo time' | "$SHRIMP_BIN" 2>&1)
+"$SHRIMP_BIN" -c 'time false' 2> /dev/null
+STATUS=$?
+
+if [ "$STATUS" != 1 ] || [ "$OUTPUT" != "time" ]; then
+    echo "time.sh: TIME STATUS TEST FAILED"
+    echo "Expected: 1 and time"
+    echo "Output: "$STATUS" and "$OUTPUT""
+    exit 1
+fi
+
+# The job log gets one record per job, including background and failed jobs
+LOG=time_joblog.txt
+rm -f "$LOG"
+echo "set joblog=$LOG; sleep 0.1 &; false | true; wait; set joblog=off; true" | "$SHRIMP_BIN" > /dev/null
+OUTPUT=$(sed 's/^end=[0-9.]* //; s/ pgid=[0-9]*//; s/ real=.* cmd=/ cmd=/' "$LOG")
+rm -f "$LOG"
+EXPECTED=$'job=2 status=0 statuses=1,0 cmd=false | true\njob=1 status=0 statuses=0 cmd=sleep 0.1'
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "time.sh: JOB LOG TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# The job log can also be an fd inherited from the caller
+OUTPUT=$(SHRIMP_JOBLOG=3 "$SHRIMP_BIN" -c 'echo fd | cat' 3>&1 >/dev/null | grep -c 'status=0 statuses=0,0 real=')
+
+if [ "$OUTPUT" != 1 ]; then
+    echo "time.sh: JOB LOG FD TEST FAILED"
+    echo "Expected: 1"
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,75 @@
+#!/bin/bash
+#
+# trace.sh
+#
+# Tests the tracing layer and the shrimpstat built-in command
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+# 
+# Author: Ryan McHenry
+# Created: October 14, 2026
+# Last Modified: October 14, 2026
+
+# Set shell binary to be the first argument
+SHRIMP_BIN=$1
+
+# Without make TRACE=1 the tracing layer does not exist, which shrimpstat reports
+if ! "$SHRIMP_BIN" -c 'shrimpstat' > /dev/null 2>&1; then
+    OUTPUT=$("$SHRIMP_BIN" -c 'shrimpstat' 2>&1 | sed 's/\x1b\[[0-9;]*m//g')
+    EXPECTED="shrimpstat: tracing is not compiled in, rebuild with make TRACE=1"
+
+    if [ "$OUTPUT" != "$EXPECTED" ]; then
+        echo "trace.sh: TRACE DISABLED TEST FAILED"
+        echo "Expected: "$EXPECTED""
+        echo "Output: "$OUTPUT""
+        exit 1
+    fi
+    exit 0
+fi
+
+# SHRIMP_TRACE=1 records every phase and dumps the histograms on exit, leaving stdout alone.
+# Both stages are built-ins run by forked children, so no command is looked up in $PATH
+OUTPUT=$(printf 'echo one | cat\ntrue\n' | SHRIMP_TRACE=1 "$SHRIMP_BIN" 2>&1 >/dev/null | awk 'NR > 1 && NF == 6 { print $1, $2 }' | tr '\n' ' ')
+EXPECTED="input 3 parse 2 spawn 2 wait 1 builtin 1 "
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "trace.sh: SHRIMP_TRACE TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# An option the cat built-in does not support runs the external cat, which is looked up
+OUTPUT=$(printf 'echo one | cat -n\ntrue\n' | SHRIMP_TRACE=1 "$SHRIMP_BIN" 2>&1 >/dev/null | awk 'NR > 1 && NF == 6 { print $1, $2 }' | tr '\n' ' ')
+EXPECTED="input 3 parse 2 lookup 1 spawn 2 wait 1 builtin 1 "
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "trace.sh: SHRIMP_TRACE LOOKUP TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+# shrimpstat -e enables recording on demand and -r clears what was recorded
+OUTPUT=$(echo 'shrimpstat -e; true; true; shrimpstat -r; true; shrimpstat -d; shrimpstat' | "$SHRIMP_BIN" 2>&1 | awk '$1 == "builtin" && NF == 6 { print $2 }')
+EXPECTED=2
+
+if [ "$OUTPUT" != "$EXPECTED" ]; then
+    echo "trace.sh: SHRIMPSTAT TEST FAILED"
+    echo "Expected: "$EXPECTED""
+    echo "Output: "$OUTPUT""
+    exit 1
+fi
+
+exit 0